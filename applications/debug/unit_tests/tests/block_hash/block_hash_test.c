@@ -0,0 +1,108 @@
+#include <furi.h>
+#include <furi_hal.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+#include <toolbox/block_hash.h>
+#include <storage/storage.h>
+
+#define BLOCK_HASH_TEST_PATH EXT_PATH("unit_tests_block_hash.bin")
+#define BLOCK_HASH_TEST_SIZE 300
+
+typedef struct {
+    uint32_t count;
+    size_t total_size;
+    uint32_t weak[4];
+} BlockHashTestContext;
+
+static void block_hash_test_fill(uint8_t* data, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        data[i] = (i * 37 + 11) & 0xFF;
+    }
+}
+
+MU_TEST(test_block_hash_weak) {
+    uint8_t data[BLOCK_HASH_TEST_SIZE];
+    block_hash_test_fill(data, sizeof(data));
+
+    mu_assert_int_eq(0, block_hash_weak(data, 0));
+    // Reference value, host tooling must compute the same one
+    mu_assert_int_eq(1433441566, block_hash_weak(data, sizeof(data)));
+}
+
+MU_TEST(test_block_hash_roll) {
+    uint8_t data[BLOCK_HASH_TEST_SIZE];
+    block_hash_test_fill(data, sizeof(data));
+
+    const size_t window = 64;
+    uint32_t hash = block_hash_weak(data, window);
+    for(size_t i = 1; i + window <= sizeof(data); i++) {
+        hash = block_hash_roll(hash, window, data[i - 1], data[i + window - 1]);
+        mu_assert_int_eq(block_hash_weak(&data[i], window), hash);
+    }
+}
+
+static void block_hash_test_callback(
+    uint32_t index,
+    size_t size,
+    uint32_t weak,
+    const uint8_t strong[BLOCK_HASH_STRONG_SIZE],
+    void* context) {
+    UNUSED(strong);
+    BlockHashTestContext* test = context;
+
+    furi_check(index == test->count);
+    if(index < COUNT_OF(test->weak)) {
+        test->weak[index] = weak;
+    }
+    test->count++;
+    test->total_size += size;
+}
+
+MU_TEST(test_block_hash_file) {
+    uint8_t data[BLOCK_HASH_TEST_SIZE];
+    block_hash_test_fill(data, sizeof(data));
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    mu_assert(
+        storage_file_open(file, BLOCK_HASH_TEST_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS),
+        "Failed to create file");
+    mu_assert_int_eq(sizeof(data), storage_file_write(file, data, sizeof(data)));
+
+    BlockHashTestContext test = {0};
+    mu_assert(
+        block_hash_calc_file(file, 128, block_hash_test_callback, &test), "Failed to hash file");
+    mu_assert_int_eq(3, test.count);
+    mu_assert_int_eq(sizeof(data), test.total_size);
+    mu_assert_int_eq(block_hash_weak(&data[0], 128), test.weak[0]);
+    mu_assert_int_eq(block_hash_weak(&data[128], 128), test.weak[1]);
+    mu_assert_int_eq(block_hash_weak(&data[256], 44), test.weak[2]);
+
+    // Block size equal to file size gives exactly one block
+    memset(&test, 0, sizeof(test));
+    mu_assert(
+        block_hash_calc_file(file, sizeof(data), block_hash_test_callback, &test),
+        "Failed to hash file");
+    mu_assert_int_eq(1, test.count);
+    mu_assert_int_eq(block_hash_weak(data, sizeof(data)), test.weak[0]);
+
+    storage_file_close(file);
+    storage_file_free(file);
+    storage_simply_remove(storage, BLOCK_HASH_TEST_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(test_block_hash_suite) {
+    MU_RUN_TEST(test_block_hash_weak);
+    MU_RUN_TEST(test_block_hash_roll);
+    MU_RUN_TEST(test_block_hash_file);
+}
+
+int run_minunit_test_block_hash(void) {
+    MU_RUN_SUITE(test_block_hash_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_block_hash)
@@ -0,0 +1,193 @@
+#include "../test.h" // IWYU pragma: keep
+
+#include <gui/canvas_i.h>
+#include <u8g2_glue.h>
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <furi_hal_random.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#define TAG "CanvasTest"
+
+#define CANVAS_TEST_FRAMEBUFFER_SIZE (128 * 64 / 8)
+#define CANVAS_TEST_BITMAP_SIZE (64 * 64 / 8)
+#define CANVAS_TEST_ROUNDS (2000)
+#define CANVAS_TEST_BENCH_FRAMES (100)
+
+typedef struct {
+    u8g2_t fb;
+    uint8_t buffer[CANVAS_TEST_FRAMEBUFFER_SIZE];
+} CanvasTestFramebuffer;
+
+static void canvas_test_framebuffer_init(CanvasTestFramebuffer* framebuffer) {
+    // Display callbacks are never invoked: nothing is sent, only the memory layout is used
+    u8g2_Setup_st756x_flipper(&framebuffer->fb, U8G2_R0, u8x8_dummy_cb, u8x8_dummy_cb);
+    u8g2_SetupBuffer(
+        &framebuffer->fb,
+        framebuffer->buffer,
+        CANVAS_TEST_FRAMEBUFFER_SIZE / 128,
+        u8g2_ll_hvline_vertical_top_lsb,
+        U8G2_R0);
+}
+
+// Pixel by pixel bitmap drawing, the way canvas did it before the blitter
+static void canvas_test_reference_draw(
+    u8g2_t* u8g2,
+    int32_t x,
+    int32_t y,
+    size_t w,
+    size_t h,
+    IconRotation rotation,
+    const uint8_t* bitmap) {
+    if(u8g2_IsIntersection(u8g2, x, y, x + w, y + h) == 0) return;
+
+    const size_t row_size = (w + 7) / 8;
+    const uint8_t color = u8g2->draw_color;
+    for(size_t row = 0; row < h; row++) {
+        for(size_t column = 0; column < w; column++) {
+            int32_t px = x, py = y;
+            if(rotation == IconRotation0) {
+                px += column;
+                py += row;
+            } else if(rotation == IconRotation90) {
+                px += w + 1 - row;
+                py += column;
+            } else if(rotation == IconRotation180) {
+                px += column;
+                py += h - 1 - row;
+            } else {
+                px += row;
+                py += column;
+            }
+
+            if(FURI_BIT(bitmap[row * row_size + column / 8], column % 8)) {
+                u8g2_SetDrawColor(u8g2, color);
+            } else if(u8g2->bitmap_transparency == 0) {
+                u8g2_SetDrawColor(u8g2, color == 0 ? 1 : 0);
+            } else {
+                continue;
+            }
+            u8g2_DrawPixel(u8g2, px, py);
+        }
+    }
+    u8g2_SetDrawColor(u8g2, color);
+}
+
+MU_TEST(canvas_bitmap_blit_test) {
+    CanvasTestFramebuffer* blit = malloc(sizeof(CanvasTestFramebuffer));
+    CanvasTestFramebuffer* reference = malloc(sizeof(CanvasTestFramebuffer));
+    uint8_t* bitmap = malloc(CANVAS_TEST_BITMAP_SIZE);
+    canvas_test_framebuffer_init(blit);
+    canvas_test_framebuffer_init(reference);
+
+    for(size_t round = 0; round < CANVAS_TEST_ROUNDS; round++) {
+        furi_hal_random_fill_buf(blit->buffer, CANVAS_TEST_FRAMEBUFFER_SIZE);
+        memcpy(reference->buffer, blit->buffer, CANVAS_TEST_FRAMEBUFFER_SIZE);
+        furi_hal_random_fill_buf(bitmap, CANVAS_TEST_BITMAP_SIZE);
+
+        size_t w = 1 + furi_hal_random_get() % 40;
+        size_t h = 1 + furi_hal_random_get() % 40;
+        int32_t x = (int32_t)(furi_hal_random_get() % 200) - 60;
+        int32_t y = (int32_t)(furi_hal_random_get() % 140) - 60;
+        IconRotation rotation = furi_hal_random_get() % 4;
+        uint8_t color = furi_hal_random_get() % 3;
+        uint8_t transparent = round % 2;
+
+        if(round % 4 == 0) {
+            u8g2_SetClipWindow(&blit->fb, 10, 5, 100, 50);
+            u8g2_SetClipWindow(&reference->fb, 10, 5, 100, 50);
+        } else {
+            u8g2_SetMaxClipWindow(&blit->fb);
+            u8g2_SetMaxClipWindow(&reference->fb);
+        }
+        u8g2_SetDrawColor(&blit->fb, color);
+        u8g2_SetDrawColor(&reference->fb, color);
+        u8g2_SetBitmapMode(&blit->fb, transparent);
+        u8g2_SetBitmapMode(&reference->fb, transparent);
+
+        canvas_draw_u8g2_bitmap(&blit->fb, x, y, w, h, bitmap, rotation);
+        canvas_test_reference_draw(&reference->fb, x, y, w, h, rotation, bitmap);
+        mu_assert(
+            memcmp(blit->buffer, reference->buffer, CANVAS_TEST_FRAMEBUFFER_SIZE) == 0,
+            "blitted bitmap differs from per-pixel drawing");
+    }
+
+    free(bitmap);
+    free(reference);
+    free(blit);
+}
+
+// Full screen animation frame followed by a menu: 5 rows of 10x10 icons and a scrollbar
+static void canvas_test_render_scene(u8g2_t* u8g2, const uint8_t* bitmap, bool use_reference) {
+    u8g2_SetMaxClipWindow(u8g2);
+    u8g2_SetDrawColor(u8g2, 1);
+    u8g2_SetBitmapMode(u8g2, 0);
+    if(use_reference) {
+        canvas_test_reference_draw(u8g2, 0, 0, 128, 64, IconRotation0, bitmap);
+    } else {
+        canvas_draw_u8g2_bitmap(u8g2, 0, 0, 128, 64, bitmap, IconRotation0);
+    }
+
+    u8g2_SetBitmapMode(u8g2, 1);
+    for(int32_t row = 0; row < 5; row++) {
+        if(use_reference) {
+            canvas_test_reference_draw(u8g2, 2, 2 + row * 12, 10, 10, IconRotation0, bitmap);
+            canvas_test_reference_draw(u8g2, 124, row * 12, 3, 12, IconRotation0, bitmap);
+        } else {
+            canvas_draw_u8g2_bitmap(u8g2, 2, 2 + row * 12, 10, 10, bitmap, IconRotation0);
+            canvas_draw_u8g2_bitmap(u8g2, 124, row * 12, 3, 12, bitmap, IconRotation0);
+        }
+    }
+}
+
+MU_TEST(canvas_bitmap_blit_benchmark) {
+    CanvasTestFramebuffer* framebuffer = malloc(sizeof(CanvasTestFramebuffer));
+    uint8_t* bitmap = malloc(CANVAS_TEST_FRAMEBUFFER_SIZE);
+    uint8_t* reference = malloc(CANVAS_TEST_FRAMEBUFFER_SIZE);
+    canvas_test_framebuffer_init(framebuffer);
+    furi_hal_random_fill_buf(bitmap, CANVAS_TEST_FRAMEBUFFER_SIZE);
+
+    uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < CANVAS_TEST_BENCH_FRAMES; i++) {
+        canvas_test_render_scene(&framebuffer->fb, bitmap, true);
+    }
+    uint32_t reference_time = furi_get_tick() - start;
+    memcpy(reference, framebuffer->buffer, CANVAS_TEST_FRAMEBUFFER_SIZE);
+
+    start = furi_get_tick();
+    for(size_t i = 0; i < CANVAS_TEST_BENCH_FRAMES; i++) {
+        canvas_test_render_scene(&framebuffer->fb, bitmap, false);
+    }
+    uint32_t blit_time = furi_get_tick() - start;
+
+    FURI_LOG_I(
+        TAG,
+        "%d frames: per-pixel %lums (%lu fps), blit %lums (%lu fps)",
+        CANVAS_TEST_BENCH_FRAMES,
+        reference_time,
+        CANVAS_TEST_BENCH_FRAMES * 1000 / MAX(reference_time, 1UL),
+        blit_time,
+        CANVAS_TEST_BENCH_FRAMES * 1000 / MAX(blit_time, 1UL));
+    mu_assert(
+        memcmp(framebuffer->buffer, reference, CANVAS_TEST_FRAMEBUFFER_SIZE) == 0,
+        "blitted scene differs from per-pixel drawing");
+
+    free(reference);
+    free(bitmap);
+    free(framebuffer);
+}
+
+MU_TEST_SUITE(test_canvas) {
+    MU_RUN_TEST(canvas_bitmap_blit_test);
+    MU_RUN_TEST(canvas_bitmap_blit_benchmark);
+}
+
+int run_minunit_test_canvas(void) {
+    MU_RUN_SUITE(test_canvas);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_canvas)
@@ -4,6 +4,8 @@
 #include <toolbox/stream/stream.h>
 #include "../test.h" // IWYU pragma: keep
 
+#define TAG "FlipperFormatTest"
+
 #define TEST_DIR TEST_DIR_NAME "/"
 #define TEST_DIR_NAME EXT_PATH("unit_tests_tmp")
 
@@ -84,6 +86,16 @@ static const char* test_file_flipper = TEST_DIR READ_TEST_FLP;
 // data containing odd user input
 static const char* test_file_oddities = TEST_DIR READ_TEST_ODD;
 
+#define READ_TEST_DATABASE "ff_database.test"
+#define TEST_DATABASE_SIGNALS 200
+#define TEST_DATABASE_DATA_SIZE 256
+static const char* test_file_database = TEST_DIR READ_TEST_DATABASE;
+
+#define READ_TEST_INDEX "ff_index.test"
+#define TEST_INDEX_BLOCKS 64
+#define TEST_INDEX_BLOCK_SIZE 16
+static const char* test_file_index = TEST_DIR READ_TEST_INDEX;
+
 static bool storage_write_string(const char* path, const char* data) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* file = storage_file_alloc(storage);
@@ -456,6 +468,222 @@ static bool test_read_multikey(const char* file_name) {
     return result;
 }
 
+static bool test_write_database(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+
+    FuriString* name = furi_string_alloc();
+    uint8_t* data = malloc(TEST_DATABASE_DATA_SIZE);
+
+    do {
+        if(!flipper_format_file_open_always(file, file_name)) break;
+        if(!flipper_format_write_header_cstr(file, test_filetype, test_version)) break;
+
+        bool error = false;
+        for(uint32_t index = 0; index < TEST_DATABASE_SIGNALS; index++) {
+            for(size_t i = 0; i < TEST_DATABASE_DATA_SIZE; i++) {
+                data[i] = index + i;
+            }
+            furi_string_printf(name, "Signal_%lu", index);
+
+            if(!flipper_format_write_comment_cstr(file, "") ||
+               !flipper_format_write_string(file, "name", name) ||
+               !flipper_format_write_string_cstr(file, "type", "raw") ||
+               !flipper_format_write_uint32(file, "frequency", &index, 1) ||
+               !flipper_format_write_hex(file, "data", data, TEST_DATABASE_DATA_SIZE)) {
+                error = true;
+                break;
+            }
+        }
+        if(error) break;
+
+        result = true;
+    } while(false);
+
+    free(data);
+    furi_string_free(name);
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static bool test_read_database(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+
+    FuriString* string_value = furi_string_alloc();
+    uint32_t uint32_value;
+    uint8_t* data = malloc(TEST_DATABASE_DATA_SIZE);
+
+    do {
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+        if(!flipper_format_read_header(file, string_value, &uint32_value)) break;
+
+        uint32_t start = furi_get_tick();
+        uint32_t index = 0;
+        bool error = false;
+        while(flipper_format_read_string(file, "name", string_value)) {
+            if(!flipper_format_read_uint32(file, "frequency", &uint32_value, 1) ||
+               uint32_value != index ||
+               !flipper_format_read_hex(file, "data", data, TEST_DATABASE_DATA_SIZE)) {
+                error = true;
+                break;
+            }
+
+            for(size_t i = 0; i < TEST_DATABASE_DATA_SIZE; i++) {
+                if(data[i] != (uint8_t)(index + i)) {
+                    error = true;
+                    break;
+                }
+            }
+            if(error) break;
+            index++;
+        }
+        if(error || index != TEST_DATABASE_SIGNALS) break;
+
+        FURI_LOG_I(
+            TAG,
+            "Parsed %lu signals, %lu bytes in %lums",
+            index,
+            (uint32_t)stream_size(flipper_format_get_raw_stream(file)),
+            furi_get_tick() - start);
+
+        result = true;
+    } while(false);
+
+    free(data);
+    furi_string_free(string_value);
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static bool test_write_index(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+
+    FuriString* key = furi_string_alloc();
+    uint8_t data[TEST_INDEX_BLOCK_SIZE];
+
+    do {
+        if(!flipper_format_file_open_always(file, file_name)) break;
+        if(!flipper_format_write_header_cstr(file, test_filetype, test_version)) break;
+        if(!flipper_format_write_comment_cstr(file, "Block: 0 is not a key")) break;
+
+        bool error = false;
+        for(uint32_t block = 0; block < TEST_INDEX_BLOCKS; block++) {
+            memset(data, block, sizeof(data));
+            furi_string_printf(key, "Block %lu", block);
+            if(!flipper_format_write_hex(file, furi_string_get_cstr(key), data, sizeof(data))) {
+                error = true;
+                break;
+            }
+        }
+        if(error) break;
+
+        result = true;
+    } while(false);
+
+    furi_string_free(key);
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static bool test_read_index_block(FlipperFormat* file, uint32_t block, uint8_t value) {
+    FuriString* key = furi_string_alloc_printf("Block %lu", block);
+    uint8_t data[TEST_INDEX_BLOCK_SIZE];
+    bool result = false;
+
+    do {
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_hex(file, furi_string_get_cstr(key), data, sizeof(data))) break;
+
+        result = true;
+        for(size_t i = 0; i < sizeof(data); i++) {
+            if(data[i] != value) {
+                result = false;
+                break;
+            }
+        }
+    } while(false);
+
+    furi_string_free(key);
+
+    return result;
+}
+
+static bool test_read_index(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+
+    FuriString* string_value = furi_string_alloc();
+    uint32_t uint32_value;
+    uint8_t data[TEST_INDEX_BLOCK_SIZE];
+
+    do {
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+        if(!flipper_format_build_index(file)) break;
+        if(!flipper_format_read_header(file, string_value, &uint32_value)) break;
+        if(furi_string_cmp_str(string_value, test_filetype) != 0) break;
+        if(uint32_value != test_version) break;
+
+        // Random access, backwards
+        uint32_t start = furi_get_tick();
+        bool error = false;
+        for(uint32_t block = TEST_INDEX_BLOCKS; block > 0; block--) {
+            if(!test_read_index_block(file, block - 1, block - 1)) {
+                error = true;
+                break;
+            }
+        }
+        if(error) break;
+        FURI_LOG_I(
+            TAG, "Indexed lookup of %u keys: %lums", TEST_INDEX_BLOCKS, furi_get_tick() - start);
+
+        // Reads only look forward, as without the index
+        if(flipper_format_read_hex(file, "Block 0", data, sizeof(data))) break;
+        if(!flipper_format_key_exist(file, "Block 0")) break;
+        if(flipper_format_key_exist(file, "Block")) break;
+
+        // Strict mode stops at the first other key
+        flipper_format_set_strict_mode(file, true);
+        if(!flipper_format_rewind(file)) break;
+        if(flipper_format_read_hex(file, "Block 1", data, sizeof(data))) break;
+        flipper_format_set_strict_mode(file, false);
+
+        // Writes drop the index
+        memset(data, 0xA5, sizeof(data));
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_update_hex(file, "Block 10", data, sizeof(data))) break;
+        if(!test_read_index_block(file, 10, 0xA5)) break;
+        if(!test_read_index_block(file, 11, 11)) break;
+
+        if(!flipper_format_build_index(file)) break;
+        if(!test_read_index_block(file, 10, 0xA5)) break;
+        if(!test_read_index_block(file, TEST_INDEX_BLOCKS - 1, TEST_INDEX_BLOCKS - 1)) break;
+
+        result = true;
+    } while(false);
+
+    furi_string_free(string_value);
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
 MU_TEST(flipper_format_write_test) {
     mu_assert(storage_write_string(test_file_linux, test_data_nix), "Write test error [Linux]");
     mu_assert(
@@ -528,6 +756,16 @@ MU_TEST(flipper_format_oddities_test) {
     mu_assert(test_read(test_file_linux), "Read test error [Oddities]");
 }
 
+MU_TEST(flipper_format_database_test) {
+    mu_assert(test_write_database(test_file_database), "Database write test error");
+    mu_assert(test_read_database(test_file_database), "Database read test error");
+}
+
+MU_TEST(flipper_format_index_test) {
+    mu_assert(test_write_index(test_file_index), "Index write test error");
+    mu_assert(test_read_index(test_file_index), "Index read test error");
+}
+
 MU_TEST_SUITE(flipper_format) {
     tests_setup();
     MU_RUN_TEST(flipper_format_write_test);
@@ -542,6 +780,8 @@ MU_TEST_SUITE(flipper_format) {
     MU_RUN_TEST(flipper_format_update_2_result_test);
     MU_RUN_TEST(flipper_format_multikey_test);
     MU_RUN_TEST(flipper_format_oddities_test);
+    MU_RUN_TEST(flipper_format_database_test);
+    MU_RUN_TEST(flipper_format_index_test);
     tests_teardown();
 }
 
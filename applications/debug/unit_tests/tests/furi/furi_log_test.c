@@ -0,0 +1,137 @@
+#include <string.h>
+#include <furi.h>
+#include "../test.h" // IWYU pragma: keep
+
+#define TAG "LogTest"
+
+#define LOG_TEST_FLOOD_COUNT (256U)
+
+static void test_log_capture(const uint8_t* data, size_t size, void* context) {
+    FuriString* output = context;
+    for(size_t i = 0; i < size; i++) {
+        furi_string_push_back(output, data[i]);
+    }
+}
+
+void test_furi_log_deferred(void) {
+    FuriString* output = furi_string_alloc();
+    const FuriLogHandler handler = {.callback = test_log_capture, .context = output};
+
+    const FuriLogLevel level = furi_log_get_level();
+    const bool deferred = furi_log_get_deferred();
+    furi_log_set_level(FuriLogLevelInfo);
+    mu_assert(furi_log_add_handler(handler), "handler not added");
+
+    furi_log_set_deferred(true);
+    mu_assert(furi_log_get_deferred(), "deferred mode not enabled");
+
+    // Strings are copied, so stack buffer can go away before formatting
+    char name[] = "stack";
+    FURI_LOG_I(
+        TAG,
+        "int %d %05u %lx str %s %.*s float %.2f",
+        -42,
+        7U,
+        0xBEEFUL,
+        name,
+        3,
+        "abcdef",
+        (double)1.5f);
+    memset(name, 'x', sizeof(name) - 1);
+    // Heap format is freed right after the call
+    FuriString* format = furi_string_alloc_set_str("heap %d");
+    furi_log_print_format(FuriLogLevelInfo, TAG, furi_string_get_cstr(format), 7);
+    furi_string_free(format);
+    FURI_LOG_RAW_I("raw %s %%\r\n", "record");
+    FURI_LOG_D(TAG, "filtered by level");
+    furi_log_flush();
+
+    mu_assert(
+        furi_string_search_str(output, "[" TAG "] ") != FURI_STRING_FAILURE, "tag not formatted");
+    mu_assert(
+        furi_string_search_str(output, "int -42 00007 beef str stack abc float 1.50\r\n") !=
+            FURI_STRING_FAILURE,
+        "message not formatted");
+    mu_assert(
+        furi_string_search_str(output, "heap 7\r\n") != FURI_STRING_FAILURE,
+        "heap format not formatted");
+    mu_assert(
+        furi_string_search_str(output, "raw record %\r\n") != FURI_STRING_FAILURE,
+        "raw message not formatted");
+    mu_assert(
+        furi_string_search_str(output, "filtered by level") == FURI_STRING_FAILURE,
+        "level not filtered");
+
+    // Worker has lowest priority, so it can't drain the ring during the flood
+    const uint32_t dropped = furi_log_get_dropped();
+    for(size_t i = 0; i < LOG_TEST_FLOOD_COUNT; i++) {
+        FURI_LOG_I(TAG, "flood %zu %s", i, "0123456789012345678901234567890123456789");
+    }
+    mu_assert(furi_log_get_dropped() > dropped, "drops not counted");
+    furi_log_flush();
+    mu_assert(
+        furi_string_search_str(output, "records dropped") != FURI_STRING_FAILURE,
+        "drops not reported");
+
+    furi_log_set_deferred(deferred);
+    mu_assert(furi_log_remove_handler(handler), "handler not removed");
+    furi_log_set_level(level);
+
+    furi_string_free(output);
+}
+
+static uint32_t test_log_evaluated = 0;
+
+static uint32_t test_log_evaluate(void) {
+    return ++test_log_evaluated;
+}
+
+void test_furi_log_tag_level(void) {
+    FuriString* output = furi_string_alloc();
+    const FuriLogHandler handler = {.callback = test_log_capture, .context = output};
+
+    const FuriLogLevel level = furi_log_get_level();
+    const bool deferred = furi_log_get_deferred();
+    furi_log_set_deferred(false);
+    furi_log_set_level(FuriLogLevelInfo);
+    mu_assert(furi_log_add_handler(handler), "handler not added");
+
+    mu_assert(furi_log_set_tag_level("LogTestDebug", FuriLogLevelDebug), "level not set");
+    mu_assert(furi_log_set_tag_level("LogTestMute", FuriLogLevelNone), "level not set");
+    mu_assert_int_eq(FuriLogLevelDebug, furi_log_get_tag_level("LogTestDebug"));
+    mu_assert_int_eq(FuriLogLevelDefault, furi_log_get_tag_level("LogTestOther"));
+    mu_assert(
+        !furi_log_set_tag_level("LogTestTagThatIsFarTooLong", FuriLogLevelDebug),
+        "long tag accepted");
+
+    // Disabled calls must not evaluate arguments
+    test_log_evaluated = 0;
+    FURI_LOG_D("LogTestDebug", "debug %lu", test_log_evaluate());
+    FURI_LOG_D("LogTestOther", "other %lu", test_log_evaluate());
+    FURI_LOG_E("LogTestMute", "mute %lu", test_log_evaluate());
+    FURI_LOG_I("LogTestOther", "info %lu", test_log_evaluate());
+    mu_assert_int_eq(2, test_log_evaluated);
+
+    mu_assert(
+        furi_string_search_str(output, "debug 1\r\n") != FURI_STRING_FAILURE,
+        "tag level not applied");
+    mu_assert(
+        furi_string_search_str(output, "info 2\r\n") != FURI_STRING_FAILURE,
+        "global level not applied");
+    mu_assert(
+        furi_string_search_str(output, "other") == FURI_STRING_FAILURE, "debug not filtered");
+    mu_assert(furi_string_search_str(output, "mute") == FURI_STRING_FAILURE, "tag not muted");
+
+    // Default removes override
+    mu_assert(furi_log_set_tag_level("LogTestDebug", FuriLogLevelDefault), "level not reset");
+    mu_assert(furi_log_set_tag_level("LogTestMute", FuriLogLevelDefault), "level not reset");
+    mu_assert_int_eq(FuriLogLevelDefault, furi_log_get_tag_level("LogTestDebug"));
+    mu_assert(!furi_log_is_enabled(FuriLogLevelDebug, "LogTestDebug"), "override not removed");
+    mu_assert(furi_log_is_enabled(FuriLogLevelError, "LogTestMute"), "override not removed");
+
+    mu_assert(furi_log_remove_handler(handler), "handler not removed");
+    furi_log_set_level(level);
+    furi_log_set_deferred(deferred);
+
+    furi_string_free(output);
+}
@@ -10,6 +10,9 @@ void test_furi_pubsub(void);
 void test_furi_memmgr(void);
 void test_furi_memmgr_advanced(void);
 
+void test_furi_log_deferred(void);
+void test_furi_log_tag_level(void);
+
 static int foo = 0;
 
 void test_setup(void) {
@@ -40,6 +43,14 @@ MU_TEST(mu_test_furi_memmgr) {
     test_furi_memmgr_advanced();
 }
 
+MU_TEST(mu_test_furi_log_deferred) {
+    test_furi_log_deferred();
+}
+
+MU_TEST(mu_test_furi_log_tag_level) {
+    test_furi_log_tag_level();
+}
+
 MU_TEST_SUITE(test_suite) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -49,6 +60,8 @@ MU_TEST_SUITE(test_suite) {
     MU_RUN_TEST(mu_test_furi_create_open);
     MU_RUN_TEST(mu_test_furi_pubsub);
     MU_RUN_TEST(mu_test_furi_memmgr);
+    MU_RUN_TEST(mu_test_furi_log_deferred);
+    MU_RUN_TEST(mu_test_furi_log_tag_level);
 }
 
 int run_minunit_test_furi(void) {
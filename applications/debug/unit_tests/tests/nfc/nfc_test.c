@@ -18,6 +18,8 @@
 #include <nfc/protocols/slix/slix_i.h>
 #include <nfc/protocols/slix/slix_poller.h>
 #include <nfc/protocols/slix/slix_poller_i.h>
+#include <nfc/helpers/crypto1.h>
+#include <nfc/helpers/nfc_util.h>
 
 #include <nfc/nfc_poller.h>
 
@@ -30,9 +32,17 @@
 
 #define NFC_TEST_NFC_DEV_PATH EXT_PATH("unit_tests/nfc/nfc_device_test.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_dict.nfc")
+#define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_COMPILED_PATH \
+    EXT_PATH("unit_tests/mf_dict" KEYS_DICT_COMPILED_EXTENSION)
 
 #define NFC_TEST_FLAG_WORKER_DONE (1)
 
+#define NFC_TEST_CRYPTO1_ROUNDS (1000)
+#define NFC_TEST_CRYPTO1_BENCH_WORDS (20000)
+
+#define NFC_TEST_DICT_BENCH_KEYS (5000)
+#define NFC_TEST_DICT_BENCH_FILE_LOOKUPS (20)
+
 typedef enum {
     NfcTestMfClassicSendFrameTestStateAuth,
     NfcTestMfClassicSendFrameTestStateReadBlock,
@@ -577,6 +587,110 @@ MU_TEST(mf_classic_send_frame_test) {
     nfc_free(poller);
 }
 
+static uint32_t nfc_test_crypto1_reference_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
+    uint32_t out = 0;
+    for(uint8_t i = 0; i < 32; i++) {
+        uint8_t bit = FURI_BIT(in, i ^ 24);
+        out |= (uint32_t)crypto1_bit(crypto1, bit, is_encrypted) << (i ^ 24);
+    }
+    return out;
+}
+
+static uint8_t nfc_test_crypto1_reference_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    uint8_t out = 0;
+    for(uint8_t i = 0; i < 8; i++) {
+        out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
+    }
+    return out;
+}
+
+MU_TEST(crypto1_bit_serial_equivalence_test) {
+    Crypto1* crypto = crypto1_alloc();
+    Crypto1* reference = crypto1_alloc();
+    BitBuffer* plain = bit_buffer_alloc(18);
+    BitBuffer* encrypted = bit_buffer_alloc(18);
+    BitBuffer* decrypted = bit_buffer_alloc(18);
+    uint8_t data[18] = {};
+
+    for(size_t round = 0; round < NFC_TEST_CRYPTO1_ROUNDS; round++) {
+        uint64_t key = ((uint64_t)furi_hal_random_get() << 16 ^ furi_hal_random_get()) &
+                       0xFFFFFFFFFFFF;
+        int is_encrypted = round & 1;
+        crypto1_init(crypto, key);
+        crypto1_init(reference, key);
+
+        uint32_t word = furi_hal_random_get();
+        mu_assert(
+            crypto1_word(crypto, word, is_encrypted) ==
+                nfc_test_crypto1_reference_word(reference, word, is_encrypted),
+            "crypto1_word mismatch");
+        uint8_t byte = furi_hal_random_get();
+        mu_assert(
+            crypto1_byte(crypto, byte, is_encrypted) ==
+                nfc_test_crypto1_reference_byte(reference, byte, is_encrypted),
+            "crypto1_byte mismatch");
+
+        // Encrypted bytes and parity bits must match the bit-serial keystream
+        size_t size = 1 + round % sizeof(data);
+        furi_hal_random_fill_buf(data, size);
+        bit_buffer_copy_bytes(plain, data, size);
+        Crypto1 decrypt_state = *crypto;
+        crypto1_encrypt(crypto, NULL, plain, encrypted);
+        const uint8_t* encrypted_data = bit_buffer_get_data(encrypted);
+        const uint8_t* encrypted_parity = bit_buffer_get_parity(encrypted);
+        for(size_t i = 0; i < size; i++) {
+            uint8_t keystream = nfc_test_crypto1_reference_byte(reference, 0, 0);
+            mu_assert(encrypted_data[i] == (keystream ^ data[i]), "crypto1_encrypt data mismatch");
+            Crypto1 next = *reference;
+            bool parity = crypto1_bit(&next, 0, 0) ^ nfc_util_odd_parity8(data[i]);
+            mu_assert(
+                FURI_BIT(encrypted_parity[i / 8], i % 8) == parity,
+                "crypto1_encrypt parity mismatch");
+        }
+        mu_assert(
+            (crypto->odd == reference->odd) && (crypto->even == reference->even),
+            "crypto1_encrypt state mismatch");
+
+        crypto1_decrypt(&decrypt_state, encrypted, decrypted);
+        mu_assert(
+            memcmp(bit_buffer_get_data(decrypted), data, size) == 0,
+            "crypto1_decrypt data mismatch");
+        const uint8_t* decrypted_parity = bit_buffer_get_parity(decrypted);
+        for(size_t i = 0; i < size; i++) {
+            mu_assert(
+                FURI_BIT(decrypted_parity[i / 8], i % 8) == nfc_util_odd_parity8(data[i]),
+                "crypto1_decrypt parity mismatch");
+        }
+    }
+
+    crypto1_init(crypto, 0xFFFFFFFFFFFF);
+    crypto1_init(reference, 0xFFFFFFFFFFFF);
+    uint32_t checksum = 0;
+    uint32_t start = furi_get_tick();
+    for(uint32_t i = 0; i < NFC_TEST_CRYPTO1_BENCH_WORDS; i++) {
+        checksum ^= nfc_test_crypto1_reference_word(reference, i, 0);
+    }
+    uint32_t bit_serial_time = furi_get_tick() - start;
+    start = furi_get_tick();
+    for(uint32_t i = 0; i < NFC_TEST_CRYPTO1_BENCH_WORDS; i++) {
+        checksum ^= crypto1_word(crypto, i, 0);
+    }
+    uint32_t word_time = furi_get_tick() - start;
+    mu_assert(checksum == 0, "crypto1_word benchmark mismatch");
+    FURI_LOG_I(
+        TAG,
+        "Crypto1 %d words: bit-serial %lums, byte-wise %lums",
+        NFC_TEST_CRYPTO1_BENCH_WORDS,
+        bit_serial_time,
+        word_time);
+
+    bit_buffer_free(decrypted);
+    bit_buffer_free(encrypted);
+    bit_buffer_free(plain);
+    crypto1_free(reference);
+    crypto1_free(crypto);
+}
+
 MU_TEST(mf_classic_dict_test) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     if(storage_common_stat(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, NULL) == FSE_OK) {
@@ -646,6 +760,308 @@ MU_TEST(mf_classic_dict_test) {
         "Remove test dict failed");
 }
 
+MU_TEST(mf_classic_dict_loaded_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(storage_common_stat(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, NULL) == FSE_OK) {
+        mu_assert(
+            storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH),
+            "Remove test dict failed");
+    }
+
+    const uint32_t test_key_num = 30;
+    MfClassicKey* key_arr_ref = malloc((test_key_num + 1) * sizeof(MfClassicKey));
+    KeysDict* dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, KeysDictModeOpenAlways, sizeof(MfClassicKey));
+    mu_assert(dict != NULL, "keys_dict_alloc() failed");
+    for(size_t i = 0; i < test_key_num + 1; i++) {
+        furi_hal_random_fill_buf(key_arr_ref[i].data, sizeof(MfClassicKey));
+        if(i < test_key_num) {
+            mu_assert(
+                keys_dict_add_key(dict, key_arr_ref[i].data, sizeof(MfClassicKey)),
+                "add key failed");
+        }
+    }
+    keys_dict_free(dict);
+
+    dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH,
+        KeysDictModeOpenAlways | KeysDictModeLoad,
+        sizeof(MfClassicKey));
+    mu_assert(dict != NULL, "keys_dict_alloc() failed");
+    mu_assert(keys_dict_get_total_keys(dict) == test_key_num, "keys_dict_keys_total() failed");
+
+    MfClassicKey key_dut = {};
+    size_t key_idx = 0;
+    while(keys_dict_get_next_key(dict, key_dut.data, sizeof(MfClassicKey))) {
+        mu_assert(
+            memcmp(key_arr_ref[key_idx].data, key_dut.data, sizeof(MfClassicKey)) == 0,
+            "Loaded key data mismatch");
+        key_idx++;
+    }
+    mu_assert(key_idx == test_key_num, "Loaded key count mismatch");
+
+    // Present keys are not added twice
+    mu_assert(
+        keys_dict_add_key(dict, key_arr_ref[0].data, sizeof(MfClassicKey)), "add key failed");
+    mu_assert(keys_dict_get_total_keys(dict) == test_key_num, "Duplicate key added");
+
+    uint32_t delete_keys_idx[] = {1, 3, 9, 11, 19, 27};
+    for(size_t i = 0; i < COUNT_OF(delete_keys_idx); i++) {
+        MfClassicKey* key = &key_arr_ref[delete_keys_idx[i]];
+        mu_assert(
+            keys_dict_is_key_present(dict, key->data, sizeof(MfClassicKey)),
+            "keys_dict_is_key_present() failed");
+        mu_assert(
+            keys_dict_delete_key(dict, key->data, sizeof(MfClassicKey)),
+            "keys_dict_delete_key() failed");
+        mu_assert(
+            !keys_dict_is_key_present(dict, key->data, sizeof(MfClassicKey)),
+            "Deleted key is present");
+    }
+
+    MfClassicKey* new_key = &key_arr_ref[test_key_num];
+    mu_assert(
+        !keys_dict_is_key_present(dict, new_key->data, sizeof(MfClassicKey)),
+        "keys_dict_is_key_present() failed");
+    mu_assert(keys_dict_add_key(dict, new_key->data, sizeof(MfClassicKey)), "add key failed");
+    keys_dict_free(dict);
+
+    // Changes are written back to the file
+    dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, KeysDictModeOpenExisting, sizeof(MfClassicKey));
+    mu_assert(dict != NULL, "keys_dict_alloc() failed");
+    mu_assert(
+        keys_dict_get_total_keys(dict) == test_key_num - COUNT_OF(delete_keys_idx) + 1,
+        "keys_dict_keys_total() failed");
+    for(size_t i = 0; i < COUNT_OF(delete_keys_idx); i++) {
+        MfClassicKey* key = &key_arr_ref[delete_keys_idx[i]];
+        mu_assert(
+            !keys_dict_is_key_present(dict, key->data, sizeof(MfClassicKey)),
+            "Deleted key is present");
+    }
+    mu_assert(
+        keys_dict_is_key_present(dict, new_key->data, sizeof(MfClassicKey)),
+        "Added key is not present");
+    keys_dict_free(dict);
+    free(key_arr_ref);
+
+    mu_assert(
+        storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH),
+        "Remove test dict failed");
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(mf_classic_dict_compiled_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH);
+    storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_COMPILED_PATH);
+
+    const uint32_t test_key_num = 30;
+    MfClassicKey* key_arr_ref = malloc((test_key_num + 1) * sizeof(MfClassicKey));
+    KeysDict* dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, KeysDictModeOpenAlways, sizeof(MfClassicKey));
+    mu_assert(dict != NULL, "keys_dict_alloc() failed");
+    for(size_t i = 0; i < test_key_num + 1; i++) {
+        furi_hal_random_fill_buf(key_arr_ref[i].data, sizeof(MfClassicKey));
+        if(i == test_key_num) break;
+        mu_assert(
+            keys_dict_add_key(dict, key_arr_ref[i].data, sizeof(MfClassicKey)), "add key failed");
+        // Duplicates are dropped by the compiled list
+        if(i % 10 == 9) {
+            mu_assert(
+                keys_dict_add_key(dict, key_arr_ref[0].data, sizeof(MfClassicKey)),
+                "add key failed");
+        }
+    }
+    keys_dict_free(dict);
+
+    dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH,
+        KeysDictModeOpenExisting | KeysDictModeCompiled,
+        sizeof(MfClassicKey));
+    mu_assert(dict != NULL, "keys_dict_alloc() failed");
+    mu_assert(
+        storage_common_stat(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_COMPILED_PATH, NULL) ==
+            FSE_OK,
+        "Compiled dict is not created");
+    mu_assert(keys_dict_get_total_keys(dict) == test_key_num, "keys_dict_keys_total() failed");
+
+    MfClassicKey key_dut = {};
+    size_t key_idx = 0;
+    while(keys_dict_get_next_key(dict, key_dut.data, sizeof(MfClassicKey))) {
+        mu_assert(
+            memcmp(key_arr_ref[key_idx].data, key_dut.data, sizeof(MfClassicKey)) == 0,
+            "Compiled key data mismatch");
+        key_idx++;
+        if(key_idx == test_key_num / 2) {
+            mu_assert(
+                keys_dict_is_key_present(dict, key_arr_ref[1].data, sizeof(MfClassicKey)),
+                "keys_dict_is_key_present() failed");
+        }
+    }
+    mu_assert(key_idx == test_key_num, "Compiled key count mismatch");
+
+    MfClassicKey* new_key = &key_arr_ref[test_key_num];
+    mu_assert(
+        !keys_dict_add_key(dict, new_key->data, sizeof(MfClassicKey)),
+        "Compiled dict is writable");
+    keys_dict_free(dict);
+
+    // Compiled list follows changes of the text one
+    dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, KeysDictModeOpenExisting, sizeof(MfClassicKey));
+    mu_assert(keys_dict_add_key(dict, new_key->data, sizeof(MfClassicKey)), "add key failed");
+    keys_dict_free(dict);
+
+    dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH,
+        KeysDictModeOpenExisting | KeysDictModeCompiled,
+        sizeof(MfClassicKey));
+    mu_assert(
+        keys_dict_get_total_keys(dict) == test_key_num + 1, "keys_dict_keys_total() failed");
+    mu_assert(
+        keys_dict_is_key_present(dict, new_key->data, sizeof(MfClassicKey)),
+        "Added key is not present");
+    keys_dict_free(dict);
+    free(key_arr_ref);
+
+    mu_assert(
+        storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH),
+        "Remove test dict failed");
+    mu_assert(
+        storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_COMPILED_PATH),
+        "Remove compiled test dict failed");
+    furi_record_close(RECORD_STORAGE);
+}
+
+static uint64_t nfc_test_dict_bench_key(uint32_t index) {
+    uint64_t key = (index + 1) * 0x9E3779B97F4A7C15ULL;
+    return (key ^ (key >> 29)) & 0xFFFFFFFFFFFFULL;
+}
+
+static uint32_t nfc_test_dict_bench_lookup(KeysDict* dict, uint32_t count, uint32_t step) {
+    MfClassicKey key = {};
+    uint32_t found = 0;
+    for(uint32_t i = 0; i < count; i++) {
+        uint64_t key_int = nfc_test_dict_bench_key((i * step) % NFC_TEST_DICT_BENCH_KEYS);
+        for(size_t j = sizeof(MfClassicKey); j > 0; j--) {
+            key.data[j - 1] = key_int;
+            key_int >>= 8;
+        }
+        found += keys_dict_is_key_present(dict, key.data, sizeof(MfClassicKey));
+    }
+    return found;
+}
+
+static uint32_t nfc_test_dict_bench_iterate(KeysDict* dict) {
+    MfClassicKey key = {};
+    uint32_t count = 0;
+    keys_dict_rewind(dict);
+    while(keys_dict_get_next_key(dict, key.data, sizeof(MfClassicKey))) {
+        count++;
+    }
+    return count;
+}
+
+MU_TEST(mf_classic_dict_benchmark) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    FuriString* chunk = furi_string_alloc();
+
+    mu_assert(
+        storage_file_open(
+            file, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS),
+        "Open test dict failed");
+    for(uint32_t i = 0; i < NFC_TEST_DICT_BENCH_KEYS; i++) {
+        uint64_t key = nfc_test_dict_bench_key(i);
+        furi_string_cat_printf(
+            chunk, "%08lX%04lX\n", (uint32_t)(key >> 16), (uint32_t)(key & 0xFFFF));
+        if(furi_string_size(chunk) > 1024 || i == NFC_TEST_DICT_BENCH_KEYS - 1) {
+            size_t size = furi_string_size(chunk);
+            mu_assert(
+                storage_file_write(file, furi_string_get_cstr(chunk), size) == size,
+                "Write test dict failed");
+            furi_string_reset(chunk);
+        }
+    }
+    storage_file_close(file);
+
+    uint32_t start = furi_get_tick();
+    KeysDict* dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, KeysDictModeOpenExisting, sizeof(MfClassicKey));
+    uint32_t file_open_time = furi_get_tick() - start;
+    mu_assert(keys_dict_get_total_keys(dict) == NFC_TEST_DICT_BENCH_KEYS, "Test dict size");
+    start = furi_get_tick();
+    uint32_t found = nfc_test_dict_bench_lookup(dict, NFC_TEST_DICT_BENCH_FILE_LOOKUPS, 251);
+    uint32_t file_lookup_time = furi_get_tick() - start;
+    mu_assert(found == NFC_TEST_DICT_BENCH_FILE_LOOKUPS, "File lookup failed");
+    start = furi_get_tick();
+    found = nfc_test_dict_bench_iterate(dict);
+    uint32_t file_iterate_time = furi_get_tick() - start;
+    mu_assert(found == NFC_TEST_DICT_BENCH_KEYS, "File iteration failed");
+    keys_dict_free(dict);
+
+    start = furi_get_tick();
+    dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH,
+        KeysDictModeOpenExisting | KeysDictModeLoad,
+        sizeof(MfClassicKey));
+    uint32_t load_time = furi_get_tick() - start;
+    mu_assert(keys_dict_get_total_keys(dict) == NFC_TEST_DICT_BENCH_KEYS, "Test dict size");
+    start = furi_get_tick();
+    found = nfc_test_dict_bench_lookup(dict, NFC_TEST_DICT_BENCH_KEYS, 251);
+    uint32_t loaded_lookup_time = furi_get_tick() - start;
+    mu_assert(found == NFC_TEST_DICT_BENCH_KEYS, "Loaded lookup failed");
+    keys_dict_free(dict);
+
+    storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_COMPILED_PATH);
+    uint32_t compiled_open_time[2];
+    for(size_t i = 0; i < COUNT_OF(compiled_open_time); i++) {
+        start = furi_get_tick();
+        dict = keys_dict_alloc(
+            NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH,
+            KeysDictModeOpenExisting | KeysDictModeCompiled,
+            sizeof(MfClassicKey));
+        compiled_open_time[i] = furi_get_tick() - start;
+        mu_assert(keys_dict_get_total_keys(dict) == NFC_TEST_DICT_BENCH_KEYS, "Test dict size");
+        if(i + 1 < COUNT_OF(compiled_open_time)) keys_dict_free(dict);
+    }
+    start = furi_get_tick();
+    found = nfc_test_dict_bench_iterate(dict);
+    uint32_t compiled_iterate_time = furi_get_tick() - start;
+    mu_assert(found == NFC_TEST_DICT_BENCH_KEYS, "Compiled iteration failed");
+    keys_dict_free(dict);
+
+    FURI_LOG_I(
+        TAG,
+        "KeysDict %d keys: file open %lums, %d lookups %lums; load %lums, %d lookups %lums",
+        NFC_TEST_DICT_BENCH_KEYS,
+        file_open_time,
+        NFC_TEST_DICT_BENCH_FILE_LOOKUPS,
+        file_lookup_time,
+        load_time,
+        NFC_TEST_DICT_BENCH_KEYS,
+        loaded_lookup_time);
+    FURI_LOG_I(
+        TAG,
+        "KeysDict %d keys: file iterate %lums; compile %lums, open %lums, iterate %lums",
+        NFC_TEST_DICT_BENCH_KEYS,
+        file_iterate_time,
+        compiled_open_time[0],
+        compiled_open_time[1],
+        compiled_iterate_time);
+
+    furi_string_free(chunk);
+    storage_file_free(file);
+    mu_assert(
+        storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH),
+        "Remove test dict failed");
+    mu_assert(
+        storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_COMPILED_PATH),
+        "Remove compiled test dict failed");
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST(slix_file_with_capabilities_test) {
     NfcDevice* nfc_device_missed_cap = nfc_device_alloc();
     mu_assert(
@@ -807,6 +1223,10 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_classic_value_block);
     MU_RUN_TEST(mf_classic_send_frame_test);
     MU_RUN_TEST(mf_classic_dict_test);
+    MU_RUN_TEST(mf_classic_dict_loaded_test);
+    MU_RUN_TEST(mf_classic_dict_compiled_test);
+    MU_RUN_TEST(mf_classic_dict_benchmark);
+    MU_RUN_TEST(crypto1_bit_serial_equivalence_test);
 
     MU_RUN_TEST(slix_file_with_capabilities_test);
     MU_RUN_TEST(slix_set_password_default_cap_correct_pass);
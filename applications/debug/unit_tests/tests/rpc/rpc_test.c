@@ -50,7 +50,7 @@ static RpcSessionContext rpc_session[TEST_RPC_SESSIONS];
 #define TAG "UnitTestsRpc"
 #define MAX_RECEIVE_OUTPUT_TIMEOUT 3000
 #define MAX_NAME_LENGTH 254
-#define MAX_DATA_SIZE 512u // have to be exact as in rpc_storage.c
+#define MAX_DATA_SIZE RPC_STORAGE_CHUNK_SIZE_DEFAULT
 #define TEST_DIR TEST_DIR_NAME "/"
 #define TEST_DIR_NAME EXT_PATH("unit_tests_tmp")
 #define MD5SUM_SIZE 16
@@ -798,6 +798,7 @@ static void
 static void test_rpc_add_read_to_list_by_reading_real_file(
     MsgList_t msg_list,
     const char* path,
+    size_t chunk_size,
     uint32_t command_id) {
     furi_check(MsgList_empty_p(msg_list));
     Storage* fs_api = furi_record_open(RECORD_STORAGE);
@@ -817,10 +818,10 @@ static void test_rpc_add_read_to_list_by_reading_real_file(
             response->content.storage_read_response.has_file = true;
 
             response->content.storage_read_response.file.data =
-                malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MIN(size_left, MAX_DATA_SIZE)));
+                malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MIN(size_left, chunk_size)));
             uint8_t* buffer = response->content.storage_read_response.file.data->bytes;
             uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
+            size_t read_size = MIN(size_left, chunk_size);
             *read_size_msg = storage_file_read(file, buffer, read_size);
             size_left -= read_size;
             result = (*read_size_msg == read_size);
@@ -844,12 +845,14 @@ static void test_rpc_add_read_to_list_by_reading_real_file(
     furi_record_close(RECORD_STORAGE);
 }
 
-static void test_storage_read_run(const char* path, uint32_t command_id) {
+static void
+    test_storage_read_chunked_run(const char* path, size_t chunk_size, uint32_t command_id) {
     PB_Main request;
     MsgList_t expected_msg_list;
     MsgList_init(expected_msg_list);
 
-    test_rpc_add_read_to_list_by_reading_real_file(expected_msg_list, path, command_id);
+    test_rpc_add_read_to_list_by_reading_real_file(
+        expected_msg_list, path, chunk_size, command_id);
     test_rpc_create_simple_message(&request, PB_Main_storage_read_request_tag, path, command_id);
     test_rpc_encode_and_feed_one(&request, 0);
     test_rpc_decode_and_compare(expected_msg_list, 0);
@@ -858,6 +861,10 @@ static void test_storage_read_run(const char* path, uint32_t command_id) {
     test_rpc_free_msg_list(expected_msg_list);
 }
 
+static void test_storage_read_run(const char* path, uint32_t command_id) {
+    test_storage_read_chunked_run(path, MAX_DATA_SIZE, command_id);
+}
+
 static bool test_is_exists(const char* path) {
     Storage* fs_api = furi_record_open(RECORD_STORAGE);
     FileInfo fileinfo;
@@ -1004,6 +1011,24 @@ MU_TEST(test_storage_read) {
     test_storage_read_run(TEST_DIR "file4.txt", ++command_id);
 }
 
+MU_TEST(test_storage_read_windowed) {
+    const size_t chunk_size = 1024;
+    rpc_session_set_storage_transfer(rpc_session[0].session, chunk_size, RPC_STORAGE_WINDOW_MAX);
+
+    test_create_file(TEST_DIR "empty.txt", 0);
+    test_create_file(TEST_DIR "file1.txt", 1);
+    test_create_file(TEST_DIR "file2.txt", chunk_size);
+    test_create_file(TEST_DIR "file3.txt", (chunk_size * 3) + 1);
+    test_create_file(TEST_DIR "file4.txt", (chunk_size * RPC_STORAGE_WINDOW_MAX * 2) + 7);
+
+    test_storage_read_chunked_run(TEST_DIR "empty.txt", chunk_size, ++command_id);
+    test_storage_read_chunked_run(TEST_DIR "file1.txt", chunk_size, ++command_id);
+    test_storage_read_chunked_run(TEST_DIR "file2.txt", chunk_size, ++command_id);
+    test_storage_read_chunked_run(TEST_DIR "file3.txt", chunk_size, ++command_id);
+    test_storage_read_chunked_run(TEST_DIR "file4.txt", chunk_size, ++command_id);
+    test_storage_read_chunked_run(TEST_DIR "file5.txt", chunk_size, ++command_id);
+}
+
 static void test_storage_write_run(
     const char* path,
     size_t write_size,
@@ -1096,6 +1121,57 @@ MU_TEST(test_storage_write) {
     test_storage_write_run(TEST_DIR "test2.txt", 512, 3, ++command_id, PB_CommandStatus_OK);
 }
 
+MU_TEST(test_storage_write_windowed) {
+    rpc_session_set_storage_transfer(
+        rpc_session[0].session, RPC_STORAGE_CHUNK_SIZE_MAX, RPC_STORAGE_WINDOW_MAX);
+
+    test_storage_write_run(
+        TEST_DIR "afaefo/aefaef/aef/aef/test1.txt",
+        1,
+        1,
+        ++command_id,
+        PB_CommandStatus_ERROR_STORAGE_NOT_EXIST);
+    test_storage_write_run(TEST_DIR "test1.txt", 100, 1, ++command_id, PB_CommandStatus_OK);
+    test_storage_write_run(TEST_DIR "test2.txt", 1, 50, ++command_id, PB_CommandStatus_OK);
+    test_storage_write_run(TEST_DIR "test2.txt", 512, 9, ++command_id, PB_CommandStatus_OK);
+
+    /* Read back by chunks of pattern size, so responses match written requests */
+    uint8_t pattern[] = "0123456789abcdef";
+    rpc_session_set_storage_transfer(
+        rpc_session[0].session, sizeof(pattern), RPC_STORAGE_WINDOW_MAX);
+    test_storage_write_read_run(TEST_DIR "test3.txt", pattern, sizeof(pattern), 40, &command_id);
+}
+
+static uint32_t
+    test_storage_read_benchmark_run(const char* path, size_t chunk_size, size_t window) {
+    rpc_session_set_storage_transfer(rpc_session[0].session, chunk_size, window);
+
+    uint32_t start = furi_get_tick();
+    test_storage_read_chunked_run(path, chunk_size, ++command_id);
+    uint32_t elapsed = furi_get_tick() - start;
+
+    return MAX(elapsed, 1UL);
+}
+
+MU_TEST(test_storage_read_benchmark) {
+    const uint32_t file_size = 16 * 1024;
+    test_create_file(TEST_DIR "bench.bin", file_size);
+
+    uint32_t single = test_storage_read_benchmark_run(TEST_DIR "bench.bin", MAX_DATA_SIZE, 1);
+    uint32_t windowed = test_storage_read_benchmark_run(
+        TEST_DIR "bench.bin", RPC_STORAGE_CHUNK_SIZE_MAX, RPC_STORAGE_WINDOW_MAX);
+
+    FURI_LOG_I(
+        TAG,
+        "Read %lu bytes: %lu B/s by %u, %lu B/s by %ux%u",
+        file_size,
+        file_size * furi_kernel_get_tick_frequency() / single,
+        MAX_DATA_SIZE,
+        file_size * furi_kernel_get_tick_frequency() / windowed,
+        RPC_STORAGE_CHUNK_SIZE_MAX,
+        RPC_STORAGE_WINDOW_MAX);
+}
+
 MU_TEST(test_storage_interrupt_continuous_same_system) {
     MsgList_t input_msg_list;
     MsgList_init(input_msg_list);
@@ -1380,6 +1456,38 @@ MU_TEST(test_storage_md5sum) {
     test_storage_md5sum_run(TEST_DIR "file2.txt", ++command_id, md5sum2, PB_CommandStatus_OK);
 }
 
+#define TEST_STORAGE_MD5SUM_BATCH 20
+
+/* More long running requests in one session than RPC worker queue holds */
+MU_TEST(test_storage_md5sum_batch) {
+    char md5sum[MD5SUM_SIZE * 2 + 1] = {0};
+    MsgList_t input_msg_list;
+    MsgList_init(input_msg_list);
+    MsgList_t expected_msg_list;
+    MsgList_init(expected_msg_list);
+
+    test_create_file(TEST_DIR "file1.txt", 64);
+    test_storage_calculate_md5sum(TEST_DIR "file1.txt", md5sum, MD5SUM_SIZE * 2 + 1);
+
+    for(size_t i = 0; i < TEST_STORAGE_MD5SUM_BATCH; ++i) {
+        test_rpc_create_simple_message(
+            MsgList_push_raw(input_msg_list),
+            PB_Main_storage_md5sum_request_tag,
+            TEST_DIR "file1.txt",
+            ++command_id);
+        PB_Main* response = MsgList_push_new(expected_msg_list);
+        test_rpc_create_simple_message(
+            response, PB_Main_storage_md5sum_response_tag, md5sum, command_id);
+        response->command_status = PB_CommandStatus_OK;
+    }
+
+    test_rpc_encode_and_feed(input_msg_list, 0);
+    test_rpc_decode_and_compare(expected_msg_list, 0);
+
+    test_rpc_free_msg_list(input_msg_list);
+    test_rpc_free_msg_list(expected_msg_list);
+}
+
 static void test_rpc_storage_rename_run(
     const char* old_path,
     const char* new_path,
@@ -1498,12 +1606,16 @@ MU_TEST_SUITE(test_rpc_storage) {
     MU_RUN_TEST(test_storage_list_md5);
     MU_RUN_TEST(test_storage_list_size);
     MU_RUN_TEST(test_storage_read);
+    MU_RUN_TEST(test_storage_read_windowed);
     MU_RUN_TEST(test_storage_write_read);
     MU_RUN_TEST(test_storage_write);
+    MU_RUN_TEST(test_storage_write_windowed);
+    MU_RUN_TEST(test_storage_read_benchmark);
     MU_RUN_TEST(test_storage_delete);
     MU_RUN_TEST(test_storage_delete_recursive);
     MU_RUN_TEST(test_storage_mkdir);
     MU_RUN_TEST(test_storage_md5sum);
+    MU_RUN_TEST(test_storage_md5sum_batch);
     MU_RUN_TEST(test_storage_rename);
 
     DISABLE_TEST(MU_RUN_TEST(test_storage_interrupt_continuous_same_system););
@@ -1827,6 +1939,57 @@ MU_TEST(test_rpc_multisession_storage) {
     test_rpc_storage_teardown();
 }
 
+MU_TEST(test_rpc_multisession_storage_ping_latency) {
+    const uint32_t ping_latency_max = furi_ms_to_ticks(250);
+
+    MsgList_t input_1;
+    MsgList_init(input_1);
+    MsgList_t expected_0;
+    MsgList_init(expected_0);
+    MsgList_t expected_1;
+    MsgList_init(expected_1);
+
+    test_rpc_storage_setup();
+    test_rpc_setup_second_session();
+
+    /* Read is bigger than session output stream, so it stays in progress
+     * until we decode it, with storage busy all that time */
+    test_create_file(TEST_DIR "big.bin", 16 * 1024);
+    PB_Main request;
+    test_rpc_create_simple_message(
+        &request, PB_Main_storage_read_request_tag, TEST_DIR "big.bin", ++command_id);
+    test_rpc_add_read_to_list_by_reading_real_file(
+        expected_0, TEST_DIR "big.bin", MAX_DATA_SIZE, command_id);
+    test_rpc_encode_and_feed_one(&request, 0);
+    furi_delay_ms(100);
+
+    for(size_t i = 0; i < 10; ++i) {
+        test_rpc_add_ping_to_list(input_1, PING_REQUEST, ++command_id);
+        test_rpc_add_ping_to_list(expected_1, PING_RESPONSE, command_id);
+
+        uint32_t start = furi_get_tick();
+        test_rpc_encode_and_feed(input_1, 1);
+        test_rpc_decode_and_compare(expected_1, 1);
+        uint32_t latency = furi_get_tick() - start;
+        FURI_LOG_D(TAG, "Ping latency during storage read: %lu", latency);
+        mu_assert(latency < ping_latency_max, "ping blocked by storage read in another session");
+
+        test_rpc_free_msg_list(input_1);
+        test_rpc_free_msg_list(expected_1);
+        MsgList_init(input_1);
+        MsgList_init(expected_1);
+    }
+
+    test_rpc_decode_and_compare(expected_0, 0);
+
+    test_rpc_free_msg_list(input_1);
+    test_rpc_free_msg_list(expected_0);
+    test_rpc_free_msg_list(expected_1);
+
+    test_rpc_teardown_second_session();
+    test_rpc_storage_teardown();
+}
+
 MU_TEST_SUITE(test_rpc_session) {
     MU_RUN_TEST(test_rpc_feed_rubbish);
     MU_RUN_TEST(test_rpc_multisession_ping);
@@ -1836,6 +1999,7 @@ MU_TEST_SUITE(test_rpc_session) {
         FURI_LOG_E(TAG, "SD card not mounted - skip storage tests");
     } else {
         MU_RUN_TEST(test_rpc_multisession_storage);
+        MU_RUN_TEST(test_rpc_multisession_storage_ping_latency);
     }
     furi_record_close(RECORD_STORAGE);
 }
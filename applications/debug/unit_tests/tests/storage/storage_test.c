@@ -6,6 +6,8 @@
 // This is a hack to access internal storage functions and definitions
 #include <storage/storage_i.h>
 
+#define TAG "StorageTest"
+
 #define UNIT_TESTS_PATH(path) EXT_PATH("unit_tests/" path)
 
 #define STORAGE_LOCKED_FILE EXT_PATH("locked_file.test")
@@ -258,10 +260,51 @@ MU_TEST(storage_dir_exists_test) {
     furi_record_close(RECORD_STORAGE);
 }
 
+MU_TEST(storage_dir_generation_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    uint32_t generation, generation_before;
+
+    mu_assert_int_eq(FSE_OK, storage_common_mkdir(storage, STORAGE_TEST_DIR));
+    mu_assert_int_eq(
+        FSE_OK, storage_common_dir_generation(storage, STORAGE_TEST_DIR, &generation_before));
+
+    // Reading doesn't change the directory
+    mu_check(storage_dir_open(file, STORAGE_TEST_DIR));
+    storage_dir_close(file);
+    mu_assert_int_eq(
+        FSE_OK, storage_common_dir_generation(storage, STORAGE_TEST_DIR, &generation));
+    mu_assert_int_eq(generation_before, generation);
+
+    // Creating a file does, and so does closing it
+    mu_check(storage_file_open(file, STORAGE_TEST_DIR "/file", FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    mu_assert_int_eq(
+        FSE_OK, storage_common_dir_generation(storage, STORAGE_TEST_DIR, &generation));
+    mu_check(generation != generation_before);
+
+    generation_before = generation;
+    mu_check(storage_file_close(file));
+    mu_assert_int_eq(
+        FSE_OK, storage_common_dir_generation(storage, STORAGE_TEST_DIR "/", &generation));
+    mu_check(generation != generation_before);
+
+    generation_before = generation;
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, STORAGE_TEST_DIR "/file"));
+    mu_assert_int_eq(
+        FSE_OK, storage_common_dir_generation(storage, STORAGE_TEST_DIR, &generation));
+    mu_check(generation != generation_before);
+
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, STORAGE_TEST_DIR));
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(storage_dir) {
     MU_RUN_TEST(storage_dir_open_close);
     MU_RUN_TEST(storage_dir_open_lock);
     MU_RUN_TEST(storage_dir_exists_test);
+    MU_RUN_TEST(storage_dir_generation_test);
 }
 
 static const char* const storage_copy_test_paths[] = {
@@ -646,6 +689,295 @@ MU_TEST(test_storage_common_migrate) {
     furi_record_close(RECORD_STORAGE);
 }
 
+#define STORAGE_BATCH_TEST_FILE UNIT_TESTS_PATH("storage_batch.test")
+#define STORAGE_BATCH_TEST_SIZE (4096)
+#define STORAGE_BATCH_BENCH_OPS (32)
+#define STORAGE_BATCH_BENCH_CHUNK (16)
+#define STORAGE_BATCH_BENCH_ROUNDS (16)
+
+static bool storage_batch_test_file_create(Storage* storage, uint8_t* data) {
+    for(size_t i = 0; i < STORAGE_BATCH_TEST_SIZE; i++) {
+        data[i] = (i % 113);
+    }
+
+    File* file = storage_file_alloc(storage);
+    bool result =
+        storage_file_open(file, STORAGE_BATCH_TEST_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+        storage_file_write(file, data, STORAGE_BATCH_TEST_SIZE) == STORAGE_BATCH_TEST_SIZE;
+    storage_file_free(file);
+
+    return result;
+}
+
+MU_TEST(storage_file_readv_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    uint8_t* data = malloc(STORAGE_BATCH_TEST_SIZE);
+    uint8_t* buffer = malloc(STORAGE_BATCH_TEST_SIZE);
+    mu_assert(storage_batch_test_file_create(storage, data), "failed to create test file");
+
+    File* file = storage_file_alloc(storage);
+    mu_check(storage_file_open(file, STORAGE_BATCH_TEST_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+
+    // uneven buffers covering the whole file
+    StorageIoVec vec[] = {
+        {.buff = buffer, .size = 1},
+        {.buff = buffer + 1, .size = 0},
+        {.buff = buffer + 1, .size = 511},
+        {.buff = buffer + 512, .size = STORAGE_BATCH_TEST_SIZE - 512},
+    };
+    mu_assert_int_eq(STORAGE_BATCH_TEST_SIZE, storage_file_readv(file, vec, COUNT_OF(vec)));
+    mu_assert_mem_eq(data, buffer, STORAGE_BATCH_TEST_SIZE);
+    mu_check(storage_file_eof(file));
+
+    // short read at the end of the file
+    mu_check(storage_file_seek(file, STORAGE_BATCH_TEST_SIZE - 100, true));
+    StorageIoVec vec_tail[] = {
+        {.buff = buffer, .size = 64},
+        {.buff = buffer + 64, .size = 64},
+        {.buff = buffer + 128, .size = 64},
+    };
+    mu_assert_int_eq(100, storage_file_readv(file, vec_tail, COUNT_OF(vec_tail)));
+    mu_assert_mem_eq(data + STORAGE_BATCH_TEST_SIZE - 100, buffer, 100);
+
+    mu_assert_int_eq(0, storage_file_readv(file, NULL, 0));
+
+    storage_file_free(file);
+    storage_common_remove(storage, STORAGE_BATCH_TEST_FILE);
+    free(buffer);
+    free(data);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_batch_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    uint8_t* data = malloc(STORAGE_BATCH_TEST_SIZE);
+    mu_assert(storage_batch_test_file_create(storage, data), "failed to create test file");
+
+    File* file = storage_file_alloc(storage);
+    File* dir = storage_file_alloc(storage);
+    mu_check(storage_file_open(file, STORAGE_BATCH_TEST_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+    mu_check(storage_dir_open(dir, EXT_PATH("unit_tests")));
+
+    uint8_t read_a[32], read_b[32], read_c[32];
+    FileInfo stat_file, stat_missing, dir_info;
+    char dir_name[64];
+
+    StorageBatchOp ops[] = {
+        {
+            .type = StorageBatchOpTypeFileRead,
+            .file = file,
+            .offset = 1000,
+            .buff = read_a,
+            .size = sizeof(read_a),
+        },
+        {
+            .type = StorageBatchOpTypeFileRead,
+            .file = file,
+            .offset = 0,
+            .buff = read_b,
+            .size = sizeof(read_b),
+        },
+        {
+            .type = StorageBatchOpTypeFileRead,
+            .file = file,
+            .offset = STORAGE_BATCH_TEST_SIZE - 10,
+            .buff = read_c,
+            .size = sizeof(read_c),
+        },
+        {
+            .type = StorageBatchOpTypeCommonStat,
+            .path = STORAGE_BATCH_TEST_FILE,
+            .fileinfo = &stat_file,
+        },
+        {
+            .type = StorageBatchOpTypeCommonStat,
+            .path = UNIT_TESTS_PATH("storage_batch_missing.test"),
+            .fileinfo = &stat_missing,
+        },
+        {
+            .type = StorageBatchOpTypeDirRead,
+            .file = dir,
+            .buff = dir_name,
+            .size = sizeof(dir_name),
+            .fileinfo = &dir_info,
+        },
+    };
+
+    mu_assert_int_eq(COUNT_OF(ops) - 1, storage_batch(storage, ops, COUNT_OF(ops)));
+
+    mu_assert_int_eq(FSE_OK, ops[0].error);
+    mu_assert_int_eq(sizeof(read_a), ops[0].result);
+    mu_assert_mem_eq(data + 1000, read_a, sizeof(read_a));
+
+    mu_assert_int_eq(FSE_OK, ops[1].error);
+    mu_assert_int_eq(sizeof(read_b), ops[1].result);
+    mu_assert_mem_eq(data, read_b, sizeof(read_b));
+
+    mu_assert_int_eq(FSE_OK, ops[2].error);
+    mu_assert_int_eq(10, ops[2].result);
+    mu_assert_mem_eq(data + STORAGE_BATCH_TEST_SIZE - 10, read_c, 10);
+
+    mu_assert_int_eq(FSE_OK, ops[3].error);
+    mu_assert_int_eq(STORAGE_BATCH_TEST_SIZE, stat_file.size);
+    mu_check(!file_info_is_dir(&stat_file));
+
+    mu_assert_int_eq(FSE_NOT_EXIST, ops[4].error);
+
+    // batched directory read must match the plain one
+    FileInfo dir_info_plain;
+    char dir_name_plain[64];
+    File* dir_plain = storage_file_alloc(storage);
+    mu_check(storage_dir_open(dir_plain, EXT_PATH("unit_tests")));
+    mu_check(storage_dir_read(dir_plain, &dir_info_plain, dir_name_plain, sizeof(dir_name_plain)));
+    storage_file_free(dir_plain);
+
+    mu_assert_int_eq(FSE_OK, ops[5].error);
+    mu_assert_int_eq(1, ops[5].result);
+    mu_assert_string_eq(dir_name_plain, dir_name);
+    mu_assert_int_eq(dir_info_plain.size, dir_info.size);
+
+    storage_file_free(dir);
+    storage_file_free(file);
+    storage_common_remove(storage, STORAGE_BATCH_TEST_FILE);
+    free(data);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_batch_benchmark) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    uint8_t* data = malloc(STORAGE_BATCH_TEST_SIZE);
+    uint8_t* buffer = malloc(STORAGE_BATCH_BENCH_OPS * STORAGE_BATCH_BENCH_CHUNK);
+    StorageBatchOp* ops = malloc(sizeof(StorageBatchOp) * STORAGE_BATCH_BENCH_OPS);
+    mu_assert(storage_batch_test_file_create(storage, data), "failed to create test file");
+
+    File* file = storage_file_alloc(storage);
+    mu_check(storage_file_open(file, STORAGE_BATCH_TEST_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+
+    // scattered small reads, typical for record lookups in indexed files
+    const size_t stride = STORAGE_BATCH_TEST_SIZE / STORAGE_BATCH_BENCH_OPS;
+
+    uint32_t start = furi_get_tick();
+    for(size_t round = 0; round < STORAGE_BATCH_BENCH_ROUNDS; round++) {
+        for(size_t i = 0; i < STORAGE_BATCH_BENCH_OPS; i++) {
+            uint8_t* chunk = buffer + i * STORAGE_BATCH_BENCH_CHUNK;
+            mu_check(storage_file_seek(file, i * stride, true));
+            mu_assert_int_eq(
+                STORAGE_BATCH_BENCH_CHUNK,
+                storage_file_read(file, chunk, STORAGE_BATCH_BENCH_CHUNK));
+        }
+    }
+    uint32_t single_ticks = furi_get_tick() - start;
+
+    for(size_t i = 0; i < STORAGE_BATCH_BENCH_OPS; i++) {
+        ops[i] = (StorageBatchOp){
+            .type = StorageBatchOpTypeFileRead,
+            .file = file,
+            .offset = i * stride,
+            .buff = buffer + i * STORAGE_BATCH_BENCH_CHUNK,
+            .size = STORAGE_BATCH_BENCH_CHUNK,
+        };
+    }
+
+    start = furi_get_tick();
+    for(size_t round = 0; round < STORAGE_BATCH_BENCH_ROUNDS; round++) {
+        mu_assert_int_eq(
+            STORAGE_BATCH_BENCH_OPS, storage_batch(storage, ops, STORAGE_BATCH_BENCH_OPS));
+    }
+    uint32_t batch_ticks = furi_get_tick() - start;
+
+    for(size_t i = 0; i < STORAGE_BATCH_BENCH_OPS; i++) {
+        mu_assert_mem_eq(
+            data + i * stride, buffer + i * STORAGE_BATCH_BENCH_CHUNK, STORAGE_BATCH_BENCH_CHUNK);
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "%d reads of %d bytes: single %lums, batch %lums",
+        STORAGE_BATCH_BENCH_OPS * STORAGE_BATCH_BENCH_ROUNDS,
+        STORAGE_BATCH_BENCH_CHUNK,
+        single_ticks,
+        batch_ticks);
+
+    storage_file_free(file);
+    storage_common_remove(storage, STORAGE_BATCH_TEST_FILE);
+    free(ops);
+    free(buffer);
+    free(data);
+    furi_record_close(RECORD_STORAGE);
+}
+
+#define STORAGE_ASYNC_TEST_CHUNK (256)
+#define STORAGE_ASYNC_TEST_DEPTH (2)
+
+typedef struct {
+    size_t completed;
+    size_t bytes;
+    FS_Error error;
+} StorageAsyncTestContext;
+
+static void storage_async_test_callback(void* buff, size_t bytes, FS_Error error, void* context) {
+    UNUSED(buff);
+    StorageAsyncTestContext* ctx = context;
+    ctx->completed++;
+    ctx->bytes += bytes;
+    if(error != FSE_OK) ctx->error = error;
+}
+
+MU_TEST(storage_async_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    uint8_t* data = malloc(STORAGE_BATCH_TEST_SIZE);
+    uint8_t* buffer = malloc(STORAGE_BATCH_TEST_SIZE);
+    for(size_t i = 0; i < STORAGE_BATCH_TEST_SIZE; i++) {
+        data[i] = (i % 113);
+    }
+
+    File* file = storage_file_alloc(storage);
+    StorageAsync* async = storage_async_alloc(file, STORAGE_ASYNC_TEST_DEPTH);
+    StorageAsyncTestContext ctx = {0};
+    storage_async_set_callback(async, storage_async_test_callback, &ctx);
+
+    // write in chunks, requests are executed in submission order
+    mu_check(storage_file_open(file, STORAGE_BATCH_TEST_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    for(size_t i = 0; i < STORAGE_BATCH_TEST_SIZE; i += STORAGE_ASYNC_TEST_CHUNK) {
+        mu_check(storage_async_write(async, data + i, STORAGE_ASYNC_TEST_CHUNK, FuriWaitForever));
+        mu_check(storage_async_get_pending(async) <= STORAGE_ASYNC_TEST_DEPTH);
+    }
+    mu_check(storage_async_wait(async, FuriWaitForever));
+    mu_assert_int_eq(0, storage_async_get_pending(async));
+    mu_assert_int_eq(STORAGE_BATCH_TEST_SIZE / STORAGE_ASYNC_TEST_CHUNK, ctx.completed);
+    mu_assert_int_eq(STORAGE_BATCH_TEST_SIZE, ctx.bytes);
+    mu_assert_int_eq(FSE_OK, ctx.error);
+    storage_file_close(file);
+
+    // read back, the last request hits the end of file
+    ctx = (StorageAsyncTestContext){0};
+    mu_check(storage_file_open(file, STORAGE_BATCH_TEST_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+    for(size_t i = 0; i < STORAGE_BATCH_TEST_SIZE; i += STORAGE_ASYNC_TEST_CHUNK) {
+        mu_check(storage_async_read(async, buffer + i, STORAGE_ASYNC_TEST_CHUNK, FuriWaitForever));
+    }
+    uint8_t tail[16];
+    mu_check(storage_async_read(async, tail, sizeof(tail), FuriWaitForever));
+    mu_check(storage_async_wait(async, FuriWaitForever));
+    mu_assert_int_eq(STORAGE_BATCH_TEST_SIZE / STORAGE_ASYNC_TEST_CHUNK + 1, ctx.completed);
+    mu_assert_int_eq(STORAGE_BATCH_TEST_SIZE, ctx.bytes);
+    mu_assert_int_eq(FSE_OK, ctx.error);
+    mu_assert_mem_eq(data, buffer, STORAGE_BATCH_TEST_SIZE);
+
+    storage_async_free(async);
+    storage_file_free(file);
+    storage_common_remove(storage, STORAGE_BATCH_TEST_FILE);
+    free(buffer);
+    free(data);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(storage_batch_suite) {
+    MU_RUN_TEST(storage_file_readv_test);
+    MU_RUN_TEST(storage_batch_test);
+    MU_RUN_TEST(storage_batch_benchmark);
+    MU_RUN_TEST(storage_async_test);
+}
+
 #define MD5_HASH_SIZE (16)
 #include <lib/toolbox/md5_calc.h>
 
@@ -707,6 +1039,7 @@ int run_minunit_test_storage(void) {
     MU_RUN_SUITE(storage_file_64k);
     MU_RUN_SUITE(storage_dir);
     MU_RUN_SUITE(storage_rename);
+    MU_RUN_SUITE(storage_batch_suite);
     MU_RUN_SUITE(test_data_path);
     MU_RUN_SUITE(test_storage_common);
     MU_RUN_SUITE(test_md5_calc_suite);
@@ -518,12 +518,145 @@ MU_TEST(stream_buffered_large_file_test) {
     furi_string_free(output_data);
 }
 
+MU_TEST(stream_buffered_read_ahead_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    // matches the default buffered stream cache size
+    const size_t cache_size = 1024;
+    const size_t data_size = cache_size * 8 + 100;
+    uint8_t* data = malloc(data_size);
+    uint8_t* buf = malloc(data_size);
+    for(size_t i = 0; i < data_size; i++) {
+        data[i] = i % 251;
+    }
+
+    Stream* stream = buffered_file_stream_alloc(storage);
+    mu_check(buffered_file_stream_open(
+        stream, EXT_PATH("filestream.str"), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    mu_assert_int_eq(data_size, stream_write(stream, data, data_size));
+
+    // small sequential reads switch the stream to read-ahead
+    mu_check(stream_rewind(stream));
+    size_t offset = 0;
+    while(offset < cache_size * 4) {
+        mu_assert_int_eq(10, stream_read(stream, buf + offset, 10));
+        offset += 10;
+        mu_assert_int_eq(offset, stream_tell(stream));
+    }
+    mu_assert_mem_eq(data, buf, offset);
+    mu_check(!stream_eof(stream));
+
+    // seeking and writing return the prefetched data to the file
+    mu_check(stream_seek(stream, -15, StreamOffsetFromCurrent));
+    mu_assert_int_eq(offset - 15, stream_tell(stream));
+    mu_assert_int_eq(15, stream_read(stream, buf, 15));
+    mu_assert_mem_eq(data + offset - 15, buf, 15);
+    mu_assert_int_eq(1, stream_write(stream, (uint8_t*)"X", 1));
+    data[offset] = 'X';
+    buf[offset] = 'X';
+    offset += 1;
+
+    // read the rest in uneven pieces
+    while(true) {
+        size_t read = stream_read(stream, buf + offset, 77);
+        if(!read) break;
+        offset += read;
+    }
+    mu_assert_int_eq(data_size, offset);
+    mu_assert_mem_eq(data + cache_size * 4, buf + cache_size * 4, data_size - cache_size * 4);
+    mu_check(stream_eof(stream));
+
+    BufferedFileStreamStats stats;
+    buffered_file_stream_get_stats(stream, &stats);
+    mu_check(stats.hits > 0);
+    mu_check(stats.refills > 0);
+    mu_check(stats.prefetches > 0);
+    mu_check(stats.bytes >= data_size);
+
+    stream_free(stream);
+    free(buf);
+    free(data);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(stream_buffered_write_eof_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    uint8_t data[100];
+    for(size_t i = 0; i < sizeof(data); i++) {
+        data[i] = i;
+    }
+
+    Stream* stream = buffered_file_stream_alloc(storage);
+    mu_check(buffered_file_stream_open(
+        stream, EXT_PATH("filestream.str"), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    mu_assert_int_eq(sizeof(data), stream_write(stream, data, sizeof(data)));
+    mu_check(buffered_file_stream_sync(stream));
+
+    // a pending write in the middle of the file is not the end of it
+    mu_check(stream_seek(stream, 10, StreamOffsetFromStart));
+    mu_assert_int_eq(5, stream_write(stream, (uint8_t*)"ABCDE", 5));
+    mu_assert_int_eq(15, stream_tell(stream));
+    mu_check(!stream_eof(stream));
+
+    // a pending write at the end of the file is
+    mu_check(stream_seek(stream, 95, StreamOffsetFromStart));
+    mu_assert_int_eq(5, stream_write(stream, (uint8_t*)"VWXYZ", 5));
+    mu_check(stream_eof(stream));
+
+    mu_check(stream_seek(stream, 15, StreamOffsetFromStart));
+    mu_check(!stream_eof(stream));
+    uint8_t buf[sizeof(data)];
+    mu_assert_int_eq(80, stream_read(stream, buf, 80));
+    mu_assert_mem_eq(data + 15, buf, 80);
+
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(stream_buffered_write_seek_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    uint8_t data[100];
+    for(size_t i = 0; i < sizeof(data); i++) {
+        data[i] = i;
+    }
+
+    Stream* stream = buffered_file_stream_alloc(storage);
+    mu_check(buffered_file_stream_open(
+        stream, EXT_PATH("filestream.str"), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    mu_assert_int_eq(sizeof(data), stream_write(stream, data, sizeof(data)));
+    mu_check(buffered_file_stream_sync(stream));
+
+    // relative seek while a write is pending must be counted from the write cursor
+    mu_check(stream_seek(stream, 50, StreamOffsetFromStart));
+    mu_assert_int_eq(10, stream_write(stream, (uint8_t*)"0123456789", 10));
+    memcpy(data + 50, "0123456789", 10);
+    mu_assert_int_eq(60, stream_tell(stream));
+    mu_check(stream_seek(stream, -20, StreamOffsetFromCurrent));
+    mu_assert_int_eq(40, stream_tell(stream));
+
+    uint8_t buf[sizeof(data)];
+    mu_assert_int_eq(30, stream_read(stream, buf, 30));
+    mu_assert_mem_eq(data + 40, buf, 30);
+
+    mu_check(stream_rewind(stream));
+    mu_assert_int_eq(sizeof(data), stream_read(stream, buf, sizeof(buf)));
+    mu_assert_mem_eq(data, buf, sizeof(data));
+
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(stream_suite) {
     MU_RUN_TEST(stream_write_read_save_load_test);
     MU_RUN_TEST(stream_composite_test);
     MU_RUN_TEST(stream_split_test);
     MU_RUN_TEST(stream_buffered_write_after_read_test);
     MU_RUN_TEST(stream_buffered_large_file_test);
+    MU_RUN_TEST(stream_buffered_read_ahead_test);
+    MU_RUN_TEST(stream_buffered_write_eof_test);
+    MU_RUN_TEST(stream_buffered_write_seek_test);
 }
 
 int run_minunit_test_stream(void) {
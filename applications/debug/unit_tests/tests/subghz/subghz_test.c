@@ -6,18 +6,22 @@
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
 #include <lib/subghz/protocols/protocol_items.h>
+#include <lib/subghz/protocols/keeloq_common.h>
+#include <lib/subghz/blocks/math.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/subghz/devices/cc1101_configs.h>
 
 #define TAG "SubGhzTest"
 #define KEYSTORE_DIR_NAME EXT_PATH("subghz/assets/keeloq_mfcodes")
+#define KEYSTORE_COMPILED_NAME EXT_PATH("unit_tests/subghz/keeloq_mfcodes_compiled")
 #define CAME_ATOMO_DIR_NAME EXT_PATH("subghz/assets/came_atomo")
 #define NICE_FLOR_S_DIR_NAME EXT_PATH("subghz/assets/nice_flor_s")
 #define ALUTECH_AT_4N_DIR_NAME EXT_PATH("subghz/assets/alutech_at_4n")
 #define TEST_RANDOM_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw.sub")
 #define TEST_RANDOM_COUNT_PARSE 329
 #define TEST_TIMEOUT 10000
+#define TEST_DISPATCH_PULSE_COUNT_MAX 16384
 
 static SubGhzEnvironment* environment_handler;
 static SubGhzReceiver* receiver_handler;
@@ -214,6 +218,60 @@ MU_TEST(subghz_keystore_test) {
         "Test keystore error");
 }
 
+MU_TEST(subghz_keystore_compiled_test) {
+    uint8_t iv[16];
+    for(size_t i = 0; i < sizeof(iv); i++) {
+        iv[i] = i * 0x11;
+    }
+
+    SubGhzKeystore* text = subghz_keystore_alloc();
+    uint32_t text_start = furi_get_tick();
+    mu_assert(subghz_keystore_load(text, KEYSTORE_DIR_NAME), "Test keystore error");
+    uint32_t text_time = furi_get_tick() - text_start;
+    mu_assert(
+        subghz_keystore_save_compiled(text, KEYSTORE_COMPILED_NAME, iv),
+        "Compiled keystore save error");
+
+    SubGhzKeystore* compiled = subghz_keystore_alloc();
+    uint32_t compiled_start = furi_get_tick();
+    mu_assert(subghz_keystore_load(compiled, KEYSTORE_COMPILED_NAME), "Compiled keystore error");
+    uint32_t compiled_time = furi_get_tick() - compiled_start;
+
+    SubGhzKeyArray_t* text_keys = subghz_keystore_get_data(text);
+    SubGhzKeyArray_t* compiled_keys = subghz_keystore_get_data(compiled);
+    size_t key_count = SubGhzKeyArray_size(*text_keys);
+    mu_assert_int_eq(key_count, SubGhzKeyArray_size(*compiled_keys));
+
+    FURI_LOG_I(
+        TAG,
+        "Keystore %zu keys: text %lums, compiled %lums",
+        key_count,
+        text_time,
+        compiled_time);
+
+    for(size_t i = 0; i < key_count; i++) {
+        const SubGhzKey* text_key = SubGhzKeyArray_cget(*text_keys, i);
+        const SubGhzKey* compiled_key = SubGhzKeyArray_cget(*compiled_keys, i);
+        mu_assert_string_eq(text_key->name, compiled_key->name);
+        mu_assert(text_key->key == compiled_key->key, "Key mismatch");
+        mu_assert_int_eq(text_key->type, compiled_key->type);
+
+        // Lookup by name returns the first key with that name
+        const SubGhzKey* found = subghz_keystore_find(compiled, compiled_key->name);
+        mu_assert(found, "Key not found by name");
+        mu_assert_string_eq(compiled_key->name, found->name);
+        mu_assert(found <= compiled_key, "Key found by name is not the first one");
+    }
+    mu_assert(!subghz_keystore_find(compiled, "Not_A_Manufacturer"), "Unexpected key found");
+
+    subghz_keystore_free(compiled);
+    subghz_keystore_free(text);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, KEYSTORE_COMPILED_NAME);
+    furi_record_close(RECORD_STORAGE);
+}
+
 typedef enum {
     SubGhzHalAsyncTxTestTypeNormal,
     SubGhzHalAsyncTxTestTypeInvalidStart,
@@ -830,9 +888,262 @@ MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
 
+static uint16_t subghz_test_dispatch_count = 0;
+
+static void subghz_test_dispatch_decoder_callback(
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(decoder_base);
+    UNUSED(context);
+    subghz_test_dispatch_count++;
+}
+
+static void subghz_test_dispatch_receiver_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(receiver);
+    UNUSED(decoder_base);
+    UNUSED(context);
+    subghz_test_dispatch_count++;
+}
+
+static size_t subghz_test_dispatch_load_pulses(const char* path, LevelDuration* pulses) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+
+    size_t pulse_count = 0;
+    int32_t values[64];
+    if(flipper_format_file_open_existing(flipper_format, path)) {
+        uint32_t value_count = 0;
+        while(pulse_count < TEST_DISPATCH_PULSE_COUNT_MAX &&
+              flipper_format_get_value_count(flipper_format, "RAW_Data", &value_count)) {
+            value_count = MIN(value_count, COUNT_OF(values));
+            if(!flipper_format_read_int32(flipper_format, "RAW_Data", values, value_count)) break;
+            for(size_t i = 0; i < value_count && pulse_count < TEST_DISPATCH_PULSE_COUNT_MAX;
+                i++) {
+                pulses[pulse_count++] = level_duration_make(values[i] > 0, abs(values[i]));
+            }
+        }
+    }
+
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+    return pulse_count;
+}
+
+MU_TEST(subghz_receiver_dispatch_test) {
+    LevelDuration* pulses = malloc(sizeof(LevelDuration) * TEST_DISPATCH_PULSE_COUNT_MAX);
+    size_t pulse_count = subghz_test_dispatch_load_pulses(TEST_RANDOM_DIR_NAME, pulses);
+    mu_assert(pulse_count > 0, "Failed to load RAW pulses");
+
+    // Reference: every decodable decoder is fed every pulse
+    size_t decoder_count = subghz_protocol_registry.size;
+    SubGhzProtocolDecoderBase** decoders =
+        malloc(sizeof(SubGhzProtocolDecoderBase*) * decoder_count);
+    for(size_t i = 0; i < decoder_count; i++) {
+        const SubGhzProtocol* protocol = subghz_protocol_registry.items[i];
+        decoders[i] = NULL;
+        if(protocol->decoder && protocol->decoder->alloc &&
+           (protocol->flag & SubGhzProtocolFlag_Decodable)) {
+            decoders[i] = protocol->decoder->alloc(environment_handler);
+            subghz_protocol_decoder_base_set_decoder_callback(
+                decoders[i], subghz_test_dispatch_decoder_callback, NULL);
+        }
+    }
+
+    subghz_test_dispatch_count = 0;
+    uint32_t reference_start = furi_get_tick();
+    for(size_t i = 0; i < pulse_count; i++) {
+        bool level = level_duration_get_level(pulses[i]);
+        uint32_t duration = level_duration_get_duration(pulses[i]);
+        for(size_t j = 0; j < decoder_count; j++) {
+            if(decoders[j]) decoders[j]->protocol->decoder->feed(decoders[j], level, duration);
+        }
+    }
+    uint32_t reference_time = furi_get_tick() - reference_start;
+    uint16_t reference_count = subghz_test_dispatch_count;
+
+    for(size_t i = 0; i < decoder_count; i++) {
+        if(decoders[i]) decoders[i]->protocol->decoder->free(decoders[i]);
+    }
+    free(decoders);
+
+    // Receiver with dispatch index
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment_handler);
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_rx_callback(receiver, subghz_test_dispatch_receiver_callback, NULL);
+
+    subghz_test_dispatch_count = 0;
+    uint32_t dispatch_start = furi_get_tick();
+    for(size_t i = 0; i < pulse_count; i++) {
+        subghz_receiver_decode(
+            receiver,
+            level_duration_get_level(pulses[i]),
+            level_duration_get_duration(pulses[i]));
+    }
+    uint32_t dispatch_time = furi_get_tick() - dispatch_start;
+    uint16_t dispatch_count = subghz_test_dispatch_count;
+
+    subghz_receiver_free(receiver);
+    free(pulses);
+
+    FURI_LOG_I(
+        TAG,
+        "Dispatch: %zu pulses, reference %lums (%lu pulses/s), indexed %lums (%lu pulses/s)",
+        pulse_count,
+        reference_time,
+        reference_time ? (uint32_t)(pulse_count * 1000 / reference_time) : 0,
+        dispatch_time,
+        dispatch_time ? (uint32_t)(pulse_count * 1000 / dispatch_time) : 0);
+
+    mu_assert_int_eq(reference_count, dispatch_count);
+}
+
+#define TEST_KEELOQ_MULTI_ROUNDS 64
+
+MU_TEST(subghz_keeloq_decrypt_multi_test) {
+    uint64_t keys[KEELOQ_MULTI_KEY_COUNT];
+    uint32_t multi[KEELOQ_MULTI_KEY_COUNT];
+    uint32_t data = 0x2F13A5C7;
+    uint64_t seed = 0x0123456789ABCDEFULL;
+
+    // Every batch size against the scalar path
+    for(size_t count = 0; count <= KEELOQ_MULTI_KEY_COUNT; count++) {
+        for(size_t i = 0; i < count; i++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            keys[i] = seed;
+        }
+        data = data * 1664525 + 1013904223;
+        subghz_protocol_keeloq_common_decrypt_multi(data, keys, count, multi);
+        for(size_t i = 0; i < count; i++) {
+            mu_assert_int_eq(subghz_protocol_keeloq_common_decrypt(data, keys[i]), multi[i]);
+        }
+    }
+
+    // Throughput, same work for both paths
+    volatile uint32_t sink = 0;
+    uint32_t scalar_start = furi_get_tick();
+    for(size_t round = 0; round < TEST_KEELOQ_MULTI_ROUNDS; round++) {
+        for(size_t i = 0; i < KEELOQ_MULTI_KEY_COUNT; i++) {
+            sink ^= subghz_protocol_keeloq_common_decrypt(data + round, keys[i]);
+        }
+    }
+    uint32_t scalar_time = furi_get_tick() - scalar_start;
+
+    uint32_t multi_start = furi_get_tick();
+    for(size_t round = 0; round < TEST_KEELOQ_MULTI_ROUNDS; round++) {
+        subghz_protocol_keeloq_common_decrypt_multi(
+            data + round, keys, KEELOQ_MULTI_KEY_COUNT, multi);
+        sink ^= multi[0];
+    }
+    uint32_t multi_time = furi_get_tick() - multi_start;
+
+    uint32_t decrypt_count = TEST_KEELOQ_MULTI_ROUNDS * KEELOQ_MULTI_KEY_COUNT;
+    FURI_LOG_I(
+        TAG,
+        "KeeLoq %lu decrypts: scalar %lums (%lu/s), multi %lums (%lu/s)",
+        decrypt_count,
+        scalar_time,
+        scalar_time ? decrypt_count * 1000 / scalar_time : 0,
+        multi_time,
+        multi_time ? decrypt_count * 1000 / multi_time : 0);
+}
+
+#define TEST_KEELOQ_KEYSTORE_SIZE 2000
+#define TEST_KEELOQ_KEYSTORE_NAME_SIZE 16
+
+MU_TEST(subghz_keeloq_keystore_search_test) {
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+    SubGhzKeystore* keystore = subghz_environment_get_keystore(environment);
+    SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+
+    // Synthetic keystore, the matching key is the last one
+    char* names = malloc(TEST_KEELOQ_KEYSTORE_SIZE * TEST_KEELOQ_KEYSTORE_NAME_SIZE);
+    for(size_t i = 0; i < TEST_KEELOQ_KEYSTORE_SIZE; i++) {
+        SubGhzKey* key = SubGhzKeyArray_push_raw(*keys);
+        uint64_t value = 0x9E3779B97F4A7C15ULL * (i + 1);
+        char* name = &names[i * TEST_KEELOQ_KEYSTORE_NAME_SIZE];
+        snprintf(name, TEST_KEELOQ_KEYSTORE_NAME_SIZE, "Synthetic_%04zu", i);
+        key->name = name;
+        key->key = value ^ (value >> 29);
+        key->type = KEELOQ_LEARNING_SIMPLE;
+    }
+    const uint64_t target_key = 0x5A4D3C2B1A090807ULL;
+    SubGhzKey* key = SubGhzKeyArray_push_raw(*keys);
+    key->name = "Synthetic_Target";
+    key->key = target_key;
+    key->type = KEELOQ_LEARNING_SIMPLE;
+
+    const uint32_t serial = 0x0A5C3E1;
+    const uint32_t btn = 0x2;
+    const uint32_t cnt = 0x0123;
+    uint32_t fix = btn << 28 | serial;
+    uint32_t hop = subghz_protocol_keeloq_common_encrypt(
+        btn << 28 | (serial & 0x3FF) << 16 | cnt, target_key);
+    uint64_t data = subghz_protocol_blocks_reverse_key((uint64_t)fix << 32 | hop, 64);
+
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    uint32_t bit = 64;
+    uint8_t key_data[sizeof(uint64_t)];
+    for(size_t i = 0; i < sizeof(uint64_t); i++) {
+        key_data[i] = data >> (56 - i * 8);
+    }
+    flipper_format_write_uint32(flipper_format, "Bit", &bit, 1);
+    flipper_format_write_hex(flipper_format, "Key", key_data, sizeof(uint64_t));
+
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+    SubGhzProtocolDecoderBase* decoder =
+        subghz_receiver_search_decoder_base_by_name(receiver, SUBGHZ_PROTOCOL_KEELOQ_NAME);
+    mu_assert(decoder, "KeeLoq decoder not found");
+    mu_assert(
+        subghz_protocol_decoder_base_deserialize(decoder, flipper_format) ==
+            SubGhzProtocolStatusOk,
+        "KeeLoq deserialize error");
+
+    FuriString* scan_output = furi_string_alloc();
+    FuriString* hint_output = furi_string_alloc();
+
+    // First lookup walks the whole keystore
+    subghz_environment_reset_keeloq(environment);
+    uint32_t scan_start = furi_get_tick();
+    subghz_protocol_decoder_base_get_string(decoder, scan_output);
+    uint32_t scan_time = furi_get_tick() - scan_start;
+
+    // Repeated lookup of the same remote goes straight to the remembered key
+    subghz_environment_reset_keeloq(environment);
+    uint32_t hint_start = furi_get_tick();
+    subghz_protocol_decoder_base_get_string(decoder, hint_output);
+    uint32_t hint_time = furi_get_tick() - hint_start;
+
+    FURI_LOG_I(
+        TAG,
+        "KeeLoq keystore %d keys: full scan %lums, remembered key %lums",
+        TEST_KEELOQ_KEYSTORE_SIZE + 1,
+        scan_time,
+        hint_time);
+
+    mu_assert(
+        furi_string_search_str(scan_output, "MF:Synthetic_Target") != FURI_STRING_FAILURE,
+        "Full scan found wrong key");
+    mu_assert(
+        furi_string_search_str(scan_output, "Cnt:0123") != FURI_STRING_FAILURE,
+        "Full scan decrypted wrong counter");
+    mu_assert(furi_string_equal(scan_output, hint_output), "Remembered key lookup mismatch");
+
+    furi_string_free(hint_output);
+    furi_string_free(scan_output);
+    subghz_receiver_free(receiver);
+    flipper_format_free(flipper_format);
+    subghz_environment_free(environment);
+    free(names);
+}
+
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
+    MU_RUN_TEST(subghz_keystore_compiled_test);
 
     MU_RUN_TEST(subghz_hal_async_tx_test);
 
@@ -907,6 +1218,9 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_decoder_acurite_592txr_test);
 
     MU_RUN_TEST(subghz_random_test);
+    MU_RUN_TEST(subghz_receiver_dispatch_test);
+    MU_RUN_TEST(subghz_keeloq_decrypt_multi_test);
+    MU_RUN_TEST(subghz_keeloq_keystore_search_test);
     subghz_test_deinit();
 }
 
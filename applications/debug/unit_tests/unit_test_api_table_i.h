@@ -1,10 +1,14 @@
 #include <update_util/resources/manifest.h>
 #include <nfc/protocols/slix/slix_i.h>
 #include <nfc/protocols/iso15693_3/iso15693_3_poller_i.h>
+#include <subghz/subghz_keystore.h>
+#include <subghz/protocols/keeloq_common.h>
 #include <FreeRTOS.h>
 #include <FreeRTOS-Kernel/include/queue.h>
 
 #include <rpc/rpc_i.h>
+#include <gui/canvas_i.h>
+#include <u8g2_glue.h>
 #include <flipper.pb.h>
 
 static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
@@ -16,6 +20,16 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(slix_process_iso15693_3_error, SlixError, (Iso15693_3Error)),
     API_METHOD(iso15693_3_poller_get_data, const Iso15693_3Data*, (Iso15693_3Poller*)),
     API_METHOD(rpc_system_storage_get_error, PB_CommandStatus, (FS_Error)),
+    API_METHOD(subghz_keystore_alloc, SubGhzKeystore*, (void)),
+    API_METHOD(subghz_keystore_free, void, (SubGhzKeystore*)),
+    API_METHOD(subghz_keystore_get_data, SubGhzKeyArray_t*, (SubGhzKeystore*)),
+    API_METHOD(subghz_keystore_find, const SubGhzKey*, (SubGhzKeystore*, const char*)),
+    API_METHOD(subghz_protocol_keeloq_common_encrypt, uint32_t, (const uint32_t, const uint64_t)),
+    API_METHOD(subghz_protocol_keeloq_common_decrypt, uint32_t, (const uint32_t, const uint64_t)),
+    API_METHOD(
+        subghz_protocol_keeloq_common_decrypt_multi,
+        void,
+        (const uint32_t, const uint64_t*, size_t, uint32_t*)),
     API_METHOD(xQueueSemaphoreTake, BaseType_t, (QueueHandle_t, TickType_t)),
     API_METHOD(vQueueDelete, void, (QueueHandle_t)),
     API_METHOD(
@@ -26,4 +40,34 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
         xQueueGenericSend,
         BaseType_t,
         (QueueHandle_t, const void* const, TickType_t, const BaseType_t)),
+    API_METHOD(
+        canvas_draw_u8g2_bitmap,
+        void,
+        (u8g2_t*, int32_t, int32_t, size_t, size_t, const uint8_t*, IconRotation)),
+    API_METHOD(
+        u8g2_Setup_st756x_flipper,
+        void,
+        (u8g2_t*, const u8g2_cb_t*, u8x8_msg_cb, u8x8_msg_cb)),
+    API_METHOD(
+        u8g2_SetupBuffer,
+        void,
+        (u8g2_t*, uint8_t*, uint8_t, u8g2_draw_ll_hvline_cb, const u8g2_cb_t*)),
+    API_METHOD(
+        u8g2_ll_hvline_vertical_top_lsb,
+        void,
+        (u8g2_t*, u8g2_uint_t, u8g2_uint_t, u8g2_uint_t, uint8_t)),
+    API_METHOD(u8x8_dummy_cb, uint8_t, (u8x8_t*, uint8_t, uint8_t, void*)),
+    API_METHOD(u8g2_DrawPixel, void, (u8g2_t*, u8g2_uint_t, u8g2_uint_t)),
+    API_METHOD(u8g2_SetDrawColor, void, (u8g2_t*, uint8_t)),
+    API_METHOD(u8g2_SetBitmapMode, void, (u8g2_t*, uint8_t)),
+    API_METHOD(
+        u8g2_IsIntersection,
+        uint8_t,
+        (u8g2_t*, u8g2_uint_t, u8g2_uint_t, u8g2_uint_t, u8g2_uint_t)),
+    API_METHOD(
+        u8g2_SetClipWindow,
+        void,
+        (u8g2_t*, u8g2_uint_t, u8g2_uint_t, u8g2_uint_t, u8g2_uint_t)),
+    API_METHOD(u8g2_SetMaxClipWindow, void, (u8g2_t*)),
+    API_VARIABLE(u8g2_cb_r0, const u8g2_cb_t),
     API_VARIABLE(PB_Main_msg, PB_Main_msg_t)));
@@ -3,7 +3,7 @@
 
 #include <inttypes.h>
 #include "crypto1.h"
-#include "mfkey.h"
+#include "mfkey_recovery.h"
 
 #define BIT(x, n) ((x) >> (n) & 1)
 
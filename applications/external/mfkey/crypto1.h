@@ -2,8 +2,7 @@
 #define CRYPTO1_H
 
 #include <inttypes.h>
-#include "mfkey.h"
-#include <nfc/protocols/mf_classic/mf_classic.h>
+#include "mfkey_recovery.h"
 
 #define LF_POLY_ODD (0x29CE5C)
 #define LF_POLY_EVEN (0x870804)
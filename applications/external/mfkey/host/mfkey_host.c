@@ -0,0 +1,506 @@
+// Host build of the Mfkey32/static nested key recovery.
+// Recovers keys from nonces exported from the Flipper (.mfkey32.log, .nonces),
+// spreading the search of every nonce over worker threads with work stealing.
+
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "mfkey_recovery.h"
+#include "crypto1.h"
+
+// Semi states per collect task
+#define MFKEY_HOST_SLICE_SIZE (4096)
+#define MFKEY_HOST_SLICE_COUNT (MFKEY_RECOVERY_SEMI_STATE_MAX / MFKEY_HOST_SLICE_SIZE + 1)
+#define MFKEY_HOST_THREADS_MAX (256)
+
+typedef struct {
+    pthread_mutex_t mutex;
+    size_t head;
+    size_t tail;
+} MfkeyHostQueue;
+
+typedef struct MfkeyHostPool MfkeyHostPool;
+typedef void (*MfkeyHostTask)(MfkeyHostPool* pool, size_t worker, size_t task);
+
+// Every worker owns a range of tasks, idle workers steal half of the largest remaining range
+struct MfkeyHostPool {
+    size_t workers;
+    MfkeyHostQueue* queues;
+    MfkeyHostTask task;
+    void* context;
+    atomic_bool stop;
+};
+
+typedef struct {
+    MfkeyHostPool* pool;
+    size_t worker;
+} MfkeyHostWorker;
+
+typedef struct {
+    MfClassicNonce nonce;
+    MfkeyRecoveryKeystream ks;
+    // Per worker buckets for the collect stage
+    struct Msb** odd_local;
+    struct Msb** even_local;
+    unsigned int** states_buffers;
+    // Merged buckets for the solve stage
+    struct Msb* odd_msbs;
+    struct Msb* even_msbs;
+    unsigned int** temp_odd;
+    unsigned int** temp_even;
+    pthread_mutex_t found_mutex;
+    bool found;
+    MfClassicKey key;
+} MfkeyHostSearch;
+
+static bool mfkey_host_queue_take(MfkeyHostQueue* queue, size_t* task) {
+    bool taken = false;
+    pthread_mutex_lock(&queue->mutex);
+    if(queue->head < queue->tail) {
+        *task = queue->head++;
+        taken = true;
+    }
+    pthread_mutex_unlock(&queue->mutex);
+    return taken;
+}
+
+static bool mfkey_host_queue_steal(MfkeyHostPool* pool, size_t worker, size_t* task) {
+    for(size_t i = 1; i < pool->workers; i++) {
+        MfkeyHostQueue* victim = &pool->queues[(worker + i) % pool->workers];
+        size_t head = 0, tail = 0;
+
+        pthread_mutex_lock(&victim->mutex);
+        size_t remaining = victim->tail - victim->head;
+        if(remaining > 0) {
+            tail = victim->tail;
+            head = tail - (remaining + 1) / 2;
+            victim->tail = head;
+        }
+        pthread_mutex_unlock(&victim->mutex);
+
+        if(head < tail) {
+            MfkeyHostQueue* own = &pool->queues[worker];
+            pthread_mutex_lock(&own->mutex);
+            own->head = head + 1;
+            own->tail = tail;
+            pthread_mutex_unlock(&own->mutex);
+            *task = head;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void* mfkey_host_worker(void* arg) {
+    MfkeyHostWorker* worker = arg;
+    MfkeyHostPool* pool = worker->pool;
+    size_t task;
+
+    while(!atomic_load(&pool->stop)) {
+        if(!mfkey_host_queue_take(&pool->queues[worker->worker], &task) &&
+           !mfkey_host_queue_steal(pool, worker->worker, &task)) {
+            break;
+        }
+        pool->task(pool, worker->worker, task);
+    }
+
+    return NULL;
+}
+
+static void mfkey_host_pool_run(
+    size_t workers,
+    size_t task_count,
+    MfkeyHostTask task,
+    void* context) {
+    MfkeyHostPool pool = {
+        .workers = workers,
+        .queues = calloc(workers, sizeof(MfkeyHostQueue)),
+        .task = task,
+        .context = context,
+    };
+    atomic_init(&pool.stop, false);
+    pthread_t* threads = calloc(workers, sizeof(pthread_t));
+    MfkeyHostWorker* args = calloc(workers, sizeof(MfkeyHostWorker));
+
+    for(size_t i = 0; i < workers; i++) {
+        pthread_mutex_init(&pool.queues[i].mutex, NULL);
+        pool.queues[i].head = task_count * i / workers;
+        pool.queues[i].tail = task_count * (i + 1) / workers;
+    }
+
+    for(size_t i = 0; i < workers; i++) {
+        args[i].pool = &pool;
+        args[i].worker = i;
+        pthread_create(&threads[i], NULL, mfkey_host_worker, &args[i]);
+    }
+
+    for(size_t i = 0; i < workers; i++) {
+        pthread_join(threads[i], NULL);
+        pthread_mutex_destroy(&pool.queues[i].mutex);
+    }
+
+    free(args);
+    free(threads);
+    free(pool.queues);
+}
+
+static bool mfkey_host_cancel_callback(void* context) {
+    MfkeyHostPool* pool = context;
+    return atomic_load(&pool->stop);
+}
+
+static void mfkey_host_collect_task(MfkeyHostPool* pool, size_t worker, size_t task) {
+    MfkeyHostSearch* search = pool->context;
+    int from = MFKEY_RECOVERY_SEMI_STATE_MAX - (int)(task * MFKEY_HOST_SLICE_SIZE);
+    int to = from - MFKEY_HOST_SLICE_SIZE + 1;
+    if(to < 0) to = 0;
+
+    mfkey_recovery_collect(
+        &search->ks,
+        from,
+        to,
+        0,
+        MFKEY_RECOVERY_MSB_COUNT,
+        search->states_buffers[worker],
+        search->odd_local[worker],
+        search->even_local[worker],
+        mfkey_host_cancel_callback,
+        pool);
+}
+
+static void mfkey_host_solve_task(MfkeyHostPool* pool, size_t worker, size_t task) {
+    MfkeyHostSearch* search = pool->context;
+    MfClassicNonce nonce = search->nonce;
+
+    if(mfkey_recovery_solve(
+           &search->ks,
+           &nonce,
+           &search->odd_msbs[task],
+           &search->even_msbs[task],
+           search->temp_odd[worker],
+           search->temp_even[worker])) {
+        pthread_mutex_lock(&search->found_mutex);
+        if(!search->found) {
+            search->found = true;
+            search->key = nonce.key;
+        }
+        pthread_mutex_unlock(&search->found_mutex);
+        atomic_store(&pool->stop, true);
+    }
+}
+
+static MfkeyHostSearch* mfkey_host_search_alloc(size_t workers) {
+    MfkeyHostSearch* search = calloc(1, sizeof(MfkeyHostSearch));
+    search->odd_local = calloc(workers, sizeof(struct Msb*));
+    search->even_local = calloc(workers, sizeof(struct Msb*));
+    search->states_buffers = calloc(workers, sizeof(unsigned int*));
+    search->temp_odd = calloc(workers, sizeof(unsigned int*));
+    search->temp_even = calloc(workers, sizeof(unsigned int*));
+    for(size_t i = 0; i < workers; i++) {
+        search->odd_local[i] = malloc(MFKEY_RECOVERY_MSB_COUNT * sizeof(struct Msb));
+        search->even_local[i] = malloc(MFKEY_RECOVERY_MSB_COUNT * sizeof(struct Msb));
+        search->states_buffers[i] = malloc(MFKEY_RECOVERY_STATES_BUFFER * sizeof(unsigned int));
+        search->temp_odd[i] = malloc(MFKEY_RECOVERY_TEMP_STATES * sizeof(unsigned int));
+        search->temp_even[i] = malloc(MFKEY_RECOVERY_TEMP_STATES * sizeof(unsigned int));
+    }
+    search->odd_msbs = malloc(MFKEY_RECOVERY_MSB_COUNT * sizeof(struct Msb));
+    search->even_msbs = malloc(MFKEY_RECOVERY_MSB_COUNT * sizeof(struct Msb));
+    pthread_mutex_init(&search->found_mutex, NULL);
+    return search;
+}
+
+static void mfkey_host_search_free(MfkeyHostSearch* search, size_t workers) {
+    for(size_t i = 0; i < workers; i++) {
+        free(search->odd_local[i]);
+        free(search->even_local[i]);
+        free(search->states_buffers[i]);
+        free(search->temp_odd[i]);
+        free(search->temp_even[i]);
+    }
+    free(search->odd_local);
+    free(search->even_local);
+    free(search->states_buffers);
+    free(search->temp_odd);
+    free(search->temp_even);
+    free(search->odd_msbs);
+    free(search->even_msbs);
+    pthread_mutex_destroy(&search->found_mutex);
+    free(search);
+}
+
+static bool mfkey_host_recover(MfkeyHostSearch* search, size_t workers, MfClassicNonce* nonce) {
+    search->nonce = *nonce;
+    search->found = false;
+    mfkey_recovery_nonce_keystream(&search->ks, nonce);
+
+    for(size_t i = 0; i < workers; i++) {
+        memset(search->odd_local[i], 0, MFKEY_RECOVERY_MSB_COUNT * sizeof(struct Msb));
+        memset(search->even_local[i], 0, MFKEY_RECOVERY_MSB_COUNT * sizeof(struct Msb));
+    }
+    mfkey_host_pool_run(workers, MFKEY_HOST_SLICE_COUNT, mfkey_host_collect_task, search);
+
+    memset(search->odd_msbs, 0, MFKEY_RECOVERY_MSB_COUNT * sizeof(struct Msb));
+    memset(search->even_msbs, 0, MFKEY_RECOVERY_MSB_COUNT * sizeof(struct Msb));
+    for(size_t i = 0; i < workers; i++) {
+        for(size_t msb = 0; msb < MFKEY_RECOVERY_MSB_COUNT; msb++) {
+            mfkey_recovery_merge(&search->odd_msbs[msb], &search->odd_local[i][msb]);
+            mfkey_recovery_merge(&search->even_msbs[msb], &search->even_local[i][msb]);
+        }
+    }
+
+    mfkey_host_pool_run(workers, MFKEY_RECOVERY_MSB_COUNT, mfkey_host_solve_task, search);
+
+    if(search->found) {
+        nonce->key = search->key;
+    }
+    return search->found;
+}
+
+static struct Crypto1State mfkey_host_key_state(uint64_t key) {
+    struct Crypto1State state = {0, 0};
+    for(int i = 0; i < 24; i++) {
+        state.odd |= (BIT(key, 2 * i + 1) << (i ^ 3));
+        state.even |= (BIT(key, 2 * i) << (i ^ 3));
+    }
+    return state;
+}
+
+static uint64_t mfkey_host_key_to_num(const MfClassicKey* key) {
+    uint64_t value = 0;
+    for(size_t i = 0; i < MF_CLASSIC_KEY_SIZE; i++) {
+        value = value << 8 | key->data[i];
+    }
+    return value;
+}
+
+static bool mfkey_host_key_matches(uint64_t key, const MfClassicNonce* nonce) {
+    struct Crypto1State state = mfkey_host_key_state(key);
+    if(nonce->attack == mfkey32) {
+        crypt_word_noret(&state, nonce->uid_xor_nt1, 0);
+        crypt_word_noret(&state, nonce->nr1_enc, 1);
+        return nonce->ar1_enc == (crypt_word(&state) ^ nonce->p64b);
+    }
+    return nonce->ks1_1_enc == crypt_word_ret(&state, nonce->uid_xor_nt0, 0);
+}
+
+static size_t mfkey_host_load(const char* path, MfClassicNonce** nonces) {
+    FILE* file = fopen(path, "r");
+    if(!file) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return 0;
+    }
+
+    size_t count = 0, capacity = 0;
+    char line[256];
+    while(fgets(line, sizeof(line), file)) {
+        MfClassicNonce res = {0};
+        if(sscanf(
+               line,
+               "Sec %*d key %*c cuid %" SCNx32 " nt0 %" SCNx32 " nr0 %" SCNx32 " ar0 %" SCNx32
+               " nt1 %" SCNx32 " nr1 %" SCNx32 " ar1 %" SCNx32,
+               &res.uid,
+               &res.nt0,
+               &res.nr0_enc,
+               &res.ar0_enc,
+               &res.nt1,
+               &res.nr1_enc,
+               &res.ar1_enc) == 7) {
+            res.attack = mfkey32;
+            res.p64 = prng_successor(res.nt0, 64);
+            res.p64b = prng_successor(res.nt1, 64);
+        } else if(
+            sscanf(
+                line,
+                "Nested: %*s %*s cuid 0x%" SCNx32 " nt0 0x%" SCNx32 " ks0 0x%" SCNx32
+                " par0 %4[01] nt1 0x%" SCNx32 " ks1 0x%" SCNx32 " par1 %4[01]",
+                &res.uid,
+                &res.nt0,
+                &res.ks1_1_enc,
+                res.par_1_str,
+                &res.nt1,
+                &res.ks1_2_enc,
+                res.par_2_str) == 7) {
+            res.attack = static_nested;
+        } else {
+            continue;
+        }
+        res.uid_xor_nt0 = res.uid ^ res.nt0;
+        res.uid_xor_nt1 = res.uid ^ res.nt1;
+
+        if(count == capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            *nonces = realloc(*nonces, capacity * sizeof(MfClassicNonce));
+        }
+        (*nonces)[count++] = res;
+    }
+
+    fclose(file);
+    return count;
+}
+
+// Simulate Mfkey32 reader authentications with a known key
+static void mfkey_host_generate(size_t count, uint32_t seed) {
+    srand(seed);
+    for(size_t i = 0; i < count; i++) {
+        uint64_t key = 0;
+        for(int j = 0; j < MF_CLASSIC_KEY_SIZE; j++) {
+            key = key << 8 | (rand() & 0xff);
+        }
+        uint32_t uid = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        uint32_t nt[2], nr_enc[2], ar_enc[2];
+
+        for(int j = 0; j < 2; j++) {
+            struct Crypto1State state = mfkey_host_key_state(key);
+            uint32_t nr = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+            nt[j] = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+
+            crypt_word_noret(&state, uid ^ nt[j], 0);
+            nr_enc[j] = nr ^ crypt_word_ret(&state, nr, 0);
+            ar_enc[j] = crypt_word(&state) ^ prng_successor(nt[j], 64);
+        }
+
+        printf(
+            "Sec %zu key A cuid %08" PRIx32 " nt0 %08" PRIx32 " nr0 %08" PRIx32 " ar0 %08" PRIx32
+            " nt1 %08" PRIx32 " nr1 %08" PRIx32 " ar1 %08" PRIx32 "\n",
+            i,
+            uid,
+            nt[0],
+            nr_enc[0],
+            ar_enc[0],
+            nt[1],
+            nr_enc[1],
+            ar_enc[1]);
+        fprintf(stderr, "Sec %zu key %012" PRIX64 "\n", i, key);
+    }
+}
+
+static double mfkey_host_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void mfkey_host_usage(const char* name) {
+    fprintf(
+        stderr,
+        "Usage: %s [-t threads] [-b] nonces.log...\n"
+        "       %s -g count [-s seed]\n"
+        "  -t  worker threads, default is the number of CPUs\n"
+        "  -b  benchmark, do not skip nonces solved by already found keys\n"
+        "  -g  print count simulated Mfkey32 nonces, keys go to stderr\n",
+        name,
+        name);
+}
+
+int main(int argc, char** argv) {
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    bool benchmark = false;
+    long generate = 0;
+    uint32_t seed = 1;
+    int opt;
+
+    while((opt = getopt(argc, argv, "t:bg:s:h")) != -1) {
+        switch(opt) {
+        case 't':
+            threads = strtol(optarg, NULL, 0);
+            break;
+        case 'b':
+            benchmark = true;
+            break;
+        case 'g':
+            generate = strtol(optarg, NULL, 0);
+            break;
+        case 's':
+            seed = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            mfkey_host_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(generate > 0) {
+        mfkey_host_generate(generate, seed);
+        return 0;
+    }
+
+    if(optind >= argc || threads < 1 || threads > MFKEY_HOST_THREADS_MAX) {
+        mfkey_host_usage(argv[0]);
+        return 1;
+    }
+
+    MfClassicNonce* nonces = NULL;
+    size_t nonce_count = 0;
+    for(int i = optind; i < argc; i++) {
+        MfClassicNonce* file_nonces = NULL;
+        size_t file_count = mfkey_host_load(argv[i], &file_nonces);
+        nonces = realloc(nonces, (nonce_count + file_count + 1) * sizeof(MfClassicNonce));
+        memcpy(&nonces[nonce_count], file_nonces, file_count * sizeof(MfClassicNonce));
+        nonce_count += file_count;
+        free(file_nonces);
+    }
+
+    uint64_t* keys = calloc(nonce_count + 1, sizeof(uint64_t));
+    size_t key_count = 0, recovered = 0, searched = 0;
+    MfkeyHostSearch* search = mfkey_host_search_alloc(threads);
+    double start = mfkey_host_time();
+
+    for(size_t i = 0; i < nonce_count; i++) {
+        MfClassicNonce* nonce = &nonces[i];
+        bool known = false;
+        for(size_t k = 0; !benchmark && k < key_count; k++) {
+            if(mfkey_host_key_matches(keys[k], nonce)) {
+                known = true;
+                break;
+            }
+        }
+        if(known) {
+            recovered++;
+            continue;
+        }
+
+        double nonce_start = mfkey_host_time();
+        searched++;
+        if(!mfkey_host_recover(search, threads, nonce)) {
+            printf("%08" PRIx32 ": key not found\n", nonce->uid);
+            continue;
+        }
+        recovered++;
+
+        uint64_t key = mfkey_host_key_to_num(&nonce->key);
+        printf(
+            "%08" PRIx32 ": %012" PRIX64 " (%.2fs)\n",
+            nonce->uid,
+            key,
+            mfkey_host_time() - nonce_start);
+
+        bool unique = true;
+        for(size_t k = 0; k < key_count; k++) {
+            if(keys[k] == key) unique = false;
+        }
+        if(unique) keys[key_count++] = key;
+    }
+
+    double elapsed = mfkey_host_time() - start;
+    printf(
+        "%zu/%zu nonces, %zu unique keys, %zu searched in %.2fs with %ld threads: %.3f keys/s\n",
+        recovered,
+        nonce_count,
+        key_count,
+        searched,
+        elapsed,
+        threads,
+        elapsed > 0 ? searched / elapsed : 0);
+
+    mfkey_host_search_free(search, threads);
+    free(keys);
+    free(nonces);
+    return recovered == nonce_count ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+#ifndef MFKEY_RECOVERY_H
+#define MFKEY_RECOVERY_H
+
+// Portable Mfkey32/static nested key recovery core, no firmware dependencies.
+// Define MFKEY_HOST to build it outside of the firmware.
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#ifdef MFKEY_HOST
+#define MF_CLASSIC_KEY_SIZE (6)
+typedef struct {
+    uint8_t data[MF_CLASSIC_KEY_SIZE];
+} MfClassicKey;
+#else
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#endif
+
+// Number of MSB buckets in the state space
+#define MFKEY_RECOVERY_MSB_COUNT (256)
+// Semi states are scanned from MFKEY_RECOVERY_SEMI_STATE_MAX down to 0
+#define MFKEY_RECOVERY_SEMI_STATE_MAX (1 << 20)
+// Size of the per-bucket work buffers passed to mfkey_recovery_solve()
+#define MFKEY_RECOVERY_TEMP_STATES (1280)
+// Size of the states buffer passed to mfkey_recovery_collect()
+#define MFKEY_RECOVERY_STATES_BUFFER (1024)
+
+struct Crypto1State {
+    uint32_t odd, even;
+};
+struct Msb {
+    int tail;
+    uint32_t states[768];
+};
+
+typedef enum { mfkey32, static_nested } AttackType;
+
+typedef struct {
+    AttackType attack;
+    MfClassicKey key; // key
+    uint32_t uid; // serial number
+    uint32_t nt0; // tag challenge first
+    uint32_t nt1; // tag challenge second
+    uint32_t uid_xor_nt0; // uid ^ nt0
+    uint32_t uid_xor_nt1; // uid ^ nt1
+    union {
+        // Mfkey32
+        struct {
+            uint32_t p64; // 64th successor of nt0
+            uint32_t p64b; // 64th successor of nt1
+            uint32_t nr0_enc; // first encrypted reader challenge
+            uint32_t ar0_enc; // first encrypted reader response
+            uint32_t nr1_enc; // second encrypted reader challenge
+            uint32_t ar1_enc; // second encrypted reader response
+        };
+        // Nested
+        struct {
+            uint32_t ks1_1_enc; // first encrypted keystream
+            uint32_t ks1_2_enc; // second encrypted keystream
+            char par_1_str[5]; // first parity bits (string representation)
+            char par_2_str[5]; // second parity bits (string representation)
+            uint8_t par_1; // first parity bits
+            uint8_t par_2; // second parity bits
+        };
+    };
+} MfClassicNonce;
+
+// Keystream split into odd/even halves, shared by all the search steps of one nonce
+typedef struct {
+    int oks;
+    int eks;
+    unsigned int in;
+} MfkeyRecoveryKeystream;
+
+// Called periodically from long loops, return true to abort the search
+typedef bool (*MfkeyRecoveryCancelCallback)(void* context);
+
+// Prepare the keystream for a nonce, see mfkey_recovery_nonce_keystream()
+void mfkey_recovery_keystream_init(MfkeyRecoveryKeystream* ks, int ks2, unsigned int in);
+
+// Prepare the keystream for the nonce attack type
+void mfkey_recovery_nonce_keystream(MfkeyRecoveryKeystream* ks, const MfClassicNonce* n);
+
+// Collect the odd and even states whose MSB falls in [msb_head, msb_head + msb_count)
+// for semi states from semi_state_from down to semi_state_to (inclusive).
+// odd_msbs and even_msbs hold msb_count buckets and must be zeroed before the first call.
+// Returns false if cancelled.
+bool mfkey_recovery_collect(
+    const MfkeyRecoveryKeystream* ks,
+    int semi_state_from,
+    int semi_state_to,
+    unsigned int msb_head,
+    unsigned int msb_count,
+    unsigned int* states_buffer,
+    struct Msb* odd_msbs,
+    struct Msb* even_msbs,
+    MfkeyRecoveryCancelCallback cancel,
+    void* context);
+
+// Merge bucket src into dst, skipping states that are already there
+void mfkey_recovery_merge(struct Msb* dst, const struct Msb* src);
+
+// Search one MSB bucket for the key, fills n->key on success
+bool mfkey_recovery_solve(
+    const MfkeyRecoveryKeystream* ks,
+    MfClassicNonce* n,
+    const struct Msb* odd_msb,
+    const struct Msb* even_msb,
+    unsigned int* temp_states_odd,
+    unsigned int* temp_states_even);
+
+#endif // MFKEY_RECOVERY_H
@@ -38,7 +38,7 @@ static Iso14443_4aError tullave_iso14443_4a_send_apdu(TuLlavePoller* poller) {
     FuriString* tx_log = furi_string_alloc_set_str("TX: ");
     tullave_data_format_bytes(
         tx_log, bit_buffer_get_data(poller->tx_data), bit_buffer_get_size(poller->tx_data));
-    FURI_LOG_D(LOG_TAG, furi_string_get_cstr(tx_log));
+    FURI_LOG_D(LOG_TAG, "%s", furi_string_get_cstr(tx_log));
 
     Iso14443_4aError error =
         iso14443_4a_poller_send_block(poller->iso_poller, poller->tx_data, poller->rx_data);
@@ -51,7 +51,7 @@ static Iso14443_4aError tullave_iso14443_4a_send_apdu(TuLlavePoller* poller) {
         furi_string_cat_printf(rx_log, "ISO-14443-4a Error: 0x%03x", error);
     }
 
-    FURI_LOG_D(LOG_TAG, furi_string_get_cstr(rx_log));
+    FURI_LOG_D(LOG_TAG, "%s", furi_string_get_cstr(rx_log));
     return error;
 }
 
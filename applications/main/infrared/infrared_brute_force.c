@@ -1,14 +1,34 @@
 #include "infrared_brute_force.h"
 
 #include <stdlib.h>
+#include <m-array.h>
 #include <m-dict.h>
 #include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
 
 #include "infrared_signal.h"
 
+#define TAG "InfraredBruteForce"
+
+// Signal offsets are cached in a file next to the database
+#define INFRARED_BRUTE_FORCE_INDEX_EXT ".idx"
+#define INFRARED_BRUTE_FORCE_INDEX_MAGIC (0x49424649UL) // "IFBI"
+#define INFRARED_BRUTE_FORCE_INDEX_VERSION (1UL)
+// No signal in the database is shorter, bounds the offset count read from the index
+#define INFRARED_BRUTE_FORCE_SIGNAL_SIZE_MIN (16UL)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t db_size;
+    uint32_t db_timestamp;
+    uint32_t name_count;
+} InfraredBruteForceIndexHeader;
+
 typedef struct {
     uint32_t index;
     uint32_t count;
+    uint32_t first;
 } InfraredBruteForceRecord;
 
 DICT_DEF2(
@@ -18,12 +38,28 @@ DICT_DEF2(
     InfraredBruteForceRecord,
     M_POD_OPLIST);
 
+ARRAY_DEF(InfraredBruteForceOffsetArray, uint32_t, M_POD_OPLIST);
+
+#define M_OPL_InfraredBruteForceOffsetArray_t() \
+    ARRAY_OPLIST(InfraredBruteForceOffsetArray, M_POD_OPLIST)
+
+DICT_DEF2(
+    InfraredBruteForceSignalDict,
+    FuriString*,
+    FURI_STRING_OPLIST,
+    InfraredBruteForceOffsetArray_t,
+    M_OPL_InfraredBruteForceOffsetArray_t());
+
 struct InfraredBruteForce {
     FlipperFormat* ff;
     const char* db_filename;
     FuriString* current_record_name;
     InfraredSignal* current_signal;
     InfraredBruteForceRecordDict_t records;
+    InfraredBruteForceOffsetArray_t offsets;
+    uint32_t current_first;
+    uint32_t current_count;
+    uint32_t current_sent;
     bool is_started;
 };
 
@@ -35,12 +71,14 @@ InfraredBruteForce* infrared_brute_force_alloc(void) {
     brute_force->is_started = false;
     brute_force->current_record_name = furi_string_alloc();
     InfraredBruteForceRecordDict_init(brute_force->records);
+    InfraredBruteForceOffsetArray_init(brute_force->offsets);
     return brute_force;
 }
 
 void infrared_brute_force_free(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
     InfraredBruteForceRecordDict_clear(brute_force->records);
+    InfraredBruteForceOffsetArray_clear(brute_force->offsets);
     furi_string_free(brute_force->current_record_name);
     free(brute_force);
 }
@@ -50,30 +88,172 @@ void infrared_brute_force_set_db_filename(InfraredBruteForce* brute_force, const
     brute_force->db_filename = db_filename;
 }
 
-bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
-    furi_assert(!brute_force->is_started);
-    furi_assert(brute_force->db_filename);
+static void infrared_brute_force_reset_offsets(InfraredBruteForce* brute_force) {
+    InfraredBruteForceOffsetArray_reset(brute_force->offsets);
+    for
+        M_EACH(pair, brute_force->records, InfraredBruteForceRecordDict_t) {
+            pair->value.first = 0;
+            pair->value.count = 0;
+        }
+}
+
+static bool infrared_brute_force_load_index(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    const char* index_filename,
+    const InfraredBruteForceIndexHeader* expected) {
+    File* file = storage_file_alloc(storage);
+    FuriString* name = furi_string_alloc();
     bool success = false;
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
+    do {
+        if(!storage_file_open(file, index_filename, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        InfraredBruteForceIndexHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != expected->magic || header.version != expected->version) break;
+        if(header.db_size != expected->db_size) break;
+        if(header.db_timestamp != expected->db_timestamp) break;
+
+        const uint32_t offsets_max = header.db_size / INFRARED_BRUTE_FORCE_SIGNAL_SIZE_MIN;
+        if(header.name_count > offsets_max) break;
+
+        uint32_t offsets_total = 0;
+        bool error = false;
+        for(uint32_t i = 0; i < header.name_count; i++) {
+            uint8_t name_size;
+            char name_buffer[UINT8_MAX + 1];
+            uint32_t count;
+
+            if(storage_file_read(file, &name_size, sizeof(name_size)) != sizeof(name_size) ||
+               storage_file_read(file, name_buffer, name_size) != name_size ||
+               storage_file_read(file, &count, sizeof(count)) != sizeof(count)) {
+                error = true;
+                break;
+            }
+
+            // Checked separately, so that the sum cannot overflow
+            if(count > offsets_max || offsets_total + count > offsets_max) {
+                error = true;
+                break;
+            }
+            offsets_total += count;
+
+            name_buffer[name_size] = '\0';
+            furi_string_set(name, name_buffer);
+
+            const size_t offsets_size = count * sizeof(uint32_t);
+            InfraredBruteForceRecord* record =
+                InfraredBruteForceRecordDict_get(brute_force->records, name);
+
+            if(record) {
+                record->first = InfraredBruteForceOffsetArray_size(brute_force->offsets);
+                record->count = count;
+                InfraredBruteForceOffsetArray_resize(brute_force->offsets, record->first + count);
+                uint32_t* offsets = InfraredBruteForceOffsetArray_get(
+                    brute_force->offsets, record->first);
+                if(storage_file_read(file, offsets, offsets_size) != offsets_size) {
+                    error = true;
+                    break;
+                }
+                for(uint32_t j = 0; j < count; j++) {
+                    if(offsets[j] >= header.db_size) {
+                        error = true;
+                        break;
+                    }
+                }
+                if(error) break;
+            } else if(!storage_file_seek(file, storage_file_tell(file) + offsets_size, true)) {
+                error = true;
+                break;
+            }
+        }
+
+        success = !error;
+    } while(false);
+
+    furi_string_free(name);
+    storage_file_free(file);
+
+    // Do not leave a partially loaded index for the full scan
+    if(!success) {
+        infrared_brute_force_reset_offsets(brute_force);
+    }
+
+    return success;
+}
+
+static bool infrared_brute_force_save_index(
+    InfraredBruteForceSignalDict_t signals,
+    Storage* storage,
+    const char* index_filename,
+    const InfraredBruteForceIndexHeader* header) {
+    File* file = storage_file_alloc(storage);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(file, index_filename, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+        if(storage_file_write(file, header, sizeof(*header)) != sizeof(*header)) break;
+
+        bool error = false;
+        for
+            M_EACH(pair, signals, InfraredBruteForceSignalDict_t) {
+                const uint8_t name_size = furi_string_size(pair->key);
+                const uint32_t count = InfraredBruteForceOffsetArray_size(pair->value);
+                const size_t offsets_size = count * sizeof(uint32_t);
+
+                if(storage_file_write(file, &name_size, sizeof(name_size)) != sizeof(name_size) ||
+                   storage_file_write(file, furi_string_get_cstr(pair->key), name_size) !=
+                       name_size ||
+                   storage_file_write(file, &count, sizeof(count)) != sizeof(count) ||
+                   storage_file_write(
+                       file, InfraredBruteForceOffsetArray_cget(pair->value, 0), offsets_size) !=
+                       offsets_size) {
+                    error = true;
+                    break;
+                }
+            }
+
+        success = !error;
+    } while(false);
+
+    storage_file_free(file);
+
+    if(!success) {
+        storage_simply_remove(storage, index_filename);
+    }
+
+    return success;
+}
+
+static bool infrared_brute_force_parse_db(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    InfraredBruteForceSignalDict_t signals) {
     FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    Stream* stream = flipper_format_get_raw_stream(ff);
     FuriString* signal_name = furi_string_alloc();
     InfraredSignal* signal = infrared_signal_alloc();
+    bool success = false;
 
     do {
         if(!flipper_format_buffered_file_open_existing(ff, brute_force->db_filename)) break;
 
         bool signals_valid = false;
+        size_t offset = stream_tell(stream);
         while(infrared_signal_read_name(ff, signal_name)) {
             signals_valid = infrared_signal_read_body(signal, ff) &&
                             infrared_signal_is_valid(signal);
             if(!signals_valid) break;
 
-            InfraredBruteForceRecord* record =
-                InfraredBruteForceRecordDict_get(brute_force->records, signal_name);
-            if(record) { //-V547
-                ++(record->count);
+            // Reading the name from this offset will find the same signal
+            if(furi_string_size(signal_name) <= UINT8_MAX) {
+                InfraredBruteForceOffsetArray_t* offsets =
+                    InfraredBruteForceSignalDict_safe_get(signals, signal_name);
+                InfraredBruteForceOffsetArray_push_back(*offsets, offset);
             }
+
+            offset = stream_tell(stream);
         }
 
         if(!signals_valid) break;
@@ -82,8 +262,79 @@ bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
 
     infrared_signal_free(signal);
     furi_string_free(signal_name);
-
     flipper_format_free(ff);
+
+    return success;
+}
+
+bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
+    furi_assert(!brute_force->is_started);
+    furi_assert(brute_force->db_filename);
+    bool success = false;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* index_filename =
+        furi_string_alloc_printf("%s%s", brute_force->db_filename, INFRARED_BRUTE_FORCE_INDEX_EXT);
+    InfraredBruteForceSignalDict_t signals;
+    InfraredBruteForceSignalDict_init(signals);
+
+    uint32_t start = furi_get_tick();
+    bool cached = false;
+
+    do {
+        FileInfo info;
+        InfraredBruteForceIndexHeader header = {
+            .magic = INFRARED_BRUTE_FORCE_INDEX_MAGIC,
+            .version = INFRARED_BRUTE_FORCE_INDEX_VERSION,
+        };
+
+        if(storage_common_stat(storage, brute_force->db_filename, &info) != FSE_OK) break;
+        if(storage_common_timestamp(storage, brute_force->db_filename, &header.db_timestamp) !=
+           FSE_OK)
+            break;
+        header.db_size = info.size;
+
+        infrared_brute_force_reset_offsets(brute_force);
+
+        cached = infrared_brute_force_load_index(
+            brute_force, storage, furi_string_get_cstr(index_filename), &header);
+        if(cached) {
+            success = true;
+            break;
+        }
+
+        // No valid index, parse the whole database and cache signal offsets for the next time
+        if(!infrared_brute_force_parse_db(brute_force, storage, signals)) break;
+
+        header.name_count = InfraredBruteForceSignalDict_size(signals);
+        if(!infrared_brute_force_save_index(
+               signals, storage, furi_string_get_cstr(index_filename), &header)) {
+            FURI_LOG_W(TAG, "Failed to save %s", furi_string_get_cstr(index_filename));
+        }
+
+        for
+            M_EACH(pair, brute_force->records, InfraredBruteForceRecordDict_t) {
+                InfraredBruteForceOffsetArray_t* offsets =
+                    InfraredBruteForceSignalDict_get(signals, pair->key);
+                if(offsets) {
+                    pair->value.first = InfraredBruteForceOffsetArray_size(brute_force->offsets);
+                    pair->value.count = InfraredBruteForceOffsetArray_size(*offsets);
+                    InfraredBruteForceOffsetArray_splice(brute_force->offsets, *offsets);
+                }
+            }
+
+        success = true;
+    } while(false);
+
+    FURI_LOG_I(
+        TAG,
+        "%s loaded in %lums, %s",
+        brute_force->db_filename,
+        furi_get_tick() - start,
+        cached ? "cached" : "parsed");
+
+    InfraredBruteForceSignalDict_clear(signals);
+    furi_string_free(index_filename);
     furi_record_close(RECORD_STORAGE);
     return success;
 }
@@ -105,6 +356,9 @@ bool infrared_brute_force_start(
             *record_count = record->value.count;
             if(*record_count) {
                 furi_string_set(brute_force->current_record_name, record->key);
+                brute_force->current_first = record->value.first;
+                brute_force->current_count = record->value.count;
+                brute_force->current_sent = 0;
             }
             break;
         }
@@ -139,10 +393,18 @@ void infrared_brute_force_stop(InfraredBruteForce* brute_force) {
 
 bool infrared_brute_force_send_next(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
-    const bool success = infrared_signal_search_by_name_and_read(
-        brute_force->current_signal,
-        brute_force->ff,
-        furi_string_get_cstr(brute_force->current_record_name));
+    if(brute_force->current_sent >= brute_force->current_count) return false;
+
+    // Jump straight to the signal, the name is checked once again while reading
+    const uint32_t offset = *InfraredBruteForceOffsetArray_get(
+        brute_force->offsets, brute_force->current_first + brute_force->current_sent++);
+    const bool success =
+        stream_seek(
+            flipper_format_get_raw_stream(brute_force->ff), offset, StreamOffsetFromStart) &&
+        infrared_signal_search_by_name_and_read(
+            brute_force->current_signal,
+            brute_force->ff,
+            furi_string_get_cstr(brute_force->current_record_name));
     if(success) {
         infrared_signal_transmit(brute_force->current_signal);
     }
@@ -153,7 +415,7 @@ void infrared_brute_force_add_record(
     InfraredBruteForce* brute_force,
     uint32_t index,
     const char* name) {
-    InfraredBruteForceRecord value = {.index = index, .count = 0};
+    InfraredBruteForceRecord value = {.index = index, .count = 0, .first = 0};
     FuriString* key;
     key = furi_string_alloc_set(name);
     InfraredBruteForceRecordDict_set_at(brute_force->records, key, value);
@@ -163,4 +425,5 @@ void infrared_brute_force_add_record(
 void infrared_brute_force_reset(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
     InfraredBruteForceRecordDict_reset(brute_force->records);
+    InfraredBruteForceOffsetArray_reset(brute_force->offsets);
 }
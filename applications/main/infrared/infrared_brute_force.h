@@ -44,6 +44,10 @@ void infrared_brute_force_set_db_filename(InfraredBruteForce* brute_force, const
  * This function must be called each time after setting the database via
  * a infrared_brute_force_set_db_filename() call.
  *
+ * Signal offsets are cached in a ".idx" file next to the database. The cache is
+ * used as long as the database size and timestamp match, otherwise the database
+ * is parsed and the cache is rebuilt.
+ *
  * @param[in,out] brute_force pointer to the instance to be updated.
  * @returns true on success, false otherwise.
  */
@@ -131,7 +131,9 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(NfcApp* instance) {
             }
 
             instance->nfc_dict_context.dict = keys_dict_alloc(
-                NFC_APP_MF_CLASSIC_DICT_USER_PATH, KeysDictModeOpenAlways, sizeof(MfClassicKey));
+                NFC_APP_MF_CLASSIC_DICT_USER_PATH,
+                KeysDictModeOpenAlways | KeysDictModeCompiled,
+                sizeof(MfClassicKey));
             if(keys_dict_get_total_keys(instance->nfc_dict_context.dict) == 0) {
                 keys_dict_free(instance->nfc_dict_context.dict);
                 state = DictAttackStateSystemDictInProgress;
@@ -143,7 +145,9 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(NfcApp* instance) {
     }
     if(state == DictAttackStateSystemDictInProgress) {
         instance->nfc_dict_context.dict = keys_dict_alloc(
-            NFC_APP_MF_CLASSIC_DICT_SYSTEM_PATH, KeysDictModeOpenExisting, sizeof(MfClassicKey));
+            NFC_APP_MF_CLASSIC_DICT_SYSTEM_PATH,
+            KeysDictModeOpenExisting | KeysDictModeCompiled,
+            sizeof(MfClassicKey));
         dict_attack_set_header(instance->dict_attack, "MF Classic System Dictionary");
     }
 
@@ -855,6 +855,8 @@ static void subghz_cli_command_print_usage(void) {
         printf("\trx_carrier <frequency:in Hz>\t - Receive carrier\r\n");
         printf(
             "\tencrypt_keeloq <path_decrypted_file> <path_encrypted_file> <IV:16 bytes in hex>\t - Encrypt keeloq manufacture keys\r\n");
+        printf(
+            "\tcompile_keeloq <path_decrypted_file> <path_compiled_file> <IV:16 bytes in hex>\t - Compile keeloq manufacture keys\r\n");
         printf(
             "\tencrypt_raw <path_decrypted_file> <path_encrypted_file> <IV:16 bytes in hex>\t - Encrypt RAW data\r\n");
     }
@@ -901,6 +903,47 @@ static void subghz_cli_command_encrypt_keeloq(Cli* cli, FuriString* args) {
     furi_string_free(source);
 }
 
+static void subghz_cli_command_compile_keeloq(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+    uint8_t iv[16];
+
+    FuriString* source = furi_string_alloc();
+    FuriString* destination = furi_string_alloc();
+
+    SubGhzKeystore* keystore = subghz_keystore_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, source)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        if(!args_read_string_and_trim(args, destination)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        if(!args_read_hex_bytes(args, iv, 16)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        if(!subghz_keystore_load(keystore, furi_string_get_cstr(source))) {
+            printf("Failed to load Keystore");
+            break;
+        }
+
+        if(!subghz_keystore_save_compiled(keystore, furi_string_get_cstr(destination), iv)) {
+            printf("Failed to save compiled Keystore");
+            break;
+        }
+    } while(false);
+
+    subghz_keystore_free(keystore);
+    furi_string_free(destination);
+    furi_string_free(source);
+}
+
 static void subghz_cli_command_encrypt_raw(Cli* cli, FuriString* args) {
     UNUSED(cli);
     uint8_t iv[16];
@@ -1170,6 +1213,11 @@ static void subghz_cli_command(Cli* cli, FuriString* args, void* context) {
                 break;
             }
 
+            if(furi_string_cmp_str(cmd, "compile_keeloq") == 0) {
+                subghz_cli_command_compile_keeloq(cli, args);
+                break;
+            }
+
             if(furi_string_cmp_str(cmd, "encrypt_raw") == 0) {
                 subghz_cli_command_encrypt_raw(cli, args);
                 break;
@@ -488,6 +488,13 @@ int32_t cli_srv(void* p) {
     return 0;
 }
 
+void cli_on_system_start(void) {
+    // Per tag log levels are kept on SD card, boot in special modes with defaults
+    if(furi_hal_is_normal_boot()) {
+        cli_command_log_tags_load();
+    }
+}
+
 void cli_plugin_wrapper(
     const char* handler_name,
     uint32_t handler_version,
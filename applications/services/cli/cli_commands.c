@@ -9,6 +9,8 @@
 #include <notification/notification_messages.h>
 #include <loader/loader.h>
 #include <lib/toolbox/args.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
 
 // Close to ISO, `date +'%Y-%m-%d %H:%M:%S %u'`
 #define CLI_DATE_FORMAT "%.4d-%.2d-%.2d %.2d:%.2d:%.2d %d"
@@ -180,6 +182,10 @@ void cli_command_src(Cli* cli, FuriString* args, void* context) {
 #define CLI_COMMAND_LOG_RING_SIZE 2048
 #define CLI_COMMAND_LOG_BUFFER_SIZE 64
 
+#define CLI_COMMAND_LOG_TAGS_PATH CFG_PATH("log_tags.txt")
+#define CLI_COMMAND_LOG_TAGS_FILE_TYPE "Flipper Log Tags"
+#define CLI_COMMAND_LOG_TAGS_FILE_VERSION 1
+
 void cli_command_log_tx_callback(const uint8_t* buffer, size_t size, void* context) {
     furi_stream_buffer_send(context, buffer, size, 0);
 }
@@ -199,12 +205,123 @@ bool cli_command_log_level_set_from_string(FuriString* level) {
             "<log debug> — debug information including <log info> (may impact system performance)\r\n");
         printf(
             "<log trace> — system traces including <log debug> (may impact system performance)\r\n");
+        printf("<log tag> — list levels set for individual tags\r\n");
+        printf(
+            "<log tag TAG LEVEL> — set and save level for one tag, <default> follows system level\r\n");
     }
     return false;
 }
 
+typedef struct {
+    char tag[FURI_LOG_TAG_SIZE];
+    FuriLogLevel level;
+} CliCommandLogTag;
+
+typedef struct {
+    CliCommandLogTag tags[FURI_LOG_TAG_LEVELS_MAX];
+    size_t count;
+} CliCommandLogTags;
+
+static void
+    cli_command_log_tags_copy_callback(const char* tag, FuriLogLevel level, void* context) {
+    CliCommandLogTags* tags = context;
+    if(tags->count < COUNT_OF(tags->tags)) {
+        strlcpy(tags->tags[tags->count].tag, tag, FURI_LOG_TAG_SIZE);
+        tags->tags[tags->count].level = level;
+        tags->count++;
+    }
+}
+
+static bool cli_command_log_tags_save(void) {
+    // Copy first: log mutex must not be held during file IO, storage logs too
+    CliCommandLogTags* tags = malloc(sizeof(CliCommandLogTags));
+    furi_log_enumerate_tag_levels(cli_command_log_tags_copy_callback, tags);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+
+    bool success = flipper_format_file_open_always(file, CLI_COMMAND_LOG_TAGS_PATH) &&
+                   flipper_format_write_header_cstr(
+                       file, CLI_COMMAND_LOG_TAGS_FILE_TYPE, CLI_COMMAND_LOG_TAGS_FILE_VERSION);
+    for(size_t i = 0; success && i < tags->count; i++) {
+        const char* level_str;
+        furi_check(furi_log_level_to_string(tags->tags[i].level, &level_str));
+
+        success = flipper_format_write_string_cstr(file, "Tag", tags->tags[i].tag) &&
+                  flipper_format_write_string_cstr(file, "Level", level_str);
+    }
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+    free(tags);
+
+    return success;
+}
+
+void cli_command_log_tags_load(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* tag = furi_string_alloc();
+    FuriString* level_str = furi_string_alloc();
+    uint32_t version;
+
+    if(flipper_format_file_open_existing(file, CLI_COMMAND_LOG_TAGS_PATH) &&
+       flipper_format_read_header(file, level_str, &version) &&
+       furi_string_equal(level_str, CLI_COMMAND_LOG_TAGS_FILE_TYPE) &&
+       version == CLI_COMMAND_LOG_TAGS_FILE_VERSION) {
+        while(flipper_format_read_string(file, "Tag", tag) &&
+              flipper_format_read_string(file, "Level", level_str)) {
+            FuriLogLevel level;
+            if(furi_log_level_from_string(furi_string_get_cstr(level_str), &level)) {
+                furi_log_set_tag_level(furi_string_get_cstr(tag), level);
+            }
+        }
+    }
+
+    furi_string_free(level_str);
+    furi_string_free(tag);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void
+    cli_command_log_tags_print_callback(const char* tag, FuriLogLevel level, void* context) {
+    UNUSED(context);
+    const char* level_str;
+    furi_check(furi_log_level_to_string(level, &level_str));
+    printf("%-24s: %s\r\n", tag, level_str);
+}
+
+static void cli_command_log_tags(FuriString* args) {
+    FuriString* tag = furi_string_alloc();
+    FuriLogLevel level;
+
+    if(!args_read_string_and_trim(args, tag)) {
+        // No arguments, list overrides
+        furi_log_enumerate_tag_levels(cli_command_log_tags_print_callback, NULL);
+    } else if(!furi_log_level_from_string(furi_string_get_cstr(args), &level)) {
+        cli_print_usage("log tag", "[<tag> <level|default>]", furi_string_get_cstr(args));
+    } else if(!furi_log_set_tag_level(furi_string_get_cstr(tag), level)) {
+        printf("Tag is too long or too many tags have levels set\r\n");
+    } else if(!cli_command_log_tags_save()) {
+        printf("Tag level is set, but failed to save it\r\n");
+    } else {
+        printf("Tag level is set and saved\r\n");
+    }
+
+    furi_string_free(tag);
+}
+
 void cli_command_log(Cli* cli, FuriString* args, void* context) {
     UNUSED(context);
+
+    if(furi_string_equal(args, "tag") || furi_string_start_with_str(args, "tag ")) {
+        furi_string_right(args, strlen("tag"));
+        furi_string_trim(args);
+        cli_command_log_tags(args);
+        return;
+    }
+
     FuriStreamBuffer* ring = furi_stream_buffer_alloc(CLI_COMMAND_LOG_RING_SIZE, 1);
     uint8_t buffer[CLI_COMMAND_LOG_BUFFER_SIZE];
     FuriLogLevel previous_level = furi_log_get_level();
@@ -282,6 +399,21 @@ void cli_command_sysctl_heap_track(Cli* cli, FuriString* args, void* context) {
     }
 }
 
+void cli_command_sysctl_log_deferred(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+    if(!furi_string_cmp(args, "0")) {
+        furi_log_set_deferred(false);
+        printf("Deferred logging disabled.");
+    } else if(!furi_string_cmp(args, "1")) {
+        furi_log_set_deferred(true);
+        printf("Deferred logging enabled.");
+    } else {
+        cli_print_usage("sysctl log_deferred", "<1|0>", furi_string_get_cstr(args));
+    }
+    printf("\r\nDropped records: %lu", furi_log_get_dropped());
+}
+
 void cli_command_sysctl_print_usage(void) {
     printf("Usage:\r\n");
     printf("sysctl <cmd> <args>\r\n");
@@ -293,6 +425,7 @@ void cli_command_sysctl_print_usage(void) {
 #else
     printf("\theap_track <none|main>\t - Set heap allocation tracking mode\r\n");
 #endif
+    printf("\tlog_deferred <0|1>\t - Enable or disable deferred logging\r\n");
 }
 
 void cli_command_sysctl(Cli* cli, FuriString* args, void* context) {
@@ -315,6 +448,11 @@ void cli_command_sysctl(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "log_deferred") == 0) {
+            cli_command_sysctl_log_deferred(cli, args, context);
+            break;
+        }
+
         cli_command_sysctl_print_usage();
     } while(false);
 
@@ -3,3 +3,5 @@
 #include "cli_i.h"
 
 void cli_commands_init(Cli* cli);
+
+void cli_command_log_tags_load(void);
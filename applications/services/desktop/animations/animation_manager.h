@@ -22,6 +22,9 @@ typedef struct FrameBubble {
     const struct FrameBubble* next_bubble;
 } FrameBubble;
 
+/** Frames of an animation streamed from storage */
+typedef struct AnimationFrameStream AnimationFrameStream;
+
 typedef struct {
     const FrameBubble* const* frame_bubble_sequences;
     uint8_t frame_bubble_sequences_count;
@@ -32,6 +35,9 @@ typedef struct {
     uint8_t active_cycles;
     uint16_t duration;
     uint16_t active_cooldown;
+    /* If set, only frames prefetched from the stream are resident in icon_animation,
+     * others are NULL. Frame 0 is always resident. */
+    AnimationFrameStream* frame_stream;
 } BubbleAnimation;
 
 typedef void (*AnimationManagerSetNewIdleAnimationCallback)(void* context);
@@ -14,9 +14,19 @@
 #include <assets_dolphin_blocking.h>
 
 #define ANIMATION_META_FILE "meta.txt"
+#define ANIMATION_BUNDLE_FILE "frames.bundle"
+#define ANIMATION_BUNDLE_MAGIC (0x444E4246UL) /* "FBND" */
+#define ANIMATION_STREAM_SLOTS (4)
 #define ANIMATION_DIR EXT_PATH("dolphin")
 #define TAG "AnimationStorage"
 
+/* Bundle starts with the header and frame_count + 1 offsets of frames from file start */
+typedef struct {
+    uint32_t magic;
+    uint16_t frame_count;
+    uint16_t reserved;
+} AnimationBundleHeader;
+
 static void animation_storage_free_bubbles(BubbleAnimation* animation);
 static void animation_storage_free_frames(BubbleAnimation* animation);
 static void animation_storage_free_animation(BubbleAnimation** storage_animation);
@@ -270,21 +280,165 @@ static bool animation_storage_cast_align(FuriString* align_str, Align* align) {
     return true;
 }
 
+struct AnimationFrameStream {
+    Storage* storage;
+    /* Packed frames, NULL if frames are stored in separate files */
+    File* bundle;
+    uint32_t* offsets;
+    FuriString* name;
+    FuriString* path;
+    size_t frame_size_max;
+    uint32_t clock;
+    uint8_t* slots[ANIMATION_STREAM_SLOTS];
+    /* Buffer the next frame is read into, swapped with the evicted slot */
+    uint8_t* spare;
+    int16_t slot_frame[ANIMATION_STREAM_SLOTS];
+    uint32_t slot_used[ANIMATION_STREAM_SLOTS];
+};
+
 static void animation_storage_free_frames(BubbleAnimation* animation) {
     furi_assert(animation);
 
     const Icon* icon = &animation->icon_animation;
-    for(int i = 0; i < icon->frame_count; ++i) {
-        if(icon->frames[i]) {
-            free((void*)icon->frames[i]);
+    AnimationFrameStream* stream = animation->frame_stream;
+
+    if(stream) {
+        /* streamed frames point into slots, only frame 0 is owned by the table */
+        if(icon->frames[0]) {
+            free((void*)icon->frames[0]);
+        }
+        for(size_t i = 0; i < ANIMATION_STREAM_SLOTS; ++i) {
+            free(stream->slots[i]);
+        }
+        free(stream->spare);
+        if(stream->bundle) {
+            storage_file_free(stream->bundle);
+        }
+        free(stream->offsets);
+        furi_string_free(stream->name);
+        furi_string_free(stream->path);
+        furi_record_close(RECORD_STORAGE);
+        free(stream);
+        animation->frame_stream = NULL;
+    } else {
+        for(int i = 0; i < icon->frame_count; ++i) {
+            if(icon->frames[i]) {
+                free((void*)icon->frames[i]);
+            }
         }
     }
 
     free((void*)icon->frames);
 }
 
+static bool animation_storage_open_bundle(AnimationFrameStream* stream, uint8_t frame_count) {
+    AnimationBundleHeader header;
+    const size_t offsets_size = sizeof(uint32_t) * (frame_count + 1);
+    bool result = false;
+
+    furi_string_printf(
+        stream->path,
+        EXT_PATH("dolphin") "/%s/" ANIMATION_BUNDLE_FILE,
+        furi_string_get_cstr(stream->name));
+
+    stream->bundle = storage_file_alloc(stream->storage);
+    stream->offsets = malloc(offsets_size);
+
+    do {
+        if(!storage_file_open(
+               stream->bundle, furi_string_get_cstr(stream->path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        if(storage_file_read(stream->bundle, &header, sizeof(header)) != sizeof(header)) break;
+        if((header.magic != ANIMATION_BUNDLE_MAGIC) || (header.frame_count != frame_count)) {
+            FURI_LOG_E(TAG, "Bad bundle \'%s\'", furi_string_get_cstr(stream->path));
+            break;
+        }
+        if(storage_file_read(stream->bundle, stream->offsets, offsets_size) != offsets_size)
+            break;
+
+        const uint64_t bundle_size = storage_file_size(stream->bundle);
+        result = stream->offsets[frame_count] <= bundle_size;
+        for(size_t i = 0; result && (i < frame_count); ++i) {
+            result = (stream->offsets[i] <= stream->offsets[i + 1]) &&
+                     ((stream->offsets[i + 1] - stream->offsets[i]) <= stream->frame_size_max);
+        }
+        if(!result) {
+            FURI_LOG_E(TAG, "Bad bundle offsets \'%s\'", furi_string_get_cstr(stream->path));
+        }
+    } while(0);
+
+    if(!result) {
+        storage_file_free(stream->bundle);
+        stream->bundle = NULL;
+        free(stream->offsets);
+        stream->offsets = NULL;
+    }
+
+    return result;
+}
+
+static bool
+    animation_storage_check_frame_files(AnimationFrameStream* stream, uint8_t frame_count) {
+    FileInfo file_info;
+
+    for(int i = 0; i < frame_count; ++i) {
+        furi_string_printf(
+            stream->path,
+            EXT_PATH("dolphin") "/%s/frame_%d.bm",
+            furi_string_get_cstr(stream->name),
+            i);
+
+        if(storage_common_stat(stream->storage, furi_string_get_cstr(stream->path), &file_info) !=
+           FSE_OK) {
+            FURI_LOG_E(TAG, "Can't stat file \'%s\'", furi_string_get_cstr(stream->path));
+            return false;
+        }
+        if(file_info.size > stream->frame_size_max) {
+            FURI_LOG_E(
+                TAG,
+                "Filesize %llu, max: %zu \'%s\'",
+                file_info.size,
+                stream->frame_size_max,
+                furi_string_get_cstr(stream->path));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool animation_storage_read_frame(AnimationFrameStream* stream, uint8_t frame, void* buff) {
+    bool result = false;
+
+    if(stream->bundle) {
+        const size_t size = stream->offsets[frame + 1] - stream->offsets[frame];
+        result = storage_file_seek(stream->bundle, stream->offsets[frame], true) &&
+                 (storage_file_read(stream->bundle, buff, size) == size);
+    } else {
+        furi_string_printf(
+            stream->path,
+            EXT_PATH("dolphin") "/%s/frame_%d.bm",
+            furi_string_get_cstr(stream->name),
+            frame);
+
+        File* file = storage_file_alloc(stream->storage);
+        if(storage_file_open(
+               file, furi_string_get_cstr(stream->path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+            const uint64_t size = storage_file_size(file);
+            result = (size <= stream->frame_size_max) &&
+                     (storage_file_read(file, buff, size) == size);
+        }
+        storage_file_free(file);
+    }
+
+    if(!result) {
+        FURI_LOG_E(TAG, "Read failed: \'%s\' frame %u", furi_string_get_cstr(stream->name), frame);
+    }
+
+    return result;
+}
+
 static bool animation_storage_load_frames(
-    Storage* storage,
     const char* name,
     BubbleAnimation* animation,
     uint32_t* frame_order,
@@ -309,66 +463,114 @@ static bool animation_storage_load_frames(
     FURI_CONST_ASSIGN(icon->width, width);
     icon->frames = malloc(sizeof(const uint8_t*) * icon->frame_count);
 
-    bool frames_ok = false;
-    File* file = storage_file_alloc(storage);
-    FileInfo file_info;
-    FuriString* filename;
-    filename = furi_string_alloc();
-    size_t max_filesize = ROUND_UP_TO(width, 8) * height + 1;
+    /* Only a few frames are kept in memory, the rest is read while playing */
+    AnimationFrameStream* stream = malloc(sizeof(AnimationFrameStream));
+    stream->storage = furi_record_open(RECORD_STORAGE);
+    stream->name = furi_string_alloc_set(name);
+    stream->path = furi_string_alloc();
+    stream->frame_size_max = ROUND_UP_TO(width, 8) * height + 1;
+    for(size_t i = 0; i < ANIMATION_STREAM_SLOTS; ++i) {
+        stream->slot_frame[i] = -1;
+    }
+    animation->frame_stream = stream;
 
-    for(int i = 0; i < icon->frame_count; ++i) {
-        frames_ok = false;
-        furi_string_printf(filename, EXT_PATH("dolphin") "/%s/frame_%d.bm", name, i);
+    bool frames_ok = false;
+    const uint32_t start = furi_get_tick();
 
-        if(storage_common_stat(storage, furi_string_get_cstr(filename), &file_info) != FSE_OK)
-            break;
-        if(file_info.size > max_filesize) {
-            FURI_LOG_E(
-                TAG,
-                "Filesize %llu, max: %zu (width %u, height %u)",
-                file_info.size,
-                max_filesize,
-                width,
-                height);
-            break;
-        }
-        if(!storage_file_open(
-               file, furi_string_get_cstr(filename), FSAM_READ, FSOM_OPEN_EXISTING)) {
-            FURI_LOG_E(TAG, "Can't open file \'%s\'", furi_string_get_cstr(filename));
+    do {
+        if(!animation_storage_open_bundle(stream, icon->frame_count) &&
+           !animation_storage_check_frame_files(stream, icon->frame_count))
             break;
-        }
 
-        FURI_CONST_ASSIGN_PTR(icon->frames[i], malloc(file_info.size));
-        if(storage_file_read(file, (void*)icon->frames[i], file_info.size) != file_info.size) {
-            FURI_LOG_E(TAG, "Read failed: \'%s\'", furi_string_get_cstr(filename));
-            break;
-        }
-        storage_file_close(file);
+        /* frame 0 starts the passive phase and is used as a freeze frame */
+        FURI_CONST_ASSIGN_PTR(icon->frames[0], malloc(stream->frame_size_max));
+        if(!animation_storage_read_frame(stream, 0, (void*)icon->frames[0])) break;
+
         frames_ok = true;
-    }
+    } while(0);
 
     if(!frames_ok) {
-        FURI_LOG_E(
-            TAG,
-            "Load \'%s\' failed, %ux%u, size: %llu",
-            furi_string_get_cstr(filename),
-            width,
-            height,
-            file_info.size);
+        FURI_LOG_E(TAG, "Load \'%s\' failed, %ux%u", name, width, height);
         animation_storage_free_frames(animation);
     } else {
-        furi_check(animation->icon_animation.frames);
-        for(int i = 0; i < animation->icon_animation.frame_count; ++i) {
-            furi_check(animation->icon_animation.frames[i]);
-        }
+        FURI_LOG_D(
+            TAG,
+            "Opened \'%s\' (%s), %u frames in %lums",
+            name,
+            stream->bundle ? "bundle" : "files",
+            icon->frame_count,
+            furi_get_tick() - start);
     }
 
-    storage_file_free(file);
-    furi_string_free(filename);
-
     return frames_ok;
 }
 
+void animation_storage_prefetch_frames(
+    const BubbleAnimation* animation,
+    const uint8_t* frames,
+    size_t count,
+    AnimationStorageLockCallback lock_callback,
+    void* context) {
+    furi_assert(animation);
+    furi_assert(frames);
+    furi_assert(lock_callback);
+
+    AnimationFrameStream* stream = animation->frame_stream;
+    if(!stream) {
+        return;
+    }
+
+    const Icon* icon = &animation->icon_animation;
+    count = MIN(count, (size_t)ANIMATION_STREAM_SLOTS);
+
+    for(size_t i = 0; i < count; ++i) {
+        const uint8_t frame = frames[i];
+        furi_assert(frame < icon->frame_count);
+        if(frame == 0) continue;
+
+        const uint32_t used = ++stream->clock;
+        size_t slot = ANIMATION_STREAM_SLOTS;
+
+        for(size_t j = 0; j < ANIMATION_STREAM_SLOTS; ++j) {
+            if(stream->slot_frame[j] == frame) {
+                slot = j;
+                break;
+            }
+        }
+        if(slot < ANIMATION_STREAM_SLOTS) {
+            stream->slot_used[slot] = used;
+            continue;
+        }
+
+        /* Evict the least recently used frame, requested ones are used more recently */
+        slot = 0;
+        for(size_t j = 1; j < ANIMATION_STREAM_SLOTS; ++j) {
+            if(stream->slot_used[j] < stream->slot_used[slot]) {
+                slot = j;
+            }
+        }
+        stream->slot_used[slot] = used;
+
+        /* Evicted frame may be drawn meanwhile, so read into the spare buffer */
+        if(!stream->spare) {
+            stream->spare = malloc(stream->frame_size_max);
+        }
+        if(!animation_storage_read_frame(stream, frame, stream->spare)) continue;
+
+        lock_callback(true, context);
+        if(stream->slot_frame[slot] >= 0) {
+            FURI_CONST_ASSIGN_PTR(icon->frames[stream->slot_frame[slot]], NULL);
+        }
+        FURI_CONST_ASSIGN_PTR(icon->frames[frame], stream->spare);
+        lock_callback(false, context);
+
+        uint8_t* evicted = stream->slots[slot];
+        stream->slots[slot] = stream->spare;
+        stream->spare = evicted;
+        stream->slot_frame[slot] = frame;
+    }
+}
+
 static bool animation_storage_load_bubbles(BubbleAnimation* animation, FlipperFormat* ff) {
     uint32_t u32value;
     FuriString* str;
@@ -498,7 +700,7 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
         }
 
         /* passive and active frames must be loaded up to this point */
-        if(!animation_storage_load_frames(storage, name, animation, u32array, width, height))
+        if(!animation_storage_load_frames(name, animation, u32array, width, height))
             break;
 
         if(!flipper_format_read_uint32(ff, "Active cycles", &u32value, 1)) break; //-V779
@@ -521,6 +723,9 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
     }
 
     if(!success) { //-V547
+        if(animation->frame_stream) {
+            animation_storage_free_frames(animation);
+        }
         if(animation->frame_order) {
             free((void*)animation->frame_order);
         }
@@ -1,5 +1,6 @@
 #pragma once
 #include <stdint.h>
+#include <stdbool.h>
 #include <m-list.h>
 #include "views/bubble_animation_view.h"
 
@@ -54,6 +55,31 @@ const BubbleAnimation* animation_storage_get_bubble_animation(StorageAnimation*
  */
 void animation_storage_cache_animation(StorageAnimation* storage_animation);
 
+/** Callback to lock (true) or unlock (false) readers of animation frames */
+typedef void (*AnimationStorageLockCallback)(bool lock, void* context);
+
+/**
+ * Make frames of streamed animation resident.
+ * Frames are read synchronously, the first one is the frame to be drawn
+ * and the rest are the frames to be drawn next. Frames that are no longer
+ * requested are evicted. Does nothing for animations with all frames resident.
+ * Reading is done without lock, only frame pointers are swapped under it,
+ * so this should not be called from the drawing or timer context.
+ * Calls for the same animation must not overlap.
+ *
+ * @animation       animation to prefetch frames of
+ * @frames          frame indexes in icon_animation, in playing order
+ * @count           number of frames, extra ones beyond stream capacity are ignored
+ * @lock_callback   callback guarding frame pointers against readers
+ * @context         context for lock_callback
+ */
+void animation_storage_prefetch_frames(
+    const BubbleAnimation* animation,
+    const uint8_t* frames,
+    size_t count,
+    AnimationStorageLockCallback lock_callback,
+    void* context);
+
 /**
  * Find animation by name.
  * Search through the inner flash, and SD-card if has.
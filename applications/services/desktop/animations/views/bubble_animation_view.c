@@ -13,6 +13,17 @@
 #include <core/dangerous_defines.h>
 
 #define ACTIVE_SHIFT 2
+/* Current frame and frames to be drawn next */
+#define PREFETCH_FRAMES 3
+#define PREFETCH_STACK_SIZE 1024
+
+typedef enum {
+    BubbleAnimationPrefetchFlagStop = (1 << 0),
+    BubbleAnimationPrefetchFlagLoad = (1 << 1),
+} BubbleAnimationPrefetchFlag;
+
+#define BUBBLE_ANIMATION_PREFETCH_FLAGS_ALL \
+    (BubbleAnimationPrefetchFlagStop | BubbleAnimationPrefetchFlagLoad)
 
 typedef struct {
     const BubbleAnimation* current;
@@ -29,6 +40,10 @@ typedef struct {
 struct BubbleAnimationView {
     View* view;
     FuriTimer* timer;
+    /* Reads streamed frames, so SD access stays off the timer and the model lock */
+    FuriThread* prefetch_thread;
+    /* Held while prefetching, animation is not freed until it is released */
+    FuriMutex* prefetch_mutex;
     BubbleAnimationInteractCallback interact_callback;
     void* interact_callback_context;
 };
@@ -36,23 +51,109 @@ struct BubbleAnimationView {
 static void bubble_animation_activate(BubbleAnimationView* view, bool force);
 static void bubble_animation_activate_right_now(BubbleAnimationView* view);
 
-static uint8_t bubble_animation_get_frame_index(BubbleAnimationViewModel* model) {
-    furi_assert(model);
+static uint8_t
+    bubble_animation_get_icon_index(const BubbleAnimation* animation, uint8_t current_frame) {
     uint8_t icon_index = 0;
-    const BubbleAnimation* animation = model->current;
 
-    if(model->current_frame < animation->passive_frames) {
-        icon_index = model->current_frame;
+    if(current_frame < animation->passive_frames) {
+        icon_index = current_frame;
     } else {
-        icon_index =
-            (model->current_frame - animation->passive_frames) % animation->active_frames +
-            animation->passive_frames;
+        icon_index = (current_frame - animation->passive_frames) % animation->active_frames +
+                     animation->passive_frames;
     }
     furi_assert(icon_index < (animation->passive_frames + animation->active_frames));
 
     return animation->frame_order[icon_index];
 }
 
+static uint8_t bubble_animation_get_frame_index(BubbleAnimationViewModel* model) {
+    furi_assert(model);
+    return bubble_animation_get_icon_index(model->current, model->current_frame);
+}
+
+/* Pick current and upcoming frames of streamed animations,
+ * following the same frame sequence as bubble_animation_next_frame */
+static const BubbleAnimation*
+    bubble_animation_prefetch_plan(BubbleAnimationViewModel* model, uint8_t* frames) {
+    furi_assert(model);
+    const BubbleAnimation* animation = model->current;
+
+    if(!animation || !animation->frame_stream) {
+        return NULL;
+    }
+
+    uint8_t current_frame = model->current_frame;
+    uint8_t active_cycle = model->active_cycle;
+
+    for(size_t i = 0; i < PREFETCH_FRAMES; ++i) {
+        frames[i] = bubble_animation_get_icon_index(animation, current_frame);
+
+        if(current_frame < animation->passive_frames) {
+            current_frame = (current_frame + 1) % animation->passive_frames;
+        } else {
+            ++current_frame;
+            active_cycle +=
+                !((current_frame - animation->passive_frames) % animation->active_frames);
+            if(active_cycle >= animation->active_cycles) {
+                active_cycle = 0;
+                current_frame = 0;
+            }
+        }
+    }
+
+    return animation;
+}
+
+static void bubble_animation_prefetch_lock_callback(bool lock, void* context) {
+    furi_assert(context);
+    BubbleAnimationView* view = context;
+
+    if(lock) {
+        view_get_model(view->view);
+    } else {
+        view_commit_model(view->view, false);
+    }
+}
+
+static int32_t bubble_animation_prefetch_worker(void* context) {
+    furi_assert(context);
+    BubbleAnimationView* view = context;
+
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(
+            BUBBLE_ANIMATION_PREFETCH_FLAGS_ALL, FuriFlagWaitAny, FuriWaitForever);
+        furi_check((flags & FuriFlagError) == 0);
+        if(flags & BubbleAnimationPrefetchFlagStop) break;
+
+        furi_check(furi_mutex_acquire(view->prefetch_mutex, FuriWaitForever) == FuriStatusOk);
+
+        uint8_t frames[PREFETCH_FRAMES];
+        BubbleAnimationViewModel* model = view_get_model(view->view);
+        const BubbleAnimation* animation = bubble_animation_prefetch_plan(model, frames);
+        view_commit_model(view->view, false);
+
+        if(animation) {
+            animation_storage_prefetch_frames(
+                animation, frames, PREFETCH_FRAMES, bubble_animation_prefetch_lock_callback, view);
+        }
+
+        furi_check(furi_mutex_release(view->prefetch_mutex) == FuriStatusOk);
+    }
+
+    return 0;
+}
+
+static void bubble_animation_prefetch(BubbleAnimationView* view) {
+    furi_thread_flags_set(
+        furi_thread_get_id(view->prefetch_thread), BubbleAnimationPrefetchFlagLoad);
+}
+
+/* Wait for the prefetch of the previous animation, so it can be freed */
+static void bubble_animation_prefetch_sync(BubbleAnimationView* view) {
+    furi_check(furi_mutex_acquire(view->prefetch_mutex, FuriWaitForever) == FuriStatusOk);
+    furi_check(furi_mutex_release(view->prefetch_mutex) == FuriStatusOk);
+}
+
 static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     furi_assert(model_);
     furi_assert(canvas);
@@ -76,8 +177,12 @@ static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     uint8_t width = icon_get_width(&animation->icon_animation);
     uint8_t height = icon_get_height(&animation->icon_animation);
     uint8_t y_offset = canvas_height(canvas) - height;
-    canvas_draw_bitmap(
-        canvas, 0, y_offset, width, height, animation->icon_animation.frames[index]);
+    const uint8_t* frame = animation->icon_animation.frames[index];
+    if(!frame) {
+        /* streamed frame failed to load, frame 0 is always resident */
+        frame = animation->icon_animation.frames[0];
+    }
+    canvas_draw_bitmap(canvas, 0, y_offset, width, height, frame);
 
     const FrameBubble* bubble = model->current_bubble;
     if(bubble) {
@@ -179,15 +284,20 @@ static void bubble_animation_activate_right_now(BubbleAnimationView* view) {
     furi_assert(view);
 
     uint8_t frame_rate = 0;
+    bool prefetch = false;
 
     BubbleAnimationViewModel* model = view_get_model(view->view);
     if(model->current && (model->current->active_frames > 0) && (!model->freeze_frame)) {
         model->current_frame = model->current->passive_frames;
         model->current_bubble = bubble_animation_pick_bubble(model, true);
         frame_rate = model->current->icon_animation.frame_rate;
+        prefetch = (model->current->frame_stream != NULL);
     }
     view_commit_model(view->view, true);
 
+    if(prefetch) {
+        bubble_animation_prefetch(view);
+    }
     if(frame_rate) {
         furi_timer_start(view->timer, 1000 / frame_rate);
     }
@@ -227,6 +337,7 @@ static void bubble_animation_timer_callback(void* context) {
     furi_assert(context);
     BubbleAnimationView* view = context;
     bool activate = false;
+    bool prefetch = false;
 
     BubbleAnimationViewModel* model = view_get_model(view->view);
 
@@ -236,12 +347,15 @@ static void bubble_animation_timer_callback(void* context) {
 
     if(!model->freeze_frame && !activate) {
         bubble_animation_next_frame(model);
+        prefetch = model->current && model->current->frame_stream;
     }
 
     view_commit_model(view->view, !activate);
 
     if(activate) {
         bubble_animation_activate_right_now(view);
+    } else if(prefetch) {
+        bubble_animation_prefetch(view);
     }
 }
 
@@ -309,6 +423,10 @@ BubbleAnimationView* bubble_animation_view_alloc(void) {
     view->view = view_alloc();
     view->interact_callback = NULL;
     view->timer = furi_timer_alloc(bubble_animation_timer_callback, FuriTimerTypePeriodic, view);
+    view->prefetch_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    view->prefetch_thread = furi_thread_alloc_ex(
+        "AnimationPrefetch", PREFETCH_STACK_SIZE, bubble_animation_prefetch_worker, view);
+    furi_thread_set_priority(view->prefetch_thread, FuriThreadPriorityLow);
 
     view_allocate_model(view->view, ViewModelTypeLocking, sizeof(BubbleAnimationViewModel));
     view_set_context(view->view, view);
@@ -317,12 +435,20 @@ BubbleAnimationView* bubble_animation_view_alloc(void) {
     view_set_enter_callback(view->view, bubble_animation_enter);
     view_set_exit_callback(view->view, bubble_animation_exit);
 
+    furi_thread_start(view->prefetch_thread);
+
     return view;
 }
 
 void bubble_animation_view_free(BubbleAnimationView* view) {
     furi_assert(view);
 
+    furi_thread_flags_set(
+        furi_thread_get_id(view->prefetch_thread), BubbleAnimationPrefetchFlagStop);
+    furi_thread_join(view->prefetch_thread);
+    furi_thread_free(view->prefetch_thread);
+    furi_mutex_free(view->prefetch_mutex);
+
     view_set_draw_callback(view->view, NULL);
     view_set_input_callback(view->view, NULL);
     view_set_context(view->view, NULL);
@@ -369,6 +495,10 @@ void bubble_animation_view_set_animation(
     model->active_cycle = 0;
     view_commit_model(view->view, true);
 
+    bubble_animation_prefetch_sync(view);
+    if(new_animation->frame_stream) {
+        bubble_animation_prefetch(view);
+    }
     furi_timer_start(view->timer, 1000 / new_animation->icon_animation.frame_rate);
 }
 
@@ -382,6 +512,7 @@ void bubble_animation_freeze(BubbleAnimationView* view) {
     model->current = NULL;
     view_commit_model(view->view, false);
     furi_timer_stop(view->timer);
+    bubble_animation_prefetch_sync(view);
 }
 
 void bubble_animation_unfreeze(BubbleAnimationView* view) {
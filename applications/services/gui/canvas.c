@@ -18,6 +18,7 @@ const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
 Canvas* canvas_init(void) {
     Canvas* canvas = malloc(sizeof(Canvas));
     canvas->compress_icon = compress_icon_alloc(ICON_DECOMPRESSOR_BUFFER_SIZE);
+    CanvasIconCacheArray_init(canvas->icon_cache);
 
     // Initialize mutex
     canvas->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
@@ -28,6 +29,9 @@ Canvas* canvas_init(void) {
     // Setup u8g2
     u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
     canvas->orientation = CanvasOrientationHorizontal;
+    // Last frame sent to the display, first commit sends everything
+    canvas->commit_buffer = malloc(canvas_get_buffer_size(canvas));
+    canvas->commit_full = true;
     // Initialize display
     u8g2_InitDisplay(&canvas->fb);
     // Wake up display
@@ -43,8 +47,14 @@ Canvas* canvas_init(void) {
 void canvas_free(Canvas* canvas) {
     furi_check(canvas);
     compress_icon_free(canvas->compress_icon);
+    for
+        M_EACH(entry, canvas->icon_cache, CanvasIconCacheArray_t) {
+            free(entry->data);
+        }
+    CanvasIconCacheArray_clear(canvas->icon_cache);
     CanvasCallbackPairArray_clear(canvas->canvas_callback_pair);
     furi_mutex_free(canvas->mutex);
+    free(canvas->commit_buffer);
     free(canvas);
 }
 
@@ -68,12 +78,60 @@ void canvas_reset(Canvas* canvas) {
     canvas_set_font_direction(canvas, CanvasDirectionLeftToRight);
 }
 
+static bool canvas_commit_changed_tiles(Canvas* canvas) {
+    const uint8_t* buffer = canvas_get_buffer(canvas);
+    const size_t page_size = canvas->fb.pixel_buf_width;
+    const uint8_t page_count = u8g2_GetBufferTileHeight(&canvas->fb);
+    bool changed = false;
+
+    // Screen is redrawn from scratch every frame, so the dirty region is what differs from the
+    // last committed frame rather than what was drawn
+    for(uint8_t page = 0; page < page_count; page++) {
+        const uint8_t* line = &buffer[page * page_size];
+        uint8_t* committed = &canvas->commit_buffer[page * page_size];
+
+        size_t first = 0;
+        while(first < page_size && line[first] == committed[first]) first++;
+        if(first == page_size) continue;
+        size_t last = page_size;
+        while(line[last - 1] == committed[last - 1]) last--;
+
+        const uint8_t tx = first / 8;
+        const uint8_t tw = (last + 7) / 8 - tx;
+        u8g2_UpdateDisplayArea(&canvas->fb, tx, page, tw, 1);
+        memcpy(&committed[tx * 8], &line[tx * 8], tw * 8);
+        canvas->commit_stats.tiles += tw;
+        changed = true;
+    }
+
+    if(changed) u8x8_RefreshDisplay(u8g2_GetU8x8(&canvas->fb));
+
+    return changed;
+}
+
 void canvas_commit(Canvas* canvas) {
     furi_check(canvas);
-    u8g2_SendBuffer(&canvas->fb);
+    canvas->commit_stats.commits++;
+
+    bool changed = true;
+    if(canvas->commit_full) {
+        u8g2_SendBuffer(&canvas->fb);
+        memcpy(canvas->commit_buffer, canvas_get_buffer(canvas), canvas_get_buffer_size(canvas));
+        canvas->commit_stats.tiles +=
+            u8g2_GetBufferTileWidth(&canvas->fb) * u8g2_GetBufferTileHeight(&canvas->fb);
+        canvas->commit_full = false;
+    } else {
+        changed = canvas_commit_changed_tiles(canvas);
+    }
 
     // Iterate over callbacks
     canvas_lock(canvas);
+    if(!changed && !canvas->commit_notify) {
+        canvas->commit_stats.skipped++;
+        canvas_unlock(canvas);
+        return;
+    }
+    canvas->commit_notify = false;
     for
         M_EACH(p, canvas->canvas_callback_pair, CanvasCallbackPairArray_t) {
             p->callback(
@@ -263,6 +321,80 @@ size_t canvas_glyph_width(Canvas* canvas, uint16_t symbol) {
     return u8g2_GetGlyphWidth(&canvas->fb, symbol);
 }
 
+void canvas_get_icon_cache_stats(const Canvas* canvas, CanvasIconCacheStats* stats) {
+    furi_check(canvas);
+    furi_check(stats);
+    *stats = canvas->icon_cache_stats;
+}
+
+void canvas_get_commit_stats(const Canvas* canvas, CanvasCommitStats* stats) {
+    furi_check(canvas);
+    furi_check(stats);
+    *stats = canvas->commit_stats;
+}
+
+static void canvas_icon_cache_evict(Canvas* canvas, size_t size) {
+    while(canvas->icon_cache_stats.size + size > CANVAS_ICON_CACHE_SIZE) {
+        CanvasIconCacheEntry entry;
+        CanvasIconCacheArray_pop_back(&entry, canvas->icon_cache);
+        canvas->icon_cache_stats.size -= entry.size;
+        free(entry.data);
+    }
+}
+
+/** Decode icon frame, keeping recently drawn frames decoded
+ *
+ * Only frames stored in flash are cached: heap frames (applications, animations loaded from
+ * storage) can be freed and their address reused by different data.
+ */
+static const uint8_t* canvas_decode_icon(
+    Canvas* canvas,
+    const uint8_t* frame_data,
+    size_t width,
+    size_t height) {
+    uint8_t* decoded = NULL;
+    const size_t size = (width + 7) / 8 * height;
+    // First byte of frame data is the compression flag
+    const bool cacheable = frame_data[0] && size <= CANVAS_ICON_CACHE_ENTRY_SIZE_MAX &&
+                           (size_t)frame_data >= furi_hal_flash_get_base() &&
+                           (const void*)frame_data < furi_hal_flash_get_free_end_address();
+    if(!cacheable) {
+        compress_icon_decode(canvas->compress_icon, frame_data, &decoded);
+        return decoded;
+    }
+
+    size_t index = 0;
+    for
+        M_EACH(entry, canvas->icon_cache, CanvasIconCacheArray_t) {
+            if(entry->frame_data == frame_data && entry->size == size) {
+                CanvasIconCacheEntry hit = *entry;
+                if(index) {
+                    CanvasIconCacheArray_erase(canvas->icon_cache, index);
+                    CanvasIconCacheArray_push_at(canvas->icon_cache, 0, hit);
+                }
+                canvas->icon_cache_stats.hits++;
+                return hit.data;
+            }
+            index++;
+        }
+
+    canvas->icon_cache_stats.misses++;
+    compress_icon_decode(canvas->compress_icon, frame_data, &decoded);
+    canvas_icon_cache_evict(canvas, size);
+
+    CanvasIconCacheEntry entry = {
+        .frame_data = frame_data,
+        .data = malloc(size),
+        .size = size,
+    };
+    memcpy(entry.data, decoded, size);
+    CanvasIconCacheArray_push_at(canvas->icon_cache, 0, entry);
+    canvas->icon_cache_stats.size += size;
+    canvas->icon_cache_stats.entries = CanvasIconCacheArray_size(canvas->icon_cache);
+
+    return entry.data;
+}
+
 void canvas_draw_bitmap(
     Canvas* canvas,
     int32_t x,
@@ -274,8 +406,7 @@ void canvas_draw_bitmap(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* bitmap_data = NULL;
-    compress_icon_decode(canvas->compress_icon, compressed_bitmap_data, &bitmap_data);
+    const uint8_t* bitmap_data = canvas_decode_icon(canvas, compressed_bitmap_data, width, height);
     canvas_draw_u8g2_bitmap(&canvas->fb, x, y, width, height, bitmap_data, IconRotation0);
 }
 
@@ -289,9 +420,11 @@ void canvas_draw_icon_animation(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    compress_icon_decode(
-        canvas->compress_icon, icon_animation_get_data(icon_animation), &icon_data);
+    const uint8_t* icon_data = canvas_decode_icon(
+        canvas,
+        icon_animation_get_data(icon_animation),
+        icon_animation_get_width(icon_animation),
+        icon_animation_get_height(icon_animation));
     canvas_draw_u8g2_bitmap(
         &canvas->fb,
         x,
@@ -375,6 +508,133 @@ static void canvas_draw_u8g2_bitmap_int(
     }
 }
 
+#define CANVAS_BLIT_PAGES_MAX (8)
+
+typedef struct {
+    u8g2_t* u8g2;
+    uint8_t* buffer;
+    int32_t pages;
+    uint8_t page_clip[CANVAS_BLIT_PAGES_MAX];
+    uint8_t color;
+    bool transparent;
+} CanvasBlit;
+
+static bool canvas_blit_init(CanvasBlit* blit, u8g2_t* u8g2) {
+    // Direct framebuffer access is only valid without display rotation
+    if(u8g2->cb != U8G2_R0 || u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb) return false;
+    if(u8g2->tile_buf_height > CANVAS_BLIT_PAGES_MAX) return false;
+
+    blit->u8g2 = u8g2;
+    blit->buffer = u8g2->tile_buf_ptr;
+    blit->pages = u8g2->tile_buf_height;
+    blit->color = u8g2->draw_color;
+    blit->transparent = u8g2->bitmap_transparency != 0;
+
+    // Rows of each page inside of the user window, in buffer coordinates
+    int32_t clip_y0 = (int32_t)u8g2->user_y0 - u8g2->pixel_curr_row;
+    int32_t clip_y1 = (int32_t)u8g2->user_y1 - u8g2->pixel_curr_row;
+    for(int32_t page = 0; page < blit->pages; page++) {
+        int32_t lo = CLAMP(clip_y0 - page * 8, 8, 0);
+        int32_t hi = CLAMP(clip_y1 - page * 8, 8, 0);
+        blit->page_clip[page] = (uint8_t)((0xFFu << lo) & ~(0xFFu << hi));
+    }
+
+    return true;
+}
+
+// Apply a vertical strip of up to 8 pixels, LSB on top, spanning at most two pages
+static inline void canvas_blit_strip(
+    const CanvasBlit* blit,
+    int32_t x,
+    int32_t y,
+    uint8_t bits,
+    uint8_t mask) {
+    if(x < blit->u8g2->user_x0 || x >= blit->u8g2->user_x1) return;
+
+    y -= blit->u8g2->pixel_curr_row;
+    int32_t page = y >> 3;
+    uint32_t bits_word = (uint32_t)bits << (y & 7);
+    uint32_t mask_word = (uint32_t)mask << (y & 7);
+
+    for(; mask_word; page++, bits_word >>= 8, mask_word >>= 8) {
+        if(page < 0 || page >= blit->pages) continue;
+        uint8_t page_mask = mask_word & blit->page_clip[page];
+        if(!page_mask) continue;
+
+        uint8_t* ptr = &blit->buffer[page * blit->u8g2->pixel_buf_width + x];
+        uint8_t set = bits_word & page_mask;
+        uint8_t unset = blit->transparent ? 0 : (~bits_word & page_mask);
+        if(blit->color == 1) {
+            *ptr = (*ptr | set) & ~unset;
+        } else if(blit->color == 0) {
+            *ptr = (*ptr & ~set) | unset;
+        } else {
+            *ptr = (*ptr & ~unset) ^ set;
+        }
+    }
+}
+
+// 8x8 bit matrix transpose: bit c of byte r becomes bit r of byte c
+static inline uint64_t canvas_blit_transpose(uint64_t block) {
+    uint64_t t;
+    t = (block ^ (block >> 7)) & 0x00AA00AA00AA00AAULL;
+    block ^= t ^ (t << 7);
+    t = (block ^ (block >> 14)) & 0x0000CCCC0000CCCCULL;
+    block ^= t ^ (t << 14);
+    t = (block ^ (block >> 28)) & 0x00000000F0F0F0F0ULL;
+    block ^= t ^ (t << 28);
+    return block;
+}
+
+/** Draw bitmap straight into the page organized framebuffer
+ *
+ * Mirrors placement of canvas_draw_u8g2_bitmap_int for every mirror/rotation combination.
+ * Rotated rows are already vertical strips, others are transposed in 8x8 blocks.
+ */
+static void canvas_blit_bitmap(
+    const CanvasBlit* blit,
+    int32_t x,
+    int32_t y,
+    size_t w,
+    size_t h,
+    bool mirror,
+    bool rotation,
+    const uint8_t* bitmap) {
+    const size_t row_size = (w + 7) / 8;
+
+    if(rotation) {
+        for(size_t row = 0; row < h; row++) {
+            int32_t column = mirror ? x + (int32_t)row : x + (int32_t)w + 1 - (int32_t)row;
+            const uint8_t* data = &bitmap[row * row_size];
+            for(size_t byte = 0; byte < row_size; byte++) {
+                size_t left = w - byte * 8;
+                uint8_t mask = left >= 8 ? 0xFF : (1u << left) - 1;
+                canvas_blit_strip(blit, column, y + (int32_t)byte * 8, data[byte], mask);
+            }
+        }
+    } else {
+        for(size_t top = 0; top < h; top += 8) {
+            size_t rows = MIN(h - top, 8u);
+            uint8_t mask = rows == 8 ? 0xFF : (1u << rows) - 1;
+            for(size_t byte = 0; byte < row_size; byte++) {
+                uint64_t block = 0;
+                for(size_t i = 0; i < rows; i++) {
+                    size_t row = mirror ? h - 1 - (top + i) : top + i;
+                    block |= (uint64_t)bitmap[row * row_size + byte] << (i * 8);
+                }
+                block = canvas_blit_transpose(block);
+
+                size_t columns = MIN(w - byte * 8, 8u);
+                int32_t column = x + (int32_t)byte * 8;
+                for(size_t i = 0; i < columns; i++) {
+                    canvas_blit_strip(
+                        blit, column + (int32_t)i, y + (int32_t)top, block >> (i * 8), mask);
+                }
+            }
+        }
+    }
+}
+
 void canvas_draw_u8g2_bitmap(
     u8g2_t* u8g2,
     int32_t x,
@@ -387,22 +647,23 @@ void canvas_draw_u8g2_bitmap(
     if(u8g2_IsIntersection(u8g2, x, y, x + width, y + height) == 0) return;
 #endif /* U8G2_WITH_INTERSECTION */
 
-    switch(rotation) {
-    case IconRotation0:
-        canvas_draw_u8g2_bitmap_int(u8g2, x, y, width, height, 0, 0, bitmap);
-        break;
-    case IconRotation90:
-        canvas_draw_u8g2_bitmap_int(u8g2, x, y, width, height, 0, 1, bitmap);
-        break;
-    case IconRotation180:
-        canvas_draw_u8g2_bitmap_int(u8g2, x, y, width, height, 1, 0, bitmap);
-        break;
-    case IconRotation270:
-        canvas_draw_u8g2_bitmap_int(u8g2, x, y, width, height, 1, 1, bitmap);
-        break;
-    default:
-        break;
+    if(rotation > IconRotation270) return;
+    bool mirror = rotation == IconRotation180 || rotation == IconRotation270;
+    bool rotate = rotation == IconRotation90 || rotation == IconRotation270;
+
+    CanvasBlit blit;
+    if(!canvas_blit_init(&blit, u8g2)) {
+        canvas_draw_u8g2_bitmap_int(u8g2, x, y, width, height, mirror, rotate, bitmap);
+        return;
     }
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+    if(u8g2->is_page_clip_window_intersection == 0) return;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+
+    // Same coordinate wraparound as u8g2_uint_t arithmetic
+    x = (u8g2_int_t)(u8g2_uint_t)x;
+    y = (u8g2_int_t)(u8g2_uint_t)y;
+    canvas_blit_bitmap(&blit, x, y, width, height, mirror, rotate, bitmap);
 }
 
 void canvas_draw_icon_ex(
@@ -416,8 +677,8 @@ void canvas_draw_icon_ex(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    compress_icon_decode(canvas->compress_icon, icon_get_frame_data(icon, 0), &icon_data);
+    const uint8_t* icon_data = canvas_decode_icon(
+        canvas, icon_get_frame_data(icon, 0), icon_get_width(icon), icon_get_height(icon));
     canvas_draw_u8g2_bitmap(
         &canvas->fb, x, y, icon_get_width(icon), icon_get_height(icon), icon_data, rotation);
 }
@@ -428,8 +689,8 @@ void canvas_draw_icon(Canvas* canvas, int32_t x, int32_t y, const Icon* icon) {
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    compress_icon_decode(canvas->compress_icon, icon_get_frame_data(icon, 0), &icon_data);
+    const uint8_t* icon_data = canvas_decode_icon(
+        canvas, icon_get_frame_data(icon, 0), icon_get_width(icon), icon_get_height(icon));
     canvas_draw_u8g2_bitmap(
         &canvas->fb, x, y, icon_get_width(icon), icon_get_height(icon), icon_data, IconRotation0);
 }
@@ -603,6 +864,8 @@ void canvas_add_framebuffer_callback(Canvas* canvas, CanvasCommitCallback callba
     canvas_lock(canvas);
     furi_check(!CanvasCallbackPairArray_count(canvas->canvas_callback_pair, p));
     CanvasCallbackPairArray_push_back(canvas->canvas_callback_pair, p);
+    // New consumer needs a frame even if the screen does not change
+    canvas->commit_notify = true;
     canvas_unlock(canvas);
 }
 
@@ -14,6 +14,11 @@
 
 #define ICON_DECOMPRESSOR_BUFFER_SIZE (128u * 64 / 8)
 
+/** Byte budget of decoded icon frames kept by the canvas */
+#define CANVAS_ICON_CACHE_SIZE (4096u)
+/** Bigger frames are decoded on every draw */
+#define CANVAS_ICON_CACHE_ENTRY_SIZE_MAX (1024u)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -35,6 +40,28 @@ ARRAY_DEF(CanvasCallbackPairArray, CanvasCallbackPair, M_POD_OPLIST);
 
 ALGO_DEF(CanvasCallbackPairArray, CanvasCallbackPairArray_t);
 
+typedef struct {
+    const uint8_t* frame_data;
+    uint8_t* data;
+    size_t size;
+} CanvasIconCacheEntry;
+
+/* Most recently used entry first */
+ARRAY_DEF(CanvasIconCacheArray, CanvasIconCacheEntry, M_POD_OPLIST);
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    size_t entries;
+    size_t size;
+} CanvasIconCacheStats;
+
+typedef struct {
+    uint32_t commits;
+    uint32_t skipped;
+    uint32_t tiles;
+} CanvasCommitStats;
+
 /** Canvas structure
  */
 struct Canvas {
@@ -45,6 +72,12 @@ struct Canvas {
     size_t width;
     size_t height;
     CompressIcon* compress_icon;
+    CanvasIconCacheArray_t icon_cache;
+    CanvasIconCacheStats icon_cache_stats;
+    uint8_t* commit_buffer;
+    bool commit_full;
+    bool commit_notify;
+    CanvasCommitStats commit_stats;
     CanvasCallbackPairArray_t canvas_callback_pair;
     FuriMutex* mutex;
 };
@@ -107,6 +140,20 @@ void canvas_set_orientation(Canvas* canvas, CanvasOrientation orientation);
  */
 CanvasOrientation canvas_get_orientation(const Canvas* canvas);
 
+/** Get decoded icon cache statistics
+ *
+ * @param      canvas  Canvas instance
+ * @param      stats   CanvasIconCacheStats to fill
+ */
+void canvas_get_icon_cache_stats(const Canvas* canvas, CanvasIconCacheStats* stats);
+
+/** Get display commit statistics
+ *
+ * @param      canvas  Canvas instance
+ * @param      stats   CanvasCommitStats to fill
+ */
+void canvas_get_commit_stats(const Canvas* canvas, CanvasCommitStats* stats);
+
 /** Draw a u8g2 bitmap
  *
  * @param      u8g2     u8g2 instance
@@ -3,6 +3,9 @@
 #include <furi.h>
 #include <furi_hal.h>
 #include <furi_hal_rtc.h>
+#ifdef SRV_CLI
+#include <cli/cli.h>
+#endif
 //#include <storage/storage.h>
 //#include <storage/storage_i.h>
 
@@ -662,6 +665,48 @@ void gui_direct_draw_release(Gui* gui) {
     gui_update(gui);
 }
 
+#ifdef SRV_CLI
+static void gui_cli(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    Gui* gui = context;
+
+    if(furi_string_cmp_str(args, "icon_cache") == 0) {
+        // Snapshot, canvas is updated by GUI thread under the lock
+        CanvasIconCacheStats stats;
+        gui_lock(gui);
+        canvas_get_icon_cache_stats(gui->canvas, &stats);
+        gui_unlock(gui);
+        uint64_t lookups = (uint64_t)stats.hits + stats.misses;
+        printf(
+            "Entries: %zu, size: %zu/%u bytes\r\n",
+            stats.entries,
+            stats.size,
+            CANVAS_ICON_CACHE_SIZE);
+        printf(
+            "Hits: %lu, misses: %lu, hit rate: %lu%%\r\n",
+            stats.hits,
+            stats.misses,
+            lookups ? (uint32_t)((uint64_t)stats.hits * 100 / lookups) : 0);
+    } else if(furi_string_cmp_str(args, "commit") == 0) {
+        CanvasCommitStats stats;
+        gui_lock(gui);
+        canvas_get_commit_stats(gui->canvas, &stats);
+        gui_unlock(gui);
+        printf("Commits: %lu, unchanged: %lu\r\n", stats.commits, stats.skipped);
+        printf(
+            "Tiles sent: %lu, per commit: %lu\r\n",
+            stats.tiles,
+            stats.commits ? stats.tiles / stats.commits : 0);
+    } else {
+        printf("Usage:\r\n");
+        printf("gui <cmd>\r\n");
+        printf("Cmd list:\r\n");
+        printf("\ticon_cache\t - decoded icon cache statistics\r\n");
+        printf("\tcommit\t\t - display commit statistics\r\n");
+    }
+}
+#endif
+
 Gui* gui_alloc(void) {
     Gui* gui = malloc(sizeof(Gui));
     // Thread ID
@@ -698,6 +743,12 @@ int32_t gui_srv(void* p) {
 
     furi_record_create(RECORD_GUI, gui);
 
+#ifdef SRV_CLI
+    Cli* cli = furi_record_open(RECORD_CLI);
+    cli_add_command(cli, "gui", CliCommandFlagParallelSafe, gui_cli, gui);
+    furi_record_close(RECORD_CLI);
+#endif
+
     while(1) {
         uint32_t flags =
             furi_thread_flags_wait(GUI_THREAD_FLAG_ALL, FuriFlagWaitAny, FuriWaitForever);
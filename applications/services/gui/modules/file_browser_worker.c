@@ -4,11 +4,13 @@
 #include <storage/storage.h>
 
 #include <toolbox/path.h>
+#include <cfw/cfw.h>
 #include <core/check.h>
 #include <core/common_defines.h>
 #include <furi.h>
 
 #include <m-array.h>
+#include <m-algo.h>
 #include <stdbool.h>
 #include <stddef.h>
 
@@ -145,6 +147,335 @@ static bool browser_filter_by_name(BrowserWorker* browser, FuriString* name, boo
     return false;
 }
 
+// Directory listings are cached between folder loads and shared by all workers. A listing is
+// validated against the storage directory change counter and is kept sorted, so it can be
+// paged in order regardless of the folder size.
+#define BROWSER_CACHE_DIRS_MAX 4
+#define BROWSER_CACHE_UNCACHEABLE_MAX 4
+#define BROWSER_CACHE_MEMORY_MAX (64 * 1024)
+#define BROWSER_CACHE_NAMES_BLOCK 1024
+
+typedef struct BrowserCacheNames BrowserCacheNames;
+
+struct BrowserCacheNames {
+    BrowserCacheNames* next;
+    size_t used;
+    char data[BROWSER_CACHE_NAMES_BLOCK];
+};
+
+typedef struct {
+    const char* name;
+    bool is_dir;
+} BrowserCacheEntry;
+
+static int browser_cache_entry_cmp(const BrowserCacheEntry* a, const BrowserCacheEntry* b) {
+    if(cfw_settings.sort_dirs_first && (a->is_dir != b->is_dir)) {
+        return a->is_dir ? -1 : 1;
+    }
+
+    return strcasecmp(a->name, b->name);
+}
+
+static bool browser_cache_entry_equal(const BrowserCacheEntry* a, const BrowserCacheEntry* b) {
+    return (a->name == b->name) && (a->is_dir == b->is_dir);
+}
+
+#define M_OPL_BrowserCacheEntry_t()              \
+    M_OPEXTEND(                                  \
+        M_POD_OPLIST,                            \
+        CMP(API_6(browser_cache_entry_cmp)),     \
+        EQUAL(API_6(browser_cache_entry_equal)))
+
+ARRAY_DEF(BrowserCacheEntryArray, BrowserCacheEntry, M_OPL_BrowserCacheEntry_t())
+ALGO_DEF(
+    BrowserCacheEntryArray,
+    ARRAY_OPLIST(BrowserCacheEntryArray, M_OPL_BrowserCacheEntry_t()))
+
+typedef struct {
+    FuriString* path;
+    uint32_t generation;
+    uint32_t last_used;
+    bool dirs_first;
+    size_t memory;
+    BrowserCacheNames* names;
+    BrowserCacheEntryArray_t entries;
+} BrowserCacheDir;
+
+typedef struct {
+    FuriString* path;
+    uint32_t generation;
+} BrowserCacheUncacheable;
+
+static struct {
+    FuriMutex* mutex;
+    size_t users;
+    uint32_t clock;
+    BrowserCacheDir* dirs[BROWSER_CACHE_DIRS_MAX];
+    // Folders too big for the cache, so they are not listed twice on every load
+    BrowserCacheUncacheable uncacheable[BROWSER_CACHE_UNCACHEABLE_MAX];
+    size_t uncacheable_next;
+} browser_cache;
+
+static void browser_cache_dir_free(BrowserCacheDir* dir) {
+    while(dir->names) {
+        BrowserCacheNames* next = dir->names->next;
+        free(dir->names);
+        dir->names = next;
+    }
+    BrowserCacheEntryArray_clear(dir->entries);
+    furi_string_free(dir->path);
+    free(dir);
+}
+
+static void browser_cache_acquire(void) {
+    FuriMutex* mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+
+    FURI_CRITICAL_ENTER();
+    if(!browser_cache.mutex) {
+        browser_cache.mutex = mutex;
+        mutex = NULL;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(mutex) {
+        furi_mutex_free(mutex);
+    }
+
+    furi_check(furi_mutex_acquire(browser_cache.mutex, FuriWaitForever) == FuriStatusOk);
+    browser_cache.users++;
+    furi_check(furi_mutex_release(browser_cache.mutex) == FuriStatusOk);
+}
+
+static void browser_cache_release(void) {
+    furi_check(furi_mutex_acquire(browser_cache.mutex, FuriWaitForever) == FuriStatusOk);
+    furi_check(browser_cache.users > 0);
+
+    // Listings are dropped together with the last worker, so they don't outlive the app
+    if(--browser_cache.users == 0) {
+        for(size_t i = 0; i < BROWSER_CACHE_DIRS_MAX; i++) {
+            if(browser_cache.dirs[i]) {
+                browser_cache_dir_free(browser_cache.dirs[i]);
+                browser_cache.dirs[i] = NULL;
+            }
+        }
+        for(size_t i = 0; i < BROWSER_CACHE_UNCACHEABLE_MAX; i++) {
+            if(browser_cache.uncacheable[i].path) {
+                furi_string_free(browser_cache.uncacheable[i].path);
+                browser_cache.uncacheable[i].path = NULL;
+            }
+        }
+        browser_cache.uncacheable_next = 0;
+    }
+
+    furi_check(furi_mutex_release(browser_cache.mutex) == FuriStatusOk);
+}
+
+static const char* browser_cache_dir_add_name(BrowserCacheDir* dir, const char* name) {
+    size_t size = strlen(name) + 1;
+    furi_check(size <= BROWSER_CACHE_NAMES_BLOCK);
+
+    if(!dir->names || (dir->names->used + size > BROWSER_CACHE_NAMES_BLOCK)) {
+        BrowserCacheNames* names = malloc(sizeof(BrowserCacheNames));
+        names->next = dir->names;
+        dir->names = names;
+        dir->memory += sizeof(BrowserCacheNames);
+    }
+
+    char* cached_name = &dir->names->data[dir->names->used];
+    memcpy(cached_name, name, size);
+    dir->names->used += size;
+
+    return cached_name;
+}
+
+static BrowserCacheDir*
+    browser_cache_dir_load(BrowserWorker* browser, FuriString* path, uint32_t generation) {
+    // Keep enough heap for the app, a folder that doesn't fit is listed without the cache
+    const size_t memory_max = MIN(BROWSER_CACHE_MEMORY_MAX, memmgr_heap_get_max_free_block() / 2);
+
+    BrowserCacheDir* dir = malloc(sizeof(BrowserCacheDir));
+    dir->path = furi_string_alloc_set(path);
+    dir->generation = generation;
+    dir->dirs_first = cfw_settings.sort_dirs_first;
+    BrowserCacheEntryArray_init(dir->entries);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* directory = storage_file_alloc(storage);
+
+    FileInfo file_info;
+    char name_temp[FILE_NAME_LEN_MAX];
+    uint32_t total_files_cnt = 0;
+    bool fits = false;
+
+    if(storage_dir_open(directory, furi_string_get_cstr(path))) {
+        fits = true;
+        while(storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if((storage_file_get_error(directory) != FSE_OK) || (name_temp[0] == '\0')) {
+                continue;
+            }
+
+            BrowserCacheEntry* entry = BrowserCacheEntryArray_push_new(dir->entries);
+            entry->name = browser_cache_dir_add_name(dir, name_temp);
+            entry->is_dir = file_info_is_dir(&file_info);
+
+            total_files_cnt++;
+            if(total_files_cnt == LONG_LOAD_THRESHOLD) {
+                // Listing a big folder takes some time - send callback to app
+                if(browser->long_load_cb) {
+                    browser->long_load_cb(browser->cb_ctx);
+                }
+            }
+
+            const size_t memory = dir->memory +
+                                  BrowserCacheEntryArray_capacity(dir->entries) *
+                                      sizeof(BrowserCacheEntry);
+            if(memory > memory_max) {
+                fits = false;
+                break;
+            }
+        }
+    }
+
+    storage_dir_close(directory);
+    storage_file_free(directory);
+    furi_record_close(RECORD_STORAGE);
+
+    if(!fits) {
+        FURI_LOG_D(TAG, "Not cached: %s", furi_string_get_cstr(path));
+        browser_cache_dir_free(dir);
+        return NULL;
+    }
+
+    BrowserCacheEntryArray_sort(dir->entries);
+    FURI_LOG_D(
+        TAG,
+        "Cached: %s items: %zu",
+        furi_string_get_cstr(path),
+        BrowserCacheEntryArray_size(dir->entries));
+
+    return dir;
+}
+
+static bool browser_cache_is_uncacheable(FuriString* path, uint32_t generation) {
+    for(size_t i = 0; i < BROWSER_CACHE_UNCACHEABLE_MAX; i++) {
+        const BrowserCacheUncacheable* entry = &browser_cache.uncacheable[i];
+        if(entry->path && (entry->generation == generation) &&
+           (furi_string_cmp(entry->path, path) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void browser_cache_set_uncacheable(FuriString* path, uint32_t generation) {
+    BrowserCacheUncacheable* entry = NULL;
+    for(size_t i = 0; i < BROWSER_CACHE_UNCACHEABLE_MAX; i++) {
+        if(browser_cache.uncacheable[i].path &&
+           (furi_string_cmp(browser_cache.uncacheable[i].path, path) == 0)) {
+            entry = &browser_cache.uncacheable[i];
+            break;
+        }
+    }
+
+    if(!entry) {
+        // Replace the oldest one
+        entry = &browser_cache.uncacheable[browser_cache.uncacheable_next];
+        browser_cache.uncacheable_next =
+            (browser_cache.uncacheable_next + 1) % BROWSER_CACHE_UNCACHEABLE_MAX;
+        if(entry->path) {
+            furi_string_set(entry->path, path);
+        } else {
+            entry->path = furi_string_alloc_set(path);
+        }
+    }
+
+    entry->generation = generation;
+}
+
+/** Get the sorted listing of a folder, loading it if it is missing or outdated.
+ * Returns NULL if the folder can't be cached. Otherwise the cache stays locked until
+ * browser_cache_unlock is called.
+ */
+static BrowserCacheDir* browser_cache_lock(BrowserWorker* browser, FuriString* path) {
+    uint32_t generation;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FS_Error error =
+        storage_common_dir_generation(storage, furi_string_get_cstr(path), &generation);
+    furi_record_close(RECORD_STORAGE);
+
+    if(error != FSE_OK) {
+        return NULL;
+    }
+
+    furi_check(furi_mutex_acquire(browser_cache.mutex, FuriWaitForever) == FuriStatusOk);
+
+    size_t slot = 0;
+    BrowserCacheDir* dir = NULL;
+
+    for(size_t i = 0; i < BROWSER_CACHE_DIRS_MAX; i++) {
+        BrowserCacheDir* candidate = browser_cache.dirs[i];
+        if(candidate && (furi_string_cmp(candidate->path, path) == 0)) {
+            slot = i;
+            dir = candidate;
+            break;
+        }
+        // Otherwise reuse an empty or the least recently used slot
+        if(!candidate) {
+            slot = i;
+        } else if(
+            browser_cache.dirs[slot] &&
+            (candidate->last_used < browser_cache.dirs[slot]->last_used)) {
+            slot = i;
+        }
+    }
+
+    if(dir && (dir->generation != generation)) {
+        browser_cache.dirs[slot] = NULL;
+        browser_cache_dir_free(dir);
+        dir = NULL;
+    }
+
+    if(!dir) {
+        if(!browser_cache_is_uncacheable(path, generation)) {
+            dir = browser_cache_dir_load(browser, path, generation);
+        }
+
+        if(!dir) {
+            browser_cache_set_uncacheable(path, generation);
+        } else {
+            // Evict only when there is a listing to replace it with
+            if(browser_cache.dirs[slot]) {
+                browser_cache_dir_free(browser_cache.dirs[slot]);
+            }
+            browser_cache.dirs[slot] = dir;
+        }
+    } else if(dir->dirs_first != cfw_settings.sort_dirs_first) {
+        dir->dirs_first = cfw_settings.sort_dirs_first;
+        BrowserCacheEntryArray_sort(dir->entries);
+    }
+
+    if(!dir) {
+        furi_check(furi_mutex_release(browser_cache.mutex) == FuriStatusOk);
+        return NULL;
+    }
+
+    dir->last_used = ++browser_cache.clock;
+
+    return dir;
+}
+
+static void browser_cache_unlock(void) {
+    furi_check(furi_mutex_release(browser_cache.mutex) == FuriStatusOk);
+}
+
+static bool browser_cache_filter(
+    BrowserWorker* browser,
+    const BrowserCacheEntry* entry,
+    FuriString* name_str) {
+    furi_string_set(name_str, entry->name);
+    return browser_filter_by_name(browser, name_str, entry->is_dir);
+}
+
 static bool browser_folder_check_and_switch(FuriString* path) {
     FileInfo file_info;
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -170,6 +501,38 @@ static bool browser_folder_check_and_switch(FuriString* path) {
     return is_root;
 }
 
+static bool browser_folder_init_cached(
+    BrowserWorker* browser,
+    FuriString* path,
+    FuriString* filename,
+    uint32_t* item_cnt,
+    int32_t* file_idx) {
+    BrowserCacheDir* dir = browser_cache_lock(browser, path);
+    if(!dir) {
+        return false;
+    }
+
+    FuriString* name_str = furi_string_alloc();
+
+    BrowserCacheEntryArray_it_t it;
+    for(BrowserCacheEntryArray_it(it, dir->entries); !BrowserCacheEntryArray_end_p(it);
+        BrowserCacheEntryArray_next(it)) {
+        if(browser_cache_filter(browser, BrowserCacheEntryArray_cref(it), name_str)) {
+            if(!furi_string_empty(filename)) {
+                if(furi_string_cmp(name_str, filename) == 0) {
+                    *file_idx = *item_cnt;
+                }
+            }
+            (*item_cnt)++;
+        }
+    }
+
+    furi_string_free(name_str);
+    browser_cache_unlock();
+
+    return true;
+}
+
 static bool browser_folder_init(
     BrowserWorker* browser,
     FuriString* path,
@@ -190,7 +553,9 @@ static bool browser_folder_init(
     *item_cnt = 0;
     *file_idx = -1;
 
-    if(storage_dir_open(directory, furi_string_get_cstr(path))) {
+    if(browser_folder_init_cached(browser, path, filename, item_cnt, file_idx)) {
+        state = true;
+    } else if(storage_dir_open(directory, furi_string_get_cstr(path))) {
         state = true;
         while(1) {
             if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
@@ -227,7 +592,59 @@ static bool browser_folder_init(
     return state;
 }
 
-// Load files list by chunks, like it was originally, not compatible with sorting, sorting needs to be disabled to use this
+// Load files list from the sorted cached snapshot, both in chunks and at once
+static bool browser_folder_load_cached(
+    BrowserWorker* browser,
+    FuriString* path,
+    uint32_t offset,
+    uint32_t count) {
+    BrowserCacheDir* dir = browser_cache_lock(browser, path);
+    if(!dir) {
+        return false;
+    }
+
+    FuriString* name_str = furi_string_alloc();
+
+    uint32_t items_cnt = 0;
+    BrowserCacheEntryArray_it_t it;
+    BrowserCacheEntryArray_it(it, dir->entries);
+
+    while((items_cnt < offset) && !BrowserCacheEntryArray_end_p(it)) {
+        if(browser_cache_filter(browser, BrowserCacheEntryArray_cref(it), name_str)) {
+            items_cnt++;
+        }
+        BrowserCacheEntryArray_next(it);
+    }
+
+    if(items_cnt == offset) {
+        if(browser->list_load_cb) {
+            browser->list_load_cb(browser->cb_ctx, offset);
+        }
+
+        items_cnt = 0;
+        while((items_cnt < count) && !BrowserCacheEntryArray_end_p(it)) {
+            const BrowserCacheEntry* entry = BrowserCacheEntryArray_cref(it);
+            if(browser_cache_filter(browser, entry, name_str)) {
+                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), entry->name);
+                if(browser->list_item_cb) {
+                    browser->list_item_cb(browser->cb_ctx, name_str, entry->is_dir, false);
+                }
+                items_cnt++;
+            }
+            BrowserCacheEntryArray_next(it);
+        }
+        if(browser->list_item_cb) {
+            browser->list_item_cb(browser->cb_ctx, NULL, false, true);
+        }
+    }
+
+    furi_string_free(name_str);
+    browser_cache_unlock();
+
+    return true;
+}
+
+// Load files list by chunks, like it was originally, not compatible with sorting, used for folders that are too big to be cached
 static bool browser_folder_load_chunked(
     BrowserWorker* browser,
     FuriString* path,
@@ -474,9 +891,12 @@ static int32_t browser_worker(void* context) {
             FURI_LOG_D(
                 TAG, "Load offset: %lu cnt: %lu", browser->load_offset, browser->load_count);
             if(items_cnt > BROWSER_SORT_THRESHOLD) {
-                browser_folder_load_chunked(
-                    browser, path, browser->load_offset, browser->load_count);
-            } else {
+                if(!browser_folder_load_cached(
+                       browser, path, browser->load_offset, browser->load_count)) {
+                    browser_folder_load_chunked(
+                        browser, path, browser->load_offset, browser->load_count);
+                }
+            } else if(!browser_folder_load_cached(browser, path, 0, UINT32_MAX)) {
                 browser_folder_load_full(browser, path);
             }
         }
@@ -516,6 +936,8 @@ BrowserWorker* file_browser_worker_alloc(
         furi_string_set_str(browser->path_start, base_path);
     }
 
+    browser_cache_acquire();
+
     browser->thread = furi_thread_alloc_ex("BrowserWorker", 2048, browser_worker, browser);
     furi_thread_start(browser->thread);
 
@@ -529,6 +951,8 @@ void file_browser_worker_free(BrowserWorker* browser) {
     furi_thread_join(browser->thread);
     furi_thread_free(browser->thread);
 
+    browser_cache_release();
+
     furi_string_free(browser->path_next);
     furi_string_free(browser->path_current);
     furi_string_free(browser->path_start);
@@ -19,6 +19,9 @@
 
 #define TAG "RpcSrv"
 
+#define RPC_WORKER_QUEUE_SIZE 8
+#define RPC_WORKER_STACK_SIZE 3072
+
 typedef enum {
     RpcEvtNewData = (1 << 0),
     RpcEvtDisconnect = (1 << 1),
@@ -84,11 +87,35 @@ struct RpcSession {
     RpcSessionTerminatedCallback terminated_callback;
     RpcOwner owner;
     void* context;
+
+    size_t storage_chunk_size;
+    size_t storage_window;
+    /* Reused for encoding, guarded by callbacks_mutex */
+    uint8_t* send_buffer;
+    size_t send_buffer_size;
+
+    /* Messages handed to worker and not processed yet, session thread only */
+    size_t jobs_pending;
+    /* Released by worker as its last access to the session */
+    FuriSemaphore* job_done;
 };
 
+typedef struct {
+    RpcSession* session;
+    RpcHandler handler;
+    PB_Main* message;
+} RpcJob;
+
 struct Rpc {
-    FuriMutex* busy_mutex;
+    /* Taken by session thread in message order, released by whoever ran the handler */
+    FuriSemaphore* domain_semaphore[RpcDomainCount];
     size_t sessions_count;
+
+    /* Worker runs while there are sessions, guarded by worker_mutex */
+    FuriMutex* worker_mutex;
+    size_t worker_users;
+    FuriMessageQueue* jobs;
+    FuriThread* worker;
 };
 
 RpcOwner rpc_session_get_owner(RpcSession* session) {
@@ -156,6 +183,24 @@ void rpc_session_set_terminated_callback(
     furi_mutex_release(session->callbacks_mutex);
 }
 
+void rpc_session_set_storage_transfer(RpcSession* session, size_t chunk_size, size_t window) {
+    furi_check(session);
+
+    furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
+    session->storage_chunk_size = CLAMP(chunk_size, RPC_STORAGE_CHUNK_SIZE_MAX, 1U);
+    session->storage_window = CLAMP(window, RPC_STORAGE_WINDOW_MAX, 1U);
+    furi_mutex_release(session->callbacks_mutex);
+}
+
+void rpc_session_get_storage_transfer(RpcSession* session, size_t* chunk_size, size_t* window) {
+    furi_assert(session);
+
+    furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
+    *chunk_size = session->storage_chunk_size;
+    *window = session->storage_window;
+    furi_mutex_release(session->callbacks_mutex);
+}
+
 /* Doesn't forbid using rpc_feed_bytes() after session close - it's safe.
  * Because any bytes received in buffer will be flushed before next session.
  * If bytes get into stream buffer before it's get emptied and this
@@ -252,10 +297,110 @@ static bool rpc_pb_content_callback(pb_istream_t* stream, const pb_field_t* fiel
     return true;
 }
 
+static int32_t rpc_worker(void* context) {
+    Rpc* rpc = context;
+    RpcJob job;
+
+    while(true) {
+        furi_check(furi_message_queue_get(rpc->jobs, &job, FuriWaitForever) == FuriStatusOk);
+
+        /* Job without session stops the worker */
+        if(!job.session) break;
+
+        job.handler.message_handler(job.message, job.handler.context);
+        furi_check(
+            furi_semaphore_release(rpc->domain_semaphore[job.handler.domain]) == FuriStatusOk);
+
+        pb_release(&PB_Main_msg, job.message);
+        free(job.message);
+
+        /* Session may be freed right after this */
+        furi_check(furi_semaphore_release(job.session->job_done) == FuriStatusOk);
+    }
+
+    return 0;
+}
+
+/* Only storage domain is long running and its semaphore is taken before
+ * queueing, so one worker is enough */
+static void rpc_worker_acquire(Rpc* rpc) {
+    furi_check(furi_mutex_acquire(rpc->worker_mutex, FuriWaitForever) == FuriStatusOk);
+
+    if(rpc->worker_users++ == 0) {
+        rpc->jobs = furi_message_queue_alloc(RPC_WORKER_QUEUE_SIZE, sizeof(RpcJob));
+        rpc->worker = furi_thread_alloc_ex("RpcWorker", RPC_WORKER_STACK_SIZE, rpc_worker, rpc);
+        furi_thread_start(rpc->worker);
+    }
+
+    furi_check(furi_mutex_release(rpc->worker_mutex) == FuriStatusOk);
+}
+
+static void rpc_worker_release(Rpc* rpc) {
+    furi_check(furi_mutex_acquire(rpc->worker_mutex, FuriWaitForever) == FuriStatusOk);
+
+    furi_check(rpc->worker_users);
+    if(--rpc->worker_users == 0) {
+        RpcJob stop = {0};
+        furi_check(furi_message_queue_put(rpc->jobs, &stop, FuriWaitForever) == FuriStatusOk);
+        furi_thread_join(rpc->worker);
+        furi_thread_free(rpc->worker);
+        furi_message_queue_free(rpc->jobs);
+        rpc->worker = NULL;
+        rpc->jobs = NULL;
+    }
+
+    furi_check(furi_mutex_release(rpc->worker_mutex) == FuriStatusOk);
+}
+
+static PB_Main* rpc_session_alloc_decoded_message(RpcSession* session) {
+    PB_Main* message = malloc(sizeof(PB_Main));
+    message->cb_content.funcs.decode = rpc_pb_content_callback;
+    message->cb_content.arg = session;
+    return message;
+}
+
+static void rpc_session_process_message(RpcSession* session, RpcHandler* handler) {
+    Rpc* rpc = session->rpc;
+
+    /* Domain is taken here in message order, so messages of one domain are
+     * processed in the order they came even when handled by worker */
+    furi_check(
+        furi_semaphore_acquire(rpc->domain_semaphore[handler->domain], FuriWaitForever) ==
+        FuriStatusOk);
+
+    if(handler->long_running) {
+        RpcJob job = {
+            .session = session,
+            .handler = *handler,
+            .message = session->decoded_message,
+        };
+        session->decoded_message = rpc_session_alloc_decoded_message(session);
+
+        /* Collect finished jobs, so job_done never exceeds its max count */
+        while(furi_semaphore_acquire(session->job_done, 0) == FuriStatusOk) {
+            furi_check(session->jobs_pending);
+            session->jobs_pending--;
+        }
+
+        session->jobs_pending++;
+        furi_check(furi_message_queue_put(rpc->jobs, &job, FuriWaitForever) == FuriStatusOk);
+    } else {
+        handler->message_handler(session->decoded_message, handler->context);
+        furi_check(
+            furi_semaphore_release(rpc->domain_semaphore[handler->domain]) == FuriStatusOk);
+    }
+}
+
+static void rpc_session_wait_jobs(RpcSession* session) {
+    while(session->jobs_pending) {
+        furi_check(furi_semaphore_acquire(session->job_done, FuriWaitForever) == FuriStatusOk);
+        session->jobs_pending--;
+    }
+}
+
 static int32_t rpc_session_worker(void* context) {
     furi_assert(context);
     RpcSession* session = (RpcSession*)context;
-    Rpc* rpc = session->rpc;
 
     FURI_LOG_D(TAG, "Session started");
 
@@ -278,9 +423,7 @@ static int32_t rpc_session_worker(void* context) {
                 RpcHandlerDict_get(session->handlers, session->decoded_message->which_content);
 
             if(handler && handler->message_handler) {
-                furi_check(furi_mutex_acquire(rpc->busy_mutex, FuriWaitForever) == FuriStatusOk);
-                handler->message_handler(session->decoded_message, handler->context);
-                furi_check(furi_mutex_release(rpc->busy_mutex) == FuriStatusOk);
+                rpc_session_process_message(session, handler);
             } else if(session->decoded_message->which_content == 0) {
                 /* Receiving zeroes means message is 0-length, which
                  * is valid for proto3: all fields are filled with default values.
@@ -346,6 +489,9 @@ static int32_t rpc_session_worker(void* context) {
         }
     }
 
+    rpc_session_wait_jobs(session);
+    rpc_worker_release(session->rpc);
+
     return 0;
 }
 
@@ -360,6 +506,7 @@ static void rpc_session_thread_pending_callback(void* context, uint32_t arg) {
     }
     free(session->system_contexts);
     free(session->decoded_message);
+    free(session->send_buffer);
     RpcHandlerDict_clear(session->handlers);
     furi_stream_buffer_free(session->stream);
 
@@ -370,6 +517,7 @@ static void rpc_session_thread_pending_callback(void* context, uint32_t arg) {
     furi_mutex_release(session->callbacks_mutex);
 
     furi_mutex_free(session->callbacks_mutex);
+    furi_semaphore_free(session->job_done);
     furi_thread_join(session->thread);
     furi_thread_free(session->thread);
     free(session);
@@ -386,16 +534,17 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
 
     RpcSession* session = malloc(sizeof(RpcSession));
     session->callbacks_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    session->job_done = furi_semaphore_alloc(RPC_WORKER_QUEUE_SIZE + 1, 0);
     session->stream = furi_stream_buffer_alloc(RPC_BUFFER_SIZE, 1);
     session->rpc = rpc;
     session->terminate = false;
     session->decode_error = false;
     session->owner = owner;
+    session->storage_chunk_size = RPC_STORAGE_CHUNK_SIZE_DEFAULT;
+    session->storage_window = 1;
     RpcHandlerDict_init(session->handlers);
 
-    session->decoded_message = malloc(sizeof(PB_Main));
-    session->decoded_message->cb_content.funcs.decode = rpc_pb_content_callback;
-    session->decoded_message->cb_content.arg = session;
+    session->decoded_message = rpc_session_alloc_decoded_message(session);
 
     session->system_contexts = malloc(COUNT_OF(rpc_systems) * sizeof(void*));
     for(size_t i = 0; i < COUNT_OF(rpc_systems); ++i) {
@@ -406,6 +555,7 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
         .message_handler = rpc_close_session_process,
         .decode_submessage = NULL,
         .context = session,
+        .domain = RpcDomainSystem,
     };
     rpc_add_handler(session, PB_Main_stop_session_tag, &rpc_handler);
 
@@ -414,6 +564,7 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
     furi_thread_set_state_context(session->thread, session);
     furi_thread_set_state_callback(session->thread, rpc_session_thread_state_callback);
 
+    rpc_worker_acquire(rpc);
     furi_thread_start(session->thread);
 
     rpc->sessions_count++;
@@ -437,7 +588,10 @@ void rpc_on_system_start(void* p) {
     UNUSED(p);
     Rpc* rpc = malloc(sizeof(Rpc));
 
-    rpc->busy_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    for(size_t i = 0; i < RpcDomainCount; ++i) {
+        rpc->domain_semaphore[i] = furi_semaphore_alloc(1, 1);
+    }
+    rpc->worker_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
 
     Cli* cli = furi_record_open(RECORD_CLI);
     cli_add_command(
@@ -465,9 +619,19 @@ void rpc_send(RpcSession* session, PB_Main* message) {
 
     bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
     furi_check(result && ostream.bytes_written);
+    const size_t message_size = ostream.bytes_written;
+
+    furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
 
-    uint8_t* buffer = malloc(ostream.bytes_written);
-    ostream = pb_ostream_from_buffer(buffer, ostream.bytes_written);
+    /* Messages are sent from several threads, so buffer is shared under the mutex */
+    if(session->send_buffer_size < message_size) {
+        free(session->send_buffer);
+        session->send_buffer = malloc(message_size);
+        session->send_buffer_size = message_size;
+    }
+
+    uint8_t* buffer = session->send_buffer;
+    ostream = pb_ostream_from_buffer(buffer, message_size);
 
     pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
 
@@ -475,13 +639,10 @@ void rpc_send(RpcSession* session, PB_Main* message) {
     rpc_debug_print_data("OUTPUT", buffer, ostream.bytes_written);
 #endif
 
-    furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
     if(session->send_bytes_callback) {
         session->send_bytes_callback(session->context, buffer, ostream.bytes_written);
     }
     furi_mutex_release(session->callbacks_mutex);
-
-    free(buffer);
 }
 
 void rpc_send_and_release(RpcSession* session, PB_Main* message) {
@@ -11,6 +11,10 @@ extern "C" {
 
 #define RPC_BUFFER_SIZE (1024)
 
+#define RPC_STORAGE_CHUNK_SIZE_DEFAULT (512)
+#define RPC_STORAGE_CHUNK_SIZE_MAX (4096)
+#define RPC_STORAGE_WINDOW_MAX (4)
+
 #define RECORD_RPC "rpc"
 
 /** Rpc interface. Used for opening session only. */
@@ -117,6 +121,21 @@ void rpc_session_set_terminated_callback(
     RpcSession* session,
     RpcSessionTerminatedCallback callback);
 
+/** Set storage file transfer parameters
+ *
+ * Files are read in chunks of chunk_size bytes. If window is greater than 1,
+ * up to window chunks are read ahead while previous ones are being sent, and
+ * up to window received chunks are written in background. Parameters are
+ * clamped to RPC_STORAGE_CHUNK_SIZE_MAX and RPC_STORAGE_WINDOW_MAX and apply
+ * to transfers started after the call. By default files are read in
+ * RPC_STORAGE_CHUNK_SIZE_DEFAULT chunks one by one.
+ *
+ * @param   session     pointer to RpcSession descriptor
+ * @param   chunk_size  read chunk size in bytes
+ * @param   window      number of chunks in flight
+ */
+void rpc_session_set_storage_transfer(RpcSession* session, size_t chunk_size, size_t window);
+
 /** Give bytes to RPC service to decode them and perform command
  *
  * @param   session     pointer to RpcSession descriptor
@@ -2,6 +2,7 @@
 #include <furi.h>
 #include <rpc/rpc.h>
 #include <furi_hal.h>
+#include <toolbox/args.h>
 
 #define TAG "RpcCli"
 
@@ -37,11 +38,17 @@ static void rpc_cli_session_terminated_callback(void* context) {
 }
 
 void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context) {
-    UNUSED(args);
     furi_assert(cli);
     furi_assert(context);
     Rpc* rpc = context;
 
+    // Optional storage transfer parameters requested by host: [chunk_size [window]]
+    int storage_chunk_size = RPC_STORAGE_CHUNK_SIZE_DEFAULT;
+    int storage_window = 1;
+    if(args_read_int_and_trim(args, &storage_chunk_size)) {
+        args_read_int_and_trim(args, &storage_window);
+    }
+
     uint32_t mem_before = memmgr_get_free_heap();
     FURI_LOG_D(TAG, "Free memory %lu", mem_before);
 
@@ -53,6 +60,10 @@ void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context) {
         return;
     }
 
+    if(storage_chunk_size > 0 && storage_window > 0) {
+        rpc_session_set_storage_transfer(rpc_session, storage_chunk_size, storage_window);
+    }
+
     CliRpc cli_rpc = {.cli = cli, .session_close_request = false};
     cli_rpc.terminate_semaphore = furi_semaphore_alloc(1, 0);
     rpc_session_set_context(rpc_session, &cli_rpc);
@@ -103,6 +103,7 @@ void* rpc_desktop_alloc(RpcSession* session) {
         .message_handler = NULL,
         .decode_submessage = NULL,
         .context = rpc_desktop,
+        .domain = RpcDomainApp,
     };
 
     rpc_handler.message_handler = rpc_desktop_on_is_locked_request;
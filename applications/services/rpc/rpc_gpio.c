@@ -195,6 +195,7 @@ void* rpc_system_gpio_alloc(RpcSession* session) {
         .message_handler = NULL,
         .decode_submessage = NULL,
         .context = session,
+        .domain = RpcDomainSystem,
     };
 
     rpc_handler.message_handler = rpc_system_gpio_set_pin_mode;
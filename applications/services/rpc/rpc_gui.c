@@ -466,6 +466,7 @@ void* rpc_system_gui_alloc(RpcSession* session) {
         .message_handler = NULL,
         .decode_submessage = NULL,
         .context = rpc_gui,
+        .domain = RpcDomainGui,
     };
 
     rpc_handler.message_handler = rpc_system_gui_start_screen_stream_process;
@@ -15,10 +15,24 @@ typedef void* (*RpcSystemAlloc)(RpcSession* session);
 typedef void (*RpcSystemFree)(void* context);
 typedef void (*PBMessageHandler)(const PB_Main* msg_request, void* context);
 
+/** Resource touched by handler. Handlers of one domain are serialized across
+ * all sessions, handlers of different domains run concurrently. */
+typedef enum {
+    RpcDomainSystem,
+    RpcDomainStorage,
+    RpcDomainApp,
+    RpcDomainGui,
+
+    RpcDomainCount,
+} RpcDomain;
+
 typedef struct {
     bool (*decode_submessage)(pb_istream_t* stream, const pb_field_t* field, void** arg);
     PBMessageHandler message_handler;
     void* context;
+    RpcDomain domain;
+    /* Run on worker thread, so session keeps processing other domains meanwhile */
+    bool long_running;
 } RpcHandler;
 
 void rpc_send(RpcSession* session, PB_Main* main_message);
@@ -29,6 +43,8 @@ void rpc_send_and_release_empty(RpcSession* session, uint32_t command_id, PB_Com
 
 void rpc_add_handler(RpcSession* session, pb_size_t message_tag, RpcHandler* handler);
 
+void rpc_session_get_storage_transfer(RpcSession* session, size_t* chunk_size, size_t* window);
+
 void* rpc_system_system_alloc(RpcSession* session);
 void* rpc_system_storage_alloc(RpcSession* session);
 void rpc_system_storage_free(void* ctx);
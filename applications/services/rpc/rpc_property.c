@@ -99,6 +99,7 @@ void* rpc_system_property_alloc(RpcSession* session) {
         .message_handler = NULL,
         .decode_submessage = NULL,
         .context = session,
+        .domain = RpcDomainSystem,
     };
 
     rpc_handler.message_handler = rpc_system_property_get_process;
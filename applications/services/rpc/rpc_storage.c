@@ -17,21 +17,50 @@
 
 #define MAX_NAME_LENGTH 254
 
-static const size_t MAX_DATA_SIZE = 512;
-
 typedef enum {
     RpcStorageStateIdle = 0,
     RpcStorageStateWriting,
 } RpcStorageState;
 
+/* Chunk read ahead, completed on storage thread */
+typedef struct {
+    size_t bytes;
+    FS_Error error;
+} RpcStorageReadResult;
+
 typedef struct {
     RpcSession* session;
     Storage* api;
     File* file;
     RpcStorageState state;
     uint32_t current_command_id;
+
+    /* Background writes, used if session transfer window is greater than 1 */
+    StorageAsync* write_async;
+    FuriSemaphore* write_free;
+    size_t write_window;
+    size_t write_next;
+    uint8_t* write_buffers[RPC_STORAGE_WINDOW_MAX];
+    size_t write_buffer_sizes[RPC_STORAGE_WINDOW_MAX];
+    size_t write_sizes[RPC_STORAGE_WINDOW_MAX];
+    volatile bool write_failed;
 } RpcStorageSystem;
 
+static void rpc_system_storage_write_async_free(RpcStorageSystem* rpc_storage) {
+    if(rpc_storage->write_async) {
+        storage_async_free(rpc_storage->write_async);
+        rpc_storage->write_async = NULL;
+        furi_semaphore_free(rpc_storage->write_free);
+        rpc_storage->write_free = NULL;
+    }
+
+    for(size_t i = 0; i < RPC_STORAGE_WINDOW_MAX; ++i) {
+        free(rpc_storage->write_buffers[i]);
+        rpc_storage->write_buffers[i] = NULL;
+        rpc_storage->write_buffer_sizes[i] = 0;
+    }
+}
+
 static void rpc_system_storage_reset_state(
     RpcStorageSystem* rpc_storage,
     RpcSession* session,
@@ -48,6 +77,7 @@ static void rpc_system_storage_reset_state(
         }
 
         if(rpc_storage->state == RpcStorageStateWriting) {
+            rpc_system_storage_write_async_free(rpc_storage);
             storage_file_close(rpc_storage->file);
             storage_file_free(rpc_storage->file);
             furi_record_close(RECORD_STORAGE);
@@ -354,6 +384,17 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     furi_record_close(RECORD_STORAGE);
 }
 
+static void rpc_system_storage_read_callback(
+    void* buff,
+    size_t bytes,
+    FS_Error error,
+    void* context) {
+    UNUSED(buff);
+    FuriMessageQueue* results = context;
+    RpcStorageReadResult result = {.bytes = bytes, .error = error};
+    furi_check(furi_message_queue_put(results, &result, 0) == FuriStatusOk);
+}
+
 static void rpc_system_storage_read_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -367,63 +408,152 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
 
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
-    /* use same message memory to send response */
-    PB_Main* response = malloc(sizeof(PB_Main));
+    size_t chunk_size, window;
+    rpc_session_get_storage_transfer(session, &chunk_size, &window);
+
     const char* path = request->content.storage_read_request.path;
     Storage* fs_api = furi_record_open(RECORD_STORAGE);
     File* file = storage_file_alloc(fs_api);
     bool fs_operation_success = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING);
+    FS_Error read_error = FSE_OK;
 
     if(fs_operation_success) {
         size_t size_left = storage_file_size(file);
+        size_t chunks = (size_left + chunk_size - 1) / chunk_size;
+        window = MIN(window, MAX(chunks, 1U));
+
+        /* Chunks are read into a pool of buffers reused for the whole file,
+         * next ones are read by storage thread while current one is sent */
+        pb_bytes_array_t** buffers = malloc(sizeof(pb_bytes_array_t*) * window);
+        for(size_t i = 0; i < window; ++i) {
+            buffers[i] = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MIN(size_left, chunk_size)));
+        }
+
+        FuriMessageQueue* results = furi_message_queue_alloc(window, sizeof(RpcStorageReadResult));
+        StorageAsync* async = storage_async_alloc(file, window);
+        storage_async_set_callback(async, rpc_system_storage_read_callback, results);
+
+        size_t submitted = 0;
+        size_t submit_left = size_left;
+        while((submitted < window) && (submit_left > 0)) {
+            const size_t read_size = MIN(submit_left, chunk_size);
+            storage_async_read(async, buffers[submitted]->bytes, read_size, FuriWaitForever);
+            submit_left -= read_size;
+            ++submitted;
+        }
+
+        PB_Main response = {
+            .command_id = request->command_id,
+            .which_content = PB_Main_storage_read_response_tag,
+            .command_status = PB_CommandStatus_OK,
+        };
+        response.content.storage_read_response.has_file = true;
+
+        size_t index = 0;
         do {
-            response->command_id = request->command_id;
-            response->which_content = PB_Main_storage_read_response_tag;
-            response->command_status = PB_CommandStatus_OK;
+            pb_bytes_array_t* buffer = buffers[index];
+            const size_t read_size = MIN(size_left, chunk_size);
 
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
             if(read_size) {
-                response->content.storage_read_response.has_file = true;
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(read_size));
-                uint8_t* buffer = &response->content.storage_read_response.file.data->bytes[0];
-                uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
+                RpcStorageReadResult result;
+                furi_check(
+                    furi_message_queue_get(results, &result, FuriWaitForever) == FuriStatusOk);
+                fs_operation_success = (result.bytes == read_size);
+                if(!fs_operation_success) {
+                    read_error = result.error;
+                    break;
+                }
+                size_left -= read_size;
+            }
 
-                *read_size_msg = storage_file_read(file, buffer, read_size);
-                size_left -= *read_size_msg;
-                fs_operation_success = (*read_size_msg == read_size);
+            buffer->size = read_size;
+            response.content.storage_read_response.file.data = buffer;
+            response.has_next = (size_left > 0);
+            rpc_send(session, &response);
 
-                response->has_next = fs_operation_success && (size_left > 0);
-            } else {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Warray-bounds"
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(0));
-                response->content.storage_read_response.file.data->size = 0;
-#pragma GCC diagnostic pop
-                response->content.storage_read_response.has_file = true;
-                response->has_next = false;
-                fs_operation_success = true;
+            /* Buffer is free again, read the chunk after already submitted ones */
+            if(submit_left > 0) {
+                const size_t submit_size = MIN(submit_left, chunk_size);
+                storage_async_read(async, buffer->bytes, submit_size, FuriWaitForever);
+                submit_left -= submit_size;
             }
+            index = (index + 1) % window;
+        } while(size_left != 0);
 
-            if(fs_operation_success) {
-                rpc_send_and_release(session, response);
-            }
-        } while((size_left != 0) && fs_operation_success);
+        storage_async_free(async);
+        furi_message_queue_free(results);
+        for(size_t i = 0; i < window; ++i) {
+            free(buffers[i]);
+        }
+        free(buffers);
     }
 
     if(!fs_operation_success) {
-        rpc_send_and_release_empty(
-            session, request->command_id, rpc_system_storage_get_file_error(file));
+        PB_CommandStatus status = rpc_system_storage_get_file_error(file);
+        if(read_error != FSE_OK) {
+            status = rpc_system_storage_get_error(read_error);
+        }
+        rpc_send_and_release_empty(session, request->command_id, status);
     }
 
-    free(response);
     storage_file_close(file);
     storage_file_free(file);
 
     furi_record_close(RECORD_STORAGE);
 }
 
+static void rpc_system_storage_write_callback(
+    void* buff,
+    size_t bytes,
+    FS_Error error,
+    void* context) {
+    UNUSED(error);
+    RpcStorageSystem* rpc_storage = context;
+
+    for(size_t i = 0; i < rpc_storage->write_window; ++i) {
+        if(rpc_storage->write_buffers[i] == buff) {
+            if(bytes != rpc_storage->write_sizes[i]) {
+                rpc_storage->write_failed = true;
+            }
+            break;
+        }
+    }
+
+    furi_check(furi_semaphore_release(rpc_storage->write_free) == FuriStatusOk);
+}
+
+/* Copy chunk into a free pool buffer and write it in background,
+ * errors of previous chunks are reported on next call */
+static bool rpc_system_storage_write_async(
+    RpcStorageSystem* rpc_storage,
+    const uint8_t* data,
+    size_t size) {
+    furi_check(size <= UINT16_MAX);
+
+    furi_check(
+        furi_semaphore_acquire(rpc_storage->write_free, FuriWaitForever) == FuriStatusOk);
+    if(rpc_storage->write_failed) {
+        furi_check(furi_semaphore_release(rpc_storage->write_free) == FuriStatusOk);
+        return false;
+    }
+
+    const size_t index = rpc_storage->write_next;
+    rpc_storage->write_next = (index + 1) % rpc_storage->write_window;
+
+    if(rpc_storage->write_buffer_sizes[index] < size) {
+        free(rpc_storage->write_buffers[index]);
+        rpc_storage->write_buffers[index] = malloc(size);
+        rpc_storage->write_buffer_sizes[index] = size;
+    }
+
+    memcpy(rpc_storage->write_buffers[index], data, size);
+    rpc_storage->write_sizes[index] = size;
+    storage_async_write(
+        rpc_storage->write_async, rpc_storage->write_buffers[index], size, FuriWaitForever);
+
+    return true;
+}
+
 static void rpc_system_storage_write_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -458,6 +588,19 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
         const char* path = request->content.storage_write_request.path;
         fs_operation_success =
             storage_file_open(rpc_storage->file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+
+        size_t chunk_size;
+        rpc_session_get_storage_transfer(session, &chunk_size, &rpc_storage->write_window);
+        if(fs_operation_success && (rpc_storage->write_window > 1)) {
+            rpc_storage->write_async =
+                storage_async_alloc(rpc_storage->file, rpc_storage->write_window);
+            rpc_storage->write_free = furi_semaphore_alloc(
+                rpc_storage->write_window, rpc_storage->write_window);
+            rpc_storage->write_next = 0;
+            rpc_storage->write_failed = false;
+            storage_async_set_callback(
+                rpc_storage->write_async, rpc_system_storage_write_callback, rpc_storage);
+        }
     }
 
     File* file = rpc_storage->file;
@@ -469,8 +612,18 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
            request->content.storage_write_request.file.data->size) {
             uint8_t* buffer = request->content.storage_write_request.file.data->bytes;
             size_t buffer_size = request->content.storage_write_request.file.data->size;
-            size_t written_size = storage_file_write(file, buffer, buffer_size);
-            fs_operation_success = (written_size == buffer_size);
+            if(rpc_storage->write_async) {
+                fs_operation_success =
+                    rpc_system_storage_write_async(rpc_storage, buffer, buffer_size);
+            } else {
+                size_t written_size = storage_file_write(file, buffer, buffer_size);
+                fs_operation_success = (written_size == buffer_size);
+            }
+        }
+
+        if(fs_operation_success && rpc_storage->write_async && !request->has_next) {
+            storage_async_wait(rpc_storage->write_async, FuriWaitForever);
+            fs_operation_success = !rpc_storage->write_failed;
         }
 
         send_response = !request->has_next;
@@ -723,6 +876,7 @@ void* rpc_system_storage_alloc(RpcSession* session) {
         .message_handler = NULL,
         .decode_submessage = NULL,
         .context = rpc_storage,
+        .domain = RpcDomainStorage,
     };
 
     rpc_handler.message_handler = rpc_system_storage_info_process;
@@ -734,12 +888,26 @@ void* rpc_system_storage_alloc(RpcSession* session) {
     rpc_handler.message_handler = rpc_system_storage_stat_process;
     rpc_add_handler(session, PB_Main_storage_stat_request_tag, &rpc_handler);
 
+    /* Requests that take long to process are handled by RPC worker */
+    rpc_handler.long_running = true;
+
     rpc_handler.message_handler = rpc_system_storage_list_process;
     rpc_add_handler(session, PB_Main_storage_list_request_tag, &rpc_handler);
 
     rpc_handler.message_handler = rpc_system_storage_read_process;
     rpc_add_handler(session, PB_Main_storage_read_request_tag, &rpc_handler);
 
+    rpc_handler.message_handler = rpc_system_storage_md5sum_process;
+    rpc_add_handler(session, PB_Main_storage_md5sum_request_tag, &rpc_handler);
+
+    rpc_handler.message_handler = rpc_system_storage_backup_create_process;
+    rpc_add_handler(session, PB_Main_storage_backup_create_request_tag, &rpc_handler);
+
+    rpc_handler.message_handler = rpc_system_storage_backup_restore_process;
+    rpc_add_handler(session, PB_Main_storage_backup_restore_request_tag, &rpc_handler);
+
+    rpc_handler.long_running = false;
+
     rpc_handler.message_handler = rpc_system_storage_write_process;
     rpc_add_handler(session, PB_Main_storage_write_request_tag, &rpc_handler);
 
@@ -749,18 +917,9 @@ void* rpc_system_storage_alloc(RpcSession* session) {
     rpc_handler.message_handler = rpc_system_storage_mkdir_process;
     rpc_add_handler(session, PB_Main_storage_mkdir_request_tag, &rpc_handler);
 
-    rpc_handler.message_handler = rpc_system_storage_md5sum_process;
-    rpc_add_handler(session, PB_Main_storage_md5sum_request_tag, &rpc_handler);
-
     rpc_handler.message_handler = rpc_system_storage_rename_process;
     rpc_add_handler(session, PB_Main_storage_rename_request_tag, &rpc_handler);
 
-    rpc_handler.message_handler = rpc_system_storage_backup_create_process;
-    rpc_add_handler(session, PB_Main_storage_backup_create_request_tag, &rpc_handler);
-
-    rpc_handler.message_handler = rpc_system_storage_backup_restore_process;
-    rpc_add_handler(session, PB_Main_storage_backup_restore_request_tag, &rpc_handler);
-
     return rpc_storage;
 }
 
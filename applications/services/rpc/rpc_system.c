@@ -305,6 +305,7 @@ void* rpc_system_system_alloc(RpcSession* session) {
         .message_handler = NULL,
         .decode_submessage = NULL,
         .context = session,
+        .domain = RpcDomainSystem,
     };
 
     rpc_handler.message_handler = rpc_system_system_ping_process;
@@ -77,6 +77,8 @@ void storage_tick(Storage* app) {
         app->sd_gui.enabled = false;
         // view_port_enabled_set(app->sd_gui.view_port, false);
 
+        storage_data_dirs_changed(&app->storage[ST_EXT]);
+
         FURI_LOG_I(TAG, "SD card unmount");
         StorageEvent event = {.type = StorageEventTypeCardUnmount};
         furi_pubsub_publish(app->pubsub, &event);
@@ -91,6 +93,7 @@ void storage_tick(Storage* app) {
        app->sd_gui.enabled == false) {
         app->sd_gui.enabled = true;
         // view_port_enabled_set(app->sd_gui.view_port, true);
+        storage_data_dirs_changed(&app->storage[ST_EXT]);
 
         if(app->storage[ST_EXT].status == StorageStatusOK) {
             FURI_LOG_I(TAG, "SD card mount");
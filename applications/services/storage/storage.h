@@ -139,6 +139,26 @@ size_t storage_file_read(File* file, void* buff, size_t bytes_to_read);
  */
 size_t storage_file_write(File* file, const void* buff, size_t bytes_to_write);
 
+/**
+ * @brief Buffer description for vectored reads.
+ */
+typedef struct {
+    void* buff; /**< Pointer to the buffer to be filled with read data. */
+    size_t size; /**< Number of bytes to read into the buffer. */
+} StorageIoVec;
+
+/**
+ * @brief Read bytes from a file into several buffers with a single storage request.
+ *
+ * Buffers are filled in order, reading stops at the end of file or on the first error.
+ *
+ * @param file pointer to the file instance to read from.
+ * @param vec pointer to the array of buffer descriptions.
+ * @param count number of elements in the array.
+ * @return total number of bytes read.
+ */
+size_t storage_file_readv(File* file, const StorageIoVec* vec, size_t count);
+
 /**
  * @brief Change the current access position in a file.
  *
@@ -288,6 +308,20 @@ bool storage_dir_exists(Storage* storage, const char* path);
  */
 FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t* timestamp);
 
+/**
+ * @brief Get the change counter of a directory.
+ *
+ * The value changes whenever an entry of the directory is created, removed, or closed after
+ * being opened for writing, and when the storage is mounted or formatted. It may also change
+ * spuriously, so it is suitable for invalidating cached directory listings.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param path pointer to a zero-terminated string containing the path of the directory.
+ * @param generation pointer to a value to contain the change counter.
+ * @return FSE_OK if the counter has been successfully received, any other error code on failure.
+ */
+FS_Error storage_common_dir_generation(Storage* storage, const char* path, uint32_t* generation);
+
 /**
  * @brief Get information about a file or a directory.
  *
@@ -430,6 +464,136 @@ bool storage_common_equivalent_path(
     const char* path2,
     bool truncate);
 
+/******************* Batch Functions *******************/
+
+/**
+ * @brief Enumeration of operations that can be batched.
+ */
+typedef enum {
+    StorageBatchOpTypeFileRead, /**< Read size bytes at offset of an open file into buff. */
+    StorageBatchOpTypeCommonStat, /**< Get information about path into fileinfo (may be NULL). */
+    StorageBatchOpTypeDirRead, /**< Read next entry of an open directory into fileinfo and a
+                                    name buffer buff of size bytes. */
+} StorageBatchOpType;
+
+/**
+ * @brief Batched storage operation.
+ */
+typedef struct {
+    StorageBatchOpType type; /**< Operation type. */
+    File* file; /**< File or directory instance, for FileRead and DirRead. */
+    const char* path; /**< Path, for CommonStat. */
+    uint32_t offset; /**< Offset from the start of the file, for FileRead. */
+    void* buff; /**< Data buffer for FileRead, name buffer for DirRead. */
+    size_t size; /**< Size of buff. */
+    FileInfo* fileinfo; /**< File information, for CommonStat and DirRead. */
+    FS_Error error; /**< Result: error code of the operation. */
+    size_t result; /**< Result: bytes read for FileRead, 1 if an entry was read for DirRead. */
+} StorageBatchOp;
+
+/**
+ * @brief Execute several operations with a single storage request.
+ *
+ * Operations are executed in order, a failed operation does not stop the batch.
+ * The storage is busy for the whole batch, so keep batches reasonably short.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param ops pointer to the array of operations, results are stored in it.
+ * @param count number of operations in the array.
+ * @return number of operations that completed with FSE_OK.
+ */
+size_t storage_batch(Storage* storage, StorageBatchOp* ops, size_t count);
+
+/******************* Async Functions *******************/
+
+/**
+ * @brief Asynchronous request queue bound to a file instance.
+ */
+typedef struct StorageAsync StorageAsync;
+
+/**
+ * @brief Asynchronous request completion callback.
+ *
+ * Called from the storage service thread: it must be short and must not call the storage API.
+ *
+ * @param buff buffer of the completed request.
+ * @param bytes number of bytes transferred.
+ * @param error error code of the request.
+ * @param context pointer to a user-specified context object.
+ */
+typedef void (*StorageAsyncCallback)(void* buff, size_t bytes, FS_Error error, void* context);
+
+/**
+ * @brief Allocate an asynchronous request queue for an open file.
+ *
+ * Requests are executed in submission order. Bytes are read from and written to the
+ * current position of the file, which must not be accessed synchronously while
+ * requests are in flight.
+ *
+ * @param file pointer to the file instance, must outlive the queue.
+ * @param depth maximum number of requests in flight.
+ * @return pointer to the created instance.
+ */
+StorageAsync* storage_async_alloc(File* file, size_t depth);
+
+/**
+ * @brief Wait for all requests in flight and free an asynchronous request queue.
+ *
+ * @param async pointer to the instance to be freed.
+ */
+void storage_async_free(StorageAsync* async);
+
+/**
+ * @brief Set the completion callback.
+ *
+ * @param async pointer to the instance to be modified.
+ * @param callback pointer to a function to be called on completion, or NULL.
+ * @param context pointer to a user-specified context object.
+ */
+void storage_async_set_callback(
+    StorageAsync* async,
+    StorageAsyncCallback callback,
+    void* context);
+
+/**
+ * @brief Submit a read request.
+ *
+ * @param async pointer to the instance to be used.
+ * @param buff pointer to the buffer to be filled, must stay valid until completion.
+ * @param size number of bytes to read.
+ * @param timeout time to wait for a free request slot, in ticks.
+ * @return true if the request was submitted, false on timeout.
+ */
+bool storage_async_read(StorageAsync* async, void* buff, size_t size, uint32_t timeout);
+
+/**
+ * @brief Submit a write request.
+ *
+ * @param async pointer to the instance to be used.
+ * @param buff pointer to the data to be written, must stay valid until completion.
+ * @param size number of bytes to write, up to UINT16_MAX.
+ * @param timeout time to wait for a free request slot, in ticks.
+ * @return true if the request was submitted, false on timeout.
+ */
+bool storage_async_write(StorageAsync* async, const void* buff, size_t size, uint32_t timeout);
+
+/**
+ * @brief Get the number of requests in flight.
+ *
+ * @param async pointer to the instance to be queried.
+ * @return number of submitted requests that have not completed yet.
+ */
+size_t storage_async_get_pending(StorageAsync* async);
+
+/**
+ * @brief Wait until all requests in flight are completed.
+ *
+ * @param async pointer to the instance to be used.
+ * @param timeout time to wait, in ticks.
+ * @return true if all requests are completed, false on timeout.
+ */
+bool storage_async_wait(StorageAsync* async, uint32_t timeout);
+
 /******************* Error Functions *******************/
 
 /**
@@ -0,0 +1,192 @@
+#include "storage.h"
+#include "storage_i.h" // IWYU pragma: keep
+#include "storage_message.h"
+
+typedef struct {
+    StorageAsync* async;
+    void* buff;
+    StorageIoVec vec;
+    SAData data;
+    SAReturn return_data;
+    bool is_write;
+} StorageAsyncSlot;
+
+struct StorageAsync {
+    File* file;
+    size_t depth;
+    StorageAsyncSlot* slots;
+    // Free slots, taken on submission and returned on completion
+    FuriMessageQueue* free_slots;
+    // Held from slot return until callback is done, so wait doesn't miss running callbacks
+    FuriMutex* callback_mutex;
+
+    StorageAsyncCallback callback;
+    void* context;
+};
+
+static void storage_async_complete(void* context) {
+    StorageAsyncSlot* slot = context;
+    StorageAsync* async = slot->async;
+
+    void* buff = slot->buff;
+    const size_t bytes = slot->is_write ? slot->return_data.uint16_value :
+                                          slot->return_data.uint64_value;
+
+    const FS_Error error = async->file->error_id;
+
+    furi_check(furi_mutex_acquire(async->callback_mutex, FuriWaitForever) == FuriStatusOk);
+
+    // Slot is free before callback, so callback side can submit next request right away
+    furi_check(furi_message_queue_put(async->free_slots, &slot, 0) == FuriStatusOk);
+
+    if(async->callback) {
+        async->callback(buff, bytes, error, async->context);
+    }
+
+    furi_check(furi_mutex_release(async->callback_mutex) == FuriStatusOk);
+}
+
+static void storage_async_submit(StorageAsyncSlot* slot, StorageCommand command) {
+    Storage* storage = slot->async->file->storage;
+
+    StorageMessage message = {
+        .command = command,
+        .data = &slot->data,
+        .return_data = &slot->return_data,
+        .callback = storage_async_complete,
+        .context = slot,
+    };
+
+    furi_check(
+        furi_message_queue_put(storage->message_queue, &message, FuriWaitForever) ==
+        FuriStatusOk);
+}
+
+StorageAsync* storage_async_alloc(File* file, size_t depth) {
+    furi_check(file);
+    furi_check(file->storage);
+    furi_check(depth > 0);
+
+    StorageAsync* async = malloc(sizeof(StorageAsync));
+    async->file = file;
+    async->depth = depth;
+    async->slots = malloc(sizeof(StorageAsyncSlot) * depth);
+    async->free_slots = furi_message_queue_alloc(depth, sizeof(StorageAsyncSlot*));
+    async->callback_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+
+    for(size_t i = 0; i < depth; i++) {
+        StorageAsyncSlot* slot = &async->slots[i];
+        slot->async = async;
+        furi_check(furi_message_queue_put(async->free_slots, &slot, 0) == FuriStatusOk);
+    }
+
+    return async;
+}
+
+void storage_async_free(StorageAsync* async) {
+    furi_check(async);
+
+    storage_async_wait(async, FuriWaitForever);
+
+    furi_message_queue_free(async->free_slots);
+    furi_mutex_free(async->callback_mutex);
+    free(async->slots);
+    free(async);
+}
+
+void storage_async_set_callback(
+    StorageAsync* async,
+    StorageAsyncCallback callback,
+    void* context) {
+    furi_check(async);
+    furi_check(storage_async_get_pending(async) == 0);
+
+    async->callback = callback;
+    async->context = context;
+}
+
+bool storage_async_read(StorageAsync* async, void* buff, size_t size, uint32_t timeout) {
+    furi_check(async);
+    furi_check(buff || !size);
+
+    StorageAsyncSlot* slot;
+    if(furi_message_queue_get(async->free_slots, &slot, timeout) != FuriStatusOk) {
+        return false;
+    }
+
+    slot->buff = buff;
+    slot->is_write = false;
+    slot->vec.buff = buff;
+    slot->vec.size = size;
+    slot->data.freadv.file = async->file;
+    slot->data.freadv.vec = &slot->vec;
+    slot->data.freadv.count = 1;
+
+    storage_async_submit(slot, StorageCommandFileReadv);
+
+    return true;
+}
+
+bool storage_async_write(StorageAsync* async, const void* buff, size_t size, uint32_t timeout) {
+    furi_check(async);
+    furi_check(buff || !size);
+    furi_check(size <= UINT16_MAX);
+
+    StorageAsyncSlot* slot;
+    if(furi_message_queue_get(async->free_slots, &slot, timeout) != FuriStatusOk) {
+        return false;
+    }
+
+    slot->buff = (void*)buff;
+    slot->is_write = true;
+    slot->data.fwrite.file = async->file;
+    slot->data.fwrite.buff = buff;
+    slot->data.fwrite.bytes_to_write = size;
+
+    storage_async_submit(slot, StorageCommandFileWrite);
+
+    return true;
+}
+
+size_t storage_async_get_pending(StorageAsync* async) {
+    furi_check(async);
+    return async->depth - furi_message_queue_get_count(async->free_slots);
+}
+
+bool storage_async_wait(StorageAsync* async, uint32_t timeout) {
+    furi_check(async);
+
+    // All requests are completed once every slot can be taken
+    StorageAsyncSlot** slots = malloc(sizeof(StorageAsyncSlot*) * async->depth);
+    size_t taken = 0;
+    uint32_t start = furi_get_tick();
+
+    while(taken < async->depth) {
+        uint32_t remaining = timeout;
+        if(timeout != FuriWaitForever) {
+            uint32_t elapsed = furi_get_tick() - start;
+            remaining = (elapsed < timeout) ? timeout - elapsed : 0;
+        }
+
+        if(furi_message_queue_get(async->free_slots, &slots[taken], remaining) !=
+           FuriStatusOk) {
+            break;
+        }
+        taken++;
+    }
+
+    const bool result = (taken == async->depth);
+
+    if(result) {
+        // Slots are returned before callbacks, let the last one finish
+        furi_check(furi_mutex_acquire(async->callback_mutex, FuriWaitForever) == FuriStatusOk);
+        furi_check(furi_mutex_release(async->callback_mutex) == FuriStatusOk);
+    }
+
+    for(size_t i = 0; i < taken; i++) {
+        furi_check(furi_message_queue_put(async->free_slots, &slots[i], 0) == FuriStatusOk);
+    }
+    free(slots);
+
+    return result;
+}
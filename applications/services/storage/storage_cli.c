@@ -4,6 +4,7 @@
 #include <cli/cli.h>
 #include <lib/toolbox/args.h>
 #include <lib/toolbox/md5_calc.h>
+#include <lib/toolbox/block_hash.h>
 #include <lib/toolbox/dir_walk.h>
 #include <storage/storage.h>
 #include <storage/storage_sd_api.h>
@@ -33,6 +34,12 @@ static void storage_cli_print_usage(void) {
     printf("\tmd5\t - md5 hash of the file\r\n");
     printf("\tstat\t - info about file or dir\r\n");
     printf("\ttimestamp\t - last modification timestamp\r\n");
+    printf(
+        "\tmanifest\t - size and timestamp of all files and dirs, recursive, <args> may contain block size to print block hashes of files\r\n");
+    printf(
+        "\tread_blocks\t - read data blocks from file, <args> should contain block size, first block index and block count\r\n");
+    printf(
+        "\tpatch\t - write data blocks received from cli to file and truncate it, <args> should contain block size and new file size\r\n");
 }
 
 static void storage_cli_print_error(FS_Error error) {
@@ -496,6 +503,211 @@ static void storage_cli_md5(Cli* cli, FuriString* path) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static void storage_cli_manifest_block(
+    uint32_t index,
+    size_t size,
+    uint32_t weak,
+    const uint8_t strong[BLOCK_HASH_STRONG_SIZE],
+    void* context) {
+    UNUSED(context);
+
+    printf("B %lu %zu %08lx ", index, size, weak);
+    for(size_t i = 0; i < BLOCK_HASH_STRONG_SIZE; i++) {
+        printf("%02x", strong[i]);
+    }
+    printf("\r\n");
+}
+
+static void storage_cli_manifest_entry(
+    Storage* api,
+    File* file,
+    const char* name,
+    const FileInfo* fileinfo,
+    uint32_t block_size) {
+    uint32_t timestamp = 0;
+    storage_common_timestamp(api, name, &timestamp);
+
+    if(file_info_is_dir(fileinfo)) {
+        printf("D %lu %s\r\n", timestamp, name);
+        return;
+    }
+
+    printf("F %lu %lu %s\r\n", (uint32_t)fileinfo->size, timestamp, name);
+
+    if(block_size) {
+        bool hashed = false;
+        if(storage_file_open(file, name, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            hashed = block_hash_calc_file(file, block_size, storage_cli_manifest_block, NULL);
+        }
+        if(!hashed) {
+            storage_cli_print_error(storage_file_get_error(file));
+        }
+        storage_file_close(file);
+    }
+}
+
+static void storage_cli_manifest(Cli* cli, FuriString* path, FuriString* args) {
+    UNUSED(cli);
+    Storage* api = furi_record_open(RECORD_STORAGE);
+
+    uint32_t block_size = 0;
+    if(furi_string_size(args) && (sscanf(furi_string_get_cstr(args), "%lu", &block_size) != 1)) {
+        storage_cli_print_usage();
+        furi_record_close(RECORD_STORAGE);
+        return;
+    }
+
+    FileInfo fileinfo;
+    FS_Error error = storage_common_stat(api, furi_string_get_cstr(path), &fileinfo);
+    File* file = storage_file_alloc(api);
+
+    if(error != FSE_OK) {
+        storage_cli_print_error(error);
+    } else if(!file_info_is_dir(&fileinfo)) {
+        storage_cli_manifest_entry(api, file, furi_string_get_cstr(path), &fileinfo, block_size);
+    } else {
+        // Whole subtree in one pass, parents are listed before their children
+        DirWalk* dir_walk = dir_walk_alloc(api);
+        FuriString* name = furi_string_alloc();
+
+        if(dir_walk_open(dir_walk, furi_string_get_cstr(path))) {
+            DirWalkResult result;
+            while((result = dir_walk_read(dir_walk, name, &fileinfo)) == DirWalkOK) {
+                storage_cli_manifest_entry(
+                    api, file, furi_string_get_cstr(name), &fileinfo, block_size);
+            }
+            if(result == DirWalkError) {
+                storage_cli_print_error(dir_walk_get_error(dir_walk));
+            }
+        } else {
+            storage_cli_print_error(dir_walk_get_error(dir_walk));
+        }
+
+        furi_string_free(name);
+        dir_walk_free(dir_walk);
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void storage_cli_read_blocks(Cli* cli, FuriString* path, FuriString* args) {
+    UNUSED(cli);
+    Storage* api = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(api);
+
+    uint32_t block_size, index, count;
+    int parsed_count =
+        sscanf(furi_string_get_cstr(args), "%lu %lu %lu", &block_size, &index, &count);
+
+    if(parsed_count != 3 || !block_size) {
+        storage_cli_print_usage();
+    } else if(storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        uint64_t file_size = storage_file_size(file);
+        uint64_t offset = MIN((uint64_t)index * block_size, file_size);
+        uint64_t size_left = MIN((uint64_t)count * block_size, file_size - offset);
+
+        if(storage_file_seek(file, offset, true)) {
+            printf("Size: %llu\r\n", size_left);
+
+            uint8_t* data = malloc(block_size);
+            while(size_left > 0) {
+                size_t read_size = storage_file_read(file, data, MIN(size_left, block_size));
+                if(read_size == 0) {
+                    break;
+                }
+                for(size_t i = 0; i < read_size; i++) {
+                    putchar(data[i]);
+                }
+                size_left -= read_size;
+            }
+            free(data);
+            printf("\r\n");
+        } else {
+            storage_cli_print_error(storage_file_get_error(file));
+        }
+    } else {
+        storage_cli_print_error(storage_file_get_error(file));
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void storage_cli_patch(Cli* cli, FuriString* path, FuriString* args) {
+    Storage* api = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(api);
+
+    uint32_t block_size, file_size;
+    int parsed_count = sscanf(furi_string_get_cstr(args), "%lu %lu", &block_size, &file_size);
+
+    if(parsed_count != 2 || !block_size) {
+        storage_cli_print_usage();
+    } else if(storage_file_open(
+                  file, furi_string_get_cstr(path), FSAM_READ_WRITE, FSOM_OPEN_ALWAYS)) {
+        uint8_t* buffer = malloc(block_size);
+        bool success = true;
+
+        // Each block is sent as little endian uint32 index and size followed by data,
+        // zero size ends the patch
+        while(success) {
+            printf("Ready\r\n");
+
+            uint32_t header[2];
+            if(cli_read(cli, (uint8_t*)header, sizeof(header)) != sizeof(header)) {
+                success = false;
+                break;
+            }
+
+            const uint32_t index = header[0];
+            const uint32_t size = header[1];
+            if(size == 0) {
+                break;
+            }
+            if(size > block_size) {
+                storage_cli_print_error(FSE_INVALID_PARAMETER);
+                success = false;
+                break;
+            }
+
+            if(cli_read(cli, buffer, size) != size) {
+                success = false;
+                break;
+            }
+
+            const uint64_t offset = (uint64_t)index * block_size;
+            if(offset > UINT32_MAX) {
+                storage_cli_print_error(FSE_INVALID_PARAMETER);
+                success = false;
+                break;
+            }
+
+            success = storage_file_seek(file, offset, true) &&
+                      (storage_file_write(file, buffer, size) == size);
+            if(!success) {
+                storage_cli_print_error(storage_file_get_error(file));
+            }
+        }
+
+        if(success && (storage_file_size(file) > file_size)) {
+            if(!storage_file_seek(file, file_size, true) || !storage_file_truncate(file)) {
+                storage_cli_print_error(storage_file_get_error(file));
+            }
+        }
+
+        free(buffer);
+    } else {
+        storage_cli_print_error(storage_file_get_error(file));
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+
+    furi_record_close(RECORD_STORAGE);
+}
+
 void storage_cli(Cli* cli, FuriString* args, void* context) {
     UNUSED(context);
     FuriString* cmd;
@@ -589,6 +801,21 @@ void storage_cli(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "manifest") == 0) {
+            storage_cli_manifest(cli, path, args);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "read_blocks") == 0) {
+            storage_cli_read_blocks(cli, path, args);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "patch") == 0) {
+            storage_cli_patch(cli, path, args);
+            break;
+        }
+
         storage_cli_print_usage();
     } while(false);
 
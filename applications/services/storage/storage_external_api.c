@@ -219,6 +219,23 @@ size_t storage_file_write(File* file, const void* buff, size_t to_write) {
     return total;
 }
 
+size_t storage_file_readv(File* file, const StorageIoVec* vec, size_t count) {
+    S_FILE_API_PROLOGUE;
+    furi_check(vec || !count);
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .freadv = {
+            .file = file,
+            .vec = vec,
+            .count = count,
+        }};
+
+    S_API_MESSAGE(StorageCommandFileReadv);
+    S_API_EPILOGUE;
+    return S_RETURN_UINT64;
+}
+
 bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
@@ -459,6 +476,23 @@ FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t*
     return S_RETURN_ERROR;
 }
 
+FS_Error storage_common_dir_generation(Storage* storage, const char* path, uint32_t* generation) {
+    furi_check(storage);
+    furi_check(generation);
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .cdirgeneration = {
+            .path = path,
+            .generation = generation,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandCommonDirGeneration);
+    S_API_EPILOGUE;
+    return S_RETURN_ERROR;
+}
+
 FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo) {
     furi_check(storage);
 
@@ -854,6 +888,32 @@ bool storage_common_equivalent_path(
     return S_RETURN_BOOL;
 }
 
+/****************** BATCH ******************/
+
+size_t storage_batch(Storage* storage, StorageBatchOp* ops, size_t count) {
+    furi_check(storage);
+    furi_check(ops || !count);
+    for(size_t i = 0; i < count; i++) {
+        if(ops[i].type == StorageBatchOpTypeCommonStat) {
+            furi_check(ops[i].path);
+        } else {
+            furi_check(ops[i].file);
+        }
+    }
+
+    S_API_PROLOGUE;
+    SAData data = {
+        .batch = {
+            .ops = ops,
+            .count = count,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandBatch);
+    S_API_EPILOGUE;
+    return S_RETURN_UINT64;
+}
+
 /****************** ERROR ******************/
 
 const char* storage_error_get_desc(FS_Error error_id) {
@@ -1,5 +1,6 @@
 #include "storage_glue.h"
 #include <furi_hal.h>
+#include <ctype.h>
 
 #define TAG "StorageGlue"
 
@@ -9,18 +10,21 @@ void storage_file_init(StorageFile* obj) {
     obj->file = NULL;
     obj->file_data = NULL;
     obj->path = furi_string_alloc();
+    obj->write_access = false;
 }
 
 void storage_file_init_set(StorageFile* obj, const StorageFile* src) {
     obj->file = src->file;
     obj->file_data = src->file_data;
     obj->path = furi_string_alloc_set(src->path);
+    obj->write_access = src->write_access;
 }
 
 void storage_file_set(StorageFile* obj, const StorageFile* src) { //-V524
     obj->file = src->file;
     obj->file_data = src->file_data;
     furi_string_set(obj->path, src->path);
+    obj->write_access = src->write_access;
 }
 
 void storage_file_clear(StorageFile* obj) {
@@ -73,6 +77,41 @@ uint32_t storage_data_get_timestamp(StorageData* storage) {
     return storage->timestamp;
 }
 
+// Case-insensitive hash of a directory path without the storage prefix and trailing slashes
+static size_t storage_data_dir_slot(const char* path, size_t length) {
+    if(length >= STORAGE_PATH_PREFIX_LEN) {
+        path += STORAGE_PATH_PREFIX_LEN;
+        length -= STORAGE_PATH_PREFIX_LEN;
+    }
+    while(length && path[length - 1] == '/') {
+        length--;
+    }
+
+    uint32_t hash = 2166136261UL;
+    for(size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)tolower((unsigned char)path[i]);
+        hash *= 16777619UL;
+    }
+
+    return hash % STORAGE_DIR_CHANGE_SLOTS;
+}
+
+void storage_data_dir_changed(StorageData* storage, const char* path) {
+    const char* name = strrchr(path, '/');
+    const size_t parent_length = name ? (size_t)(name - path) : 0;
+    storage->dir_changes[storage_data_dir_slot(path, parent_length)]++;
+}
+
+void storage_data_dirs_changed(StorageData* storage) {
+    storage->dir_generation++;
+}
+
+uint32_t storage_data_get_dir_generation(StorageData* storage, const char* path) {
+    // Both counters only grow, so the sum changes whenever either of them does
+    const size_t slot = storage_data_dir_slot(path, strlen(path));
+    return storage->dir_generation + storage->dir_changes[slot];
+}
+
 /****************** storage glue ******************/
 
 static StorageFile* storage_get_file(const File* file, StorageData* storage) {
@@ -126,6 +165,17 @@ void* storage_get_storage_file_data(const File* file, StorageData* storage) {
     return storage_file_ref->file_data;
 }
 
+void storage_set_storage_file_write_access(const File* file, bool write, StorageData* storage) {
+    StorageFile* storage_file_ref = storage_get_file(file, storage);
+    furi_check(storage_file_ref != NULL);
+    storage_file_ref->write_access = write;
+}
+
+bool storage_file_is_write_access(const File* file, StorageData* storage) {
+    StorageFile* storage_file_ref = storage_get_file(file, storage);
+    return storage_file_ref && storage_file_ref->write_access;
+}
+
 void storage_push_storage_file(File* file, FuriString* path, StorageData* storage) {
     StorageFile* storage_file = StorageFileList_push_new(storage->files);
     file->file_id = (uint32_t)storage_file;
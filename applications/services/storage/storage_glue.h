@@ -10,6 +10,11 @@ extern "C" {
 
 typedef enum { ST_EXT = 0, ST_INT = 1, ST_MNT = 2, ST_ANY, ST_ERROR } StorageType;
 
+#define STORAGE_PATH_PREFIX_LEN 4u
+
+// Directory change counters are shared by directories with the same path hash
+#define STORAGE_DIR_CHANGE_SLOTS 32
+
 typedef struct StorageData StorageData;
 
 typedef struct {
@@ -20,6 +25,7 @@ typedef struct {
     File* file;
     void* file_data;
     FuriString* path;
+    bool write_access;
 } StorageFile;
 
 typedef enum {
@@ -42,6 +48,9 @@ StorageStatus storage_data_status(StorageData* storage);
 const char* storage_data_status_text(StorageData* storage);
 void storage_data_timestamp(StorageData* storage);
 uint32_t storage_data_get_timestamp(StorageData* storage);
+void storage_data_dir_changed(StorageData* storage, const char* path);
+void storage_data_dirs_changed(StorageData* storage);
+uint32_t storage_data_get_dir_generation(StorageData* storage, const char* path);
 
 LIST_DEF(
     StorageFileList,
@@ -58,6 +67,8 @@ struct StorageData {
     StorageStatus status;
     StorageFileList_t files;
     uint32_t timestamp;
+    uint32_t dir_generation;
+    uint32_t dir_changes[STORAGE_DIR_CHANGE_SLOTS];
 };
 
 bool storage_has_file(const File* file, StorageData* storage_data);
@@ -66,6 +77,9 @@ bool storage_path_already_open(FuriString* path, StorageData* storage_data);
 void storage_set_storage_file_data(const File* file, void* file_data, StorageData* storage);
 void* storage_get_storage_file_data(const File* file, StorageData* storage);
 
+void storage_set_storage_file_write_access(const File* file, bool write, StorageData* storage);
+bool storage_file_is_write_access(const File* file, StorageData* storage);
+
 void storage_push_storage_file(File* file, FuriString* path, StorageData* storage);
 bool storage_pop_storage_file(File* file, StorageData* storage);
 
@@ -37,6 +37,12 @@ typedef struct {
     uint64_t size;
 } SADataFExpand;
 
+typedef struct {
+    File* file;
+    const StorageIoVec* vec;
+    size_t count;
+} SADataFReadv;
+
 typedef struct {
     File* file;
     const char* path;
@@ -56,6 +62,12 @@ typedef struct {
     FuriThreadId thread_id;
 } SADataCTimestamp;
 
+typedef struct {
+    const char* path;
+    uint32_t* generation;
+    FuriThreadId thread_id;
+} SADataCDirGeneration;
+
 typedef struct {
     const char* path;
     FileInfo* fileinfo;
@@ -104,6 +116,12 @@ typedef struct {
     SDInfo* info;
 } SAInfo;
 
+typedef struct {
+    StorageBatchOp* ops;
+    size_t count;
+    FuriThreadId thread_id;
+} SADataBatch;
+
 typedef struct {
     File* image;
 } SAVirtualInit;
@@ -114,6 +132,7 @@ typedef union {
     SADataFWrite fwrite;
     SADataFSeek fseek;
     SADataFExpand fexpand;
+    SADataFReadv freadv;
 
     SADataDOpen dopen;
     SADataDRead dread;
@@ -133,6 +152,9 @@ typedef union {
     SAInfo sdinfo;
 
     SAVirtualInit virtualinit;
+
+    SADataBatch batch;
+    SADataCDirGeneration cdirgeneration;
 } SAData;
 
 typedef union {
@@ -177,13 +199,22 @@ typedef enum {
     StorageCommandVirtualMount,
     StorageCommandVirtualUnmount,
     StorageCommandVirtualQuit,
+
+    StorageCommandFileReadv,
+    StorageCommandBatch,
+    StorageCommandCommonDirGeneration,
 } StorageCommand;
 
+typedef void (*StorageMessageCallback)(void* context);
+
 typedef struct {
     FuriApiLock lock;
     StorageCommand command;
     SAData* data;
     SAReturn* return_data;
+    // Called instead of unlocking the lock, for asynchronous requests
+    StorageMessageCallback callback;
+    void* context;
 } StorageMessage;
 
 #ifdef __cplusplus
@@ -2,7 +2,6 @@
 #include <m-list.h>
 #include <m-dict.h>
 
-#define STORAGE_PATH_PREFIX_LEN 4u
 _Static_assert(
     sizeof(STORAGE_ANY_PATH_PREFIX) == STORAGE_PATH_PREFIX_LEN + 1,
     "Any path prefix len mismatch");
@@ -123,8 +122,10 @@ bool storage_process_file_open(
         } else {
             if(access_mode & FSAM_WRITE) {
                 storage_data_timestamp(storage);
+                storage_data_dir_changed(storage, furi_string_get_cstr(path));
             }
             storage_push_storage_file(file, path, storage);
+            storage_set_storage_file_write_access(file, access_mode & FSAM_WRITE, storage);
 
             const char* path_cstr_no_vfs = cstr_path_without_vfs_prefix(path);
             FS_CALL(storage, file.open(storage, file, path_cstr_no_vfs, access_mode, open_mode));
@@ -142,6 +143,10 @@ bool storage_process_file_close(Storage* app, File* file) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
         FS_CALL(storage, file.close(storage, file));
+        if(storage_file_is_write_access(file, storage)) {
+            // Size and timestamp of the directory entry are final now
+            storage_data_dir_changed(storage, storage_file_get_path(file, storage));
+        }
         storage_pop_storage_file(file, storage);
 
         StorageEvent event = {.type = StorageEventTypeFileClose};
@@ -183,6 +188,31 @@ static uint16_t storage_process_file_write(
     return ret;
 }
 
+static uint64_t storage_process_file_readv(
+    Storage* app,
+    File* file,
+    const StorageIoVec* vec,
+    size_t count) {
+    uint64_t total = 0;
+
+    for(size_t i = 0; i < count; i++) {
+        size_t done = 0;
+        while(done < vec[i].size) {
+            const uint16_t chunk = MIN(vec[i].size - done, UINT16_MAX);
+            const uint16_t read =
+                storage_process_file_read(app, file, (uint8_t*)vec[i].buff + done, chunk);
+            done += read;
+
+            if(file->error_id != FSE_OK || read != chunk) {
+                return total + done;
+            }
+        }
+        total += done;
+    }
+
+    return total;
+}
+
 static bool storage_process_file_seek(
     Storage* app,
     File* file,
@@ -361,6 +391,18 @@ static FS_Error
     return ret;
 }
 
+static FS_Error
+    storage_process_common_dir_generation(Storage* app, FuriString* path, uint32_t* generation) {
+    StorageData* storage;
+    FS_Error ret = storage_get_data(app, path, &storage);
+
+    if(ret == FSE_OK) {
+        *generation = storage_data_get_dir_generation(storage, furi_string_get_cstr(path));
+    }
+
+    return ret;
+}
+
 static FS_Error storage_process_common_stat(Storage* app, FuriString* path, FileInfo* fileinfo) {
     StorageData* storage;
     FS_Error ret = storage_get_data(app, path, &storage);
@@ -385,6 +427,7 @@ static FS_Error storage_process_common_remove(Storage* app, FuriString* path) {
         }
 
         storage_data_timestamp(storage);
+        storage_data_dir_changed(storage, furi_string_get_cstr(path));
         FS_CALL(storage, common.remove(storage, cstr_path_without_vfs_prefix(path)));
     } while(false);
 
@@ -397,6 +440,7 @@ static FS_Error storage_process_common_mkdir(Storage* app, FuriString* path) {
 
     if(ret == FSE_OK) {
         storage_data_timestamp(storage);
+        storage_data_dir_changed(storage, furi_string_get_cstr(path));
         FS_CALL(storage, common.mkdir(storage, cstr_path_without_vfs_prefix(path)));
     }
 
@@ -457,6 +501,7 @@ static FS_Error storage_process_sd_format(Storage* app) {
     } else {
         ret = sd_format_card(&app->storage[ST_EXT]);
         storage_data_timestamp(&app->storage[ST_EXT]);
+        storage_data_dirs_changed(&app->storage[ST_EXT]);
     }
 
     return ret;
@@ -479,6 +524,7 @@ static FS_Error storage_process_sd_unmount(Storage* app) {
 
         sd_unmount_card(storage);
         storage_data_timestamp(storage);
+        storage_data_dirs_changed(storage);
     } while(false);
 
     return ret;
@@ -496,6 +542,7 @@ static FS_Error storage_process_sd_mount(Storage* app) {
 
         ret = sd_mount_card(storage, true);
         storage_data_timestamp(storage);
+        storage_data_dirs_changed(storage);
     } while(false);
 
     return ret;
@@ -583,6 +630,51 @@ void storage_process_alias(
     }
 }
 
+/****************** Batch processing ******************/
+
+static uint64_t storage_process_batch(
+    Storage* app,
+    StorageBatchOp* ops,
+    size_t count,
+    FuriThreadId thread_id) {
+    uint64_t completed = 0;
+    FuriString* path = furi_string_alloc();
+
+    for(size_t i = 0; i < count; i++) {
+        StorageBatchOp* op = &ops[i];
+        op->result = 0;
+
+        switch(op->type) {
+        case StorageBatchOpTypeFileRead:
+            if(storage_process_file_seek(app, op->file, op->offset, true)) {
+                const StorageIoVec vec = {.buff = op->buff, .size = op->size};
+                op->result = storage_process_file_readv(app, op->file, &vec, 1);
+            }
+            op->error = op->file->error_id;
+            break;
+        case StorageBatchOpTypeCommonStat:
+            furi_string_set(path, op->path);
+            storage_process_alias(app, path, thread_id, false);
+            op->error = storage_process_common_stat(app, path, op->fileinfo);
+            break;
+        case StorageBatchOpTypeDirRead:
+            op->result = storage_process_dir_read(
+                app, op->file, op->fileinfo, op->buff, MIN(op->size, UINT16_MAX));
+            op->error = op->file->error_id;
+            break;
+        default:
+            op->error = FSE_INVALID_PARAMETER;
+            break;
+        }
+
+        if(op->error == FSE_OK) completed++;
+    }
+
+    furi_string_free(path);
+
+    return completed;
+}
+
 /****************** API calls processing ******************/
 
 void storage_process_message_internal(Storage* app, StorageMessage* message) {
@@ -629,6 +721,13 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         message->return_data->uint64_value =
             storage_process_file_tell(app, message->data->file.file);
         break;
+    case StorageCommandFileReadv:
+        message->return_data->uint64_value = storage_process_file_readv(
+            app,
+            message->data->freadv.file,
+            message->data->freadv.vec,
+            message->data->freadv.count);
+        break;
     case StorageCommandFileExpand:
         message->return_data->bool_value = storage_process_file_expand(
             app, message->data->fexpand.file, message->data->fexpand.size);
@@ -754,23 +853,45 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         break;
     case StorageCommandVirtualFormat:
         message->return_data->error_value = storage_process_virtual_format(&app->storage[ST_MNT]);
+        storage_data_dirs_changed(&app->storage[ST_MNT]);
         break;
     case StorageCommandVirtualMount:
         message->return_data->error_value = storage_process_virtual_mount(&app->storage[ST_MNT]);
+        storage_data_dirs_changed(&app->storage[ST_MNT]);
         break;
     case StorageCommandVirtualUnmount:
         message->return_data->error_value = storage_process_virtual_unmount(&app->storage[ST_MNT]);
+        storage_data_dirs_changed(&app->storage[ST_MNT]);
         break;
     case StorageCommandVirtualQuit:
         message->return_data->error_value = storage_process_virtual_quit(&app->storage[ST_MNT]);
         break;
+
+    // Batch operations
+    case StorageCommandBatch:
+        message->return_data->uint64_value = storage_process_batch(
+            app,
+            message->data->batch.ops,
+            message->data->batch.count,
+            message->data->batch.thread_id);
+        break;
+    case StorageCommandCommonDirGeneration:
+        path = furi_string_alloc_set(message->data->cdirgeneration.path);
+        storage_process_alias(app, path, message->data->cdirgeneration.thread_id, false);
+        message->return_data->error_value = storage_process_common_dir_generation(
+            app, path, message->data->cdirgeneration.generation);
+        break;
     }
 
     if(path != NULL) { //-V547
         furi_string_free(path);
     }
 
-    api_lock_unlock(message->lock);
+    if(message->callback) {
+        message->callback(message->context);
+    } else {
+        api_lock_unlock(message->lock);
+    }
 }
 
 void storage_process_message(Storage* app, StorageMessage* message) {
@@ -1,17 +1,42 @@
 #include "log.h"
 #include "check.h"
 #include "mutex.h"
+#include "thread.h"
+#include "log_ring.h"
 #include <furi_hal.h>
 #include <m-list.h>
+#include <stm32wbxx.h>
 
 LIST_DEF(FuriLogHandlersList, FuriLogHandler, M_POD_OPLIST)
 
 #define FURI_LOG_LEVEL_DEFAULT FuriLogLevelInfo
 
+#define FURI_LOG_RING_SIZE (4096U)
+#define FURI_LOG_WORKER_STACK_SIZE (2048U)
+#define FURI_LOG_WORKER_FLAG_PENDING (1U << 0)
+#define FURI_LOG_DEFERRED_TEXT_SIZE (128U)
+
+typedef struct {
+    char tag[FURI_LOG_TAG_SIZE];
+    FuriLogLevel level;
+} FuriLogTagLevel;
+
 typedef struct {
     FuriLogLevel log_level;
     FuriMutex* mutex;
     FuriLogHandlersList_t tx_handlers;
+
+    // Per tag overrides, changed under mutex and read without it by log calls
+    FuriLogTagLevel tag_levels[FURI_LOG_TAG_LEVELS_MAX];
+    volatile size_t tag_levels_count;
+    // Highest of global and per tag levels, rejects most calls without lookup
+    volatile FuriLogLevel log_level_max;
+
+    // Deferred mode, ring and worker are allocated on first enable
+    volatile bool deferred;
+    FuriLogRing ring;
+    FuriThread* worker;
+    uint32_t dropped_reported;
 } FuriLogParams;
 
 static FuriLogParams furi_log = {0};
@@ -34,6 +59,7 @@ static const FuriLogLevelDescription FURI_LOG_LEVEL_DESCRIPTIONS[] = {
 void furi_log_init(void) {
     // Set default logging parameters
     furi_log.log_level = FURI_LOG_LEVEL_DEFAULT;
+    furi_log.log_level_max = FURI_LOG_LEVEL_DEFAULT;
     furi_log.mutex = furi_mutex_alloc(FuriMutexTypeRecursive);
     FuriLogHandlersList_init(furi_log.tx_handlers);
 }
@@ -107,44 +133,162 @@ void furi_log_puts(const char* data) {
     furi_log_tx((const uint8_t*)data, strlen(data));
 }
 
+static void furi_log_update_level_max(void) {
+    FuriLogLevel level_max = furi_log.log_level;
+    for(size_t i = 0; i < furi_log.tag_levels_count; i++) {
+        level_max = MAX(level_max, furi_log.tag_levels[i].level);
+    }
+    furi_log.log_level_max = level_max;
+}
+
+static size_t furi_log_find_tag_level(const char* tag) {
+    size_t index = 0;
+    while(index < furi_log.tag_levels_count &&
+          strcmp(furi_log.tag_levels[index].tag, tag) != 0) {
+        index++;
+    }
+    return index;
+}
+
+static void furi_log_level_style(FuriLogLevel level, const char** color, const char** letter) {
+    *color = _FURI_LOG_CLR_RESET;
+    *letter = " ";
+    switch(level) {
+    case FuriLogLevelError:
+        *color = _FURI_LOG_CLR_E;
+        *letter = "E";
+        break;
+    case FuriLogLevelWarn:
+        *color = _FURI_LOG_CLR_W;
+        *letter = "W";
+        break;
+    case FuriLogLevelInfo:
+        *color = _FURI_LOG_CLR_I;
+        *letter = "I";
+        break;
+    case FuriLogLevelDebug:
+        *color = _FURI_LOG_CLR_D;
+        *letter = "D";
+        break;
+    case FuriLogLevelTrace:
+        *color = _FURI_LOG_CLR_T;
+        *letter = "T";
+        break;
+    default:
+        break;
+    }
+}
+
+static void
+    furi_log_print_header(FuriString* string, uint32_t tick, FuriLogLevel level, const char* tag) {
+    const char* color;
+    const char* log_letter;
+    furi_log_level_style(level, &color, &log_letter);
+
+    // Timestamp
+    furi_string_printf(
+        string, "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET, tick, color, log_letter, tag);
+    furi_log_puts(furi_string_get_cstr(string));
+    furi_string_reset(string);
+}
+
+static void furi_log_ring_output(const char* data, size_t size, void* context) {
+    UNUSED(context);
+    furi_log_tx((const uint8_t*)data, size);
+}
+
+static void furi_log_worker_report_dropped(FuriString* string) {
+    const uint32_t dropped = furi_log.ring.dropped;
+    if(dropped == furi_log.dropped_reported) return;
+
+    furi_log_print_header(string, furi_get_tick(), FuriLogLevelWarn, "FuriLog");
+    furi_string_printf(
+        string, "%lu records dropped\r\n", (uint32_t)(dropped - furi_log.dropped_reported));
+    furi_log_puts(furi_string_get_cstr(string));
+    furi_string_reset(string);
+
+    furi_log.dropped_reported = dropped;
+}
+
+static int32_t furi_log_worker(void* context) {
+    UNUSED(context);
+    FuriString* string = furi_string_alloc();
+
+    while(true) {
+        // Not empty after draining means a record is still being written by a producer
+        const uint32_t timeout = furi_log_ring_is_empty(&furi_log.ring) ? FuriWaitForever : 1;
+        furi_thread_flags_wait(FURI_LOG_WORKER_FLAG_PENDING, FuriFlagWaitAny, timeout);
+
+        FuriLogRingRecord record;
+        while(furi_log_ring_peek(&furi_log.ring, &record)) {
+            furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+
+            // Raw records have no tag
+            if(record.tag) {
+                furi_log_print_header(string, record.tick, record.level, record.tag);
+            }
+            furi_log_ring_format(&record, furi_log_ring_output, NULL);
+            if(record.tag) {
+                furi_log_puts("\r\n");
+            }
+            furi_log_ring_pop(&furi_log.ring);
+
+            furi_log_worker_report_dropped(string);
+
+            furi_mutex_release(furi_log.mutex);
+        }
+    }
+
+    furi_string_free(string);
+    return 0;
+}
+
+static FuriLogRingPush
+    furi_log_deferred_push_text(FuriLogLevel level, const char* tag, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    const FuriLogRingPush result =
+        furi_log_ring_vpush(&furi_log.ring, furi_get_tick(), level, tag, format, args);
+    va_end(args);
+    return result;
+}
+
+static void furi_log_deferred_push(
+    FuriLogLevel level,
+    const char* tag,
+    const char* format,
+    va_list args) {
+    FuriLogRingPush result;
+
+    // Format is parsed later by worker, only firmware strings are known to live that long
+    const uintptr_t format_address = (uintptr_t)format;
+    if(format_address >= FLASH_BASE && format_address < (FLASH_BASE + FLASH_SIZE)) {
+        result = furi_log_ring_vpush(&furi_log.ring, furi_get_tick(), level, tag, format, args);
+    } else {
+        char text[FURI_LOG_DEFERRED_TEXT_SIZE];
+        vsnprintf(text, sizeof(text), format, args);
+        result = furi_log_deferred_push_text(level, tag, "%s", text);
+    }
+
+    // Worker drains the ring completely, so it only needs a wake up on first record
+    if(result == FuriLogRingPushFirst) {
+        furi_thread_flags_set(furi_thread_get_id(furi_log.worker), FURI_LOG_WORKER_FLAG_PENDING);
+    }
+}
+
 void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
-    if(level <= furi_log.log_level &&
-       furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
+    if(!furi_log_is_enabled(level, tag)) return;
+
+    if(furi_log.deferred) {
+        va_list args;
+        va_start(args, format);
+        furi_log_deferred_push(level, tag, format, args);
+        va_end(args);
+    } else if(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
         FuriString* string;
         string = furi_string_alloc();
 
-        const char* color = _FURI_LOG_CLR_RESET;
-        const char* log_letter = " ";
-        switch(level) {
-        case FuriLogLevelError:
-            color = _FURI_LOG_CLR_E;
-            log_letter = "E";
-            break;
-        case FuriLogLevelWarn:
-            color = _FURI_LOG_CLR_W;
-            log_letter = "W";
-            break;
-        case FuriLogLevelInfo:
-            color = _FURI_LOG_CLR_I;
-            log_letter = "I";
-            break;
-        case FuriLogLevelDebug:
-            color = _FURI_LOG_CLR_D;
-            log_letter = "D";
-            break;
-        case FuriLogLevelTrace:
-            color = _FURI_LOG_CLR_T;
-            log_letter = "T";
-            break;
-        default:
-            break;
-        }
-
-        // Timestamp
-        furi_string_printf(
-            string, "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET, furi_get_tick(), color, log_letter, tag);
-        furi_log_puts(furi_string_get_cstr(string));
-        furi_string_reset(string);
+        furi_log_print_header(string, furi_get_tick(), level, tag);
 
         va_list args;
         va_start(args, format);
@@ -161,8 +305,14 @@ void furi_log_print_format(FuriLogLevel level, const char* tag, const char* form
 }
 
 void furi_log_print_raw_format(FuriLogLevel level, const char* format, ...) {
-    if(level <= furi_log.log_level &&
-       furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
+    if(!furi_log_is_enabled(level, NULL)) return;
+
+    if(furi_log.deferred) {
+        va_list args;
+        va_start(args, format);
+        furi_log_deferred_push(level, NULL, format, args);
+        va_end(args);
+    } else if(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
         FuriString* string;
         string = furi_string_alloc();
         va_list args;
@@ -177,6 +327,47 @@ void furi_log_print_raw_format(FuriLogLevel level, const char* format, ...) {
     }
 }
 
+void furi_log_set_deferred(bool deferred) {
+    furi_check(!FURI_IS_ISR());
+    furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+
+    if(deferred && !furi_log.worker) {
+        furi_log_ring_init(&furi_log.ring, malloc(FURI_LOG_RING_SIZE), FURI_LOG_RING_SIZE);
+
+        furi_log.worker =
+            furi_thread_alloc_ex("LogWorker", FURI_LOG_WORKER_STACK_SIZE, furi_log_worker, NULL);
+        furi_thread_mark_as_service(furi_log.worker);
+        furi_thread_set_priority(furi_log.worker, FuriThreadPriorityLowest);
+        furi_thread_start(furi_log.worker);
+    }
+
+    furi_log.deferred = deferred;
+
+    furi_mutex_release(furi_log.mutex);
+
+    // Records pushed before switching back are still emitted in order
+    if(!deferred) {
+        furi_log_flush();
+    }
+}
+
+bool furi_log_get_deferred(void) {
+    return furi_log.deferred;
+}
+
+void furi_log_flush(void) {
+    furi_check(!FURI_IS_ISR());
+    if(!furi_log.worker) return;
+
+    while(!furi_log_ring_is_empty(&furi_log.ring)) {
+        furi_delay_tick(1);
+    }
+}
+
+uint32_t furi_log_get_dropped(void) {
+    return furi_log.worker ? furi_log.ring.dropped : 0;
+}
+
 void furi_log_set_level(FuriLogLevel level) {
     furi_check(level <= FuriLogLevelTrace);
 
@@ -184,12 +375,90 @@ void furi_log_set_level(FuriLogLevel level) {
         level = FURI_LOG_LEVEL_DEFAULT;
     }
     furi_log.log_level = level;
+    furi_log_update_level_max();
 }
 
 FuriLogLevel furi_log_get_level(void) {
     return furi_log.log_level;
 }
 
+bool furi_log_set_tag_level(const char* tag, FuriLogLevel level) {
+    furi_check(tag);
+    furi_check(level <= FuriLogLevelTrace);
+
+    if(strlen(tag) >= FURI_LOG_TAG_SIZE) return false;
+
+    bool ret = true;
+
+    furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+
+    const size_t count = furi_log.tag_levels_count;
+    size_t index = furi_log_find_tag_level(tag);
+
+    if(level == FuriLogLevelDefault) {
+        // Remove override, last entry takes its place
+        if(index < count) {
+            furi_log.tag_levels[index] = furi_log.tag_levels[count - 1];
+            furi_log.tag_levels_count = count - 1;
+        }
+    } else if(index < count) {
+        furi_log.tag_levels[index].level = level;
+    } else if(count < FURI_LOG_TAG_LEVELS_MAX) {
+        // Entry is complete before it becomes visible to log calls
+        strlcpy(furi_log.tag_levels[count].tag, tag, FURI_LOG_TAG_SIZE);
+        furi_log.tag_levels[count].level = level;
+        furi_log.tag_levels_count = count + 1;
+    } else {
+        ret = false;
+    }
+
+    furi_log_update_level_max();
+
+    furi_mutex_release(furi_log.mutex);
+
+    return ret;
+}
+
+FuriLogLevel furi_log_get_tag_level(const char* tag) {
+    furi_check(tag);
+
+    FuriLogLevel level = FuriLogLevelDefault;
+
+    furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+    size_t index = furi_log_find_tag_level(tag);
+    if(index < furi_log.tag_levels_count) {
+        level = furi_log.tag_levels[index].level;
+    }
+    furi_mutex_release(furi_log.mutex);
+
+    return level;
+}
+
+void furi_log_enumerate_tag_levels(FuriLogTagLevelCallback callback, void* context) {
+    furi_check(callback);
+
+    furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+    for(size_t i = 0; i < furi_log.tag_levels_count; i++) {
+        callback(furi_log.tag_levels[i].tag, furi_log.tag_levels[i].level, context);
+    }
+    furi_mutex_release(furi_log.mutex);
+}
+
+bool furi_log_is_enabled(FuriLogLevel level, const char* tag) {
+    if(level > furi_log.log_level_max) return false;
+
+    if(tag) {
+        const size_t count = furi_log.tag_levels_count;
+        for(size_t i = 0; i < count; i++) {
+            if(strcmp(furi_log.tag_levels[i].tag, tag) == 0) {
+                return level <= furi_log.tag_levels[i].level;
+            }
+        }
+    }
+
+    return level <= furi_log.log_level;
+}
+
 bool furi_log_level_to_string(FuriLogLevel level, const char** str) {
     for(size_t i = 0; i < COUNT_OF(FURI_LOG_LEVEL_DESCRIPTIONS); i++) {
         if(level == FURI_LOG_LEVEL_DESCRIPTIONS[i].level) {
@@ -39,6 +39,19 @@ typedef enum {
 #define _FURI_LOG_CLR_D _FURI_LOG_CLR(_FURI_LOG_CLR_BLUE)
 #define _FURI_LOG_CLR_T _FURI_LOG_CLR(_FURI_LOG_CLR_PURPLE)
 
+/** Highest level compiled in, log calls above it are removed at compile time
+ *
+ * Set with LOG_LEVEL_MAX build option as numeric FuriLogLevel value.
+ */
+#ifndef FURI_LOG_LEVEL_MAX
+#define FURI_LOG_LEVEL_MAX FuriLogLevelTrace
+#endif
+
+/** Maximum number of tags with own log level */
+#define FURI_LOG_TAG_LEVELS_MAX (8U)
+/** Tag buffer size for per tag log level, including terminator */
+#define FURI_LOG_TAG_SIZE (24U)
+
 typedef void (*FuriLogHandlerCallback)(const uint8_t* data, size_t size, void* context);
 
 typedef struct {
@@ -46,6 +59,8 @@ typedef struct {
     void* context;
 } FuriLogHandler;
 
+typedef void (*FuriLogTagLevelCallback)(const char* tag, FuriLogLevel level, void* context);
+
 /** Initialize logging */
 void furi_log_init(void);
 
@@ -109,6 +124,69 @@ void furi_log_set_level(FuriLogLevel level);
  */
 FuriLogLevel furi_log_get_level(void);
 
+/** Set log level for one tag, overriding global log level
+ *
+ * @param[in]  tag    The tag
+ * @param[in]  level  The level, FuriLogLevelDefault removes override
+ *
+ * @return     true on success, false if tag is too long or table is full
+ */
+bool furi_log_set_tag_level(const char* tag, FuriLogLevel level);
+
+/** Get log level override for tag
+ *
+ * @param[in]  tag   The tag
+ *
+ * @return     The level, FuriLogLevelDefault if there is no override
+ */
+FuriLogLevel furi_log_get_tag_level(const char* tag);
+
+/** Call callback for every tag level override, don't log from it
+ *
+ * @param[in]  callback  The callback
+ * @param      context   The callback context
+ */
+void furi_log_enumerate_tag_levels(FuriLogTagLevelCallback callback, void* context);
+
+/** Check if record with level and tag is printed
+ *
+ * @param[in]  level  The level
+ * @param[in]  tag    The tag, NULL for raw records
+ *
+ * @return     true if enabled
+ */
+bool furi_log_is_enabled(FuriLogLevel level, const char* tag);
+
+/** Enable or disable deferred logging
+ *
+ * In deferred mode log calls only store timestamp, level, tag and format
+ * pointers and raw arguments into a lock-free ring, formatting and output are
+ * done later by a low priority thread. Tag must be a static string, string
+ * arguments are copied. Formats outside of firmware flash are formatted at
+ * call time and the text is copied, truncated to 127 characters. Loaded
+ * applications are flushed before being unloaded, so their tags can be used
+ * too. Records that don't fit into the ring are dropped and counted.
+ * Disabling flushes pending records.
+ *
+ * @param[in]  deferred  true to enable deferred mode
+ */
+void furi_log_set_deferred(bool deferred);
+
+/** Get deferred logging state
+ *
+ * @return     true if deferred mode is enabled
+ */
+bool furi_log_get_deferred(void);
+
+/** Wait until all deferred records are emitted */
+void furi_log_flush(void);
+
+/** Get count of deferred records dropped because the ring was full
+ *
+ * @return     dropped records count since boot
+ */
+uint32_t furi_log_get_dropped(void);
+
 /** Log level to string
  *
  * @param[in]  level  The level
@@ -127,38 +205,48 @@ bool furi_log_level_to_string(FuriLogLevel level, const char** str);
  */
 bool furi_log_level_from_string(const char* str, FuriLogLevel* level);
 
+/** Check if log level is compiled in and enabled for tag
+ *
+ * Arguments of log calls are evaluated only when this is true.
+ *
+ * @param      level   The level
+ * @param      tag     The application tag, NULL for raw records
+ */
+#define FURI_LOG_ENABLED(level, tag) \
+    ((level) <= FURI_LOG_LEVEL_MAX && furi_log_is_enabled(level, tag))
+
+#define _FURI_LOG(level, tag, format, ...)                          \
+    (FURI_LOG_ENABLED(level, tag) ?                                 \
+         furi_log_print_format(level, tag, format, ##__VA_ARGS__) : \
+         (void)0)
+
+#define _FURI_LOG_RAW(level, format, ...)                          \
+    (FURI_LOG_ENABLED(level, NULL) ?                               \
+         furi_log_print_raw_format(level, format, ##__VA_ARGS__) : \
+         (void)0)
+
 /** Log methods
  *
  * @param      tag     The application tag
  * @param      format  The format
  * @param      ...     VA Args
  */
-#define FURI_LOG_E(tag, format, ...) \
-    furi_log_print_format(FuriLogLevelError, tag, format, ##__VA_ARGS__)
-#define FURI_LOG_W(tag, format, ...) \
-    furi_log_print_format(FuriLogLevelWarn, tag, format, ##__VA_ARGS__)
-#define FURI_LOG_I(tag, format, ...) \
-    furi_log_print_format(FuriLogLevelInfo, tag, format, ##__VA_ARGS__)
-#define FURI_LOG_D(tag, format, ...) \
-    furi_log_print_format(FuriLogLevelDebug, tag, format, ##__VA_ARGS__)
-#define FURI_LOG_T(tag, format, ...) \
-    furi_log_print_format(FuriLogLevelTrace, tag, format, ##__VA_ARGS__)
+#define FURI_LOG_E(tag, format, ...) _FURI_LOG(FuriLogLevelError, tag, format, ##__VA_ARGS__)
+#define FURI_LOG_W(tag, format, ...) _FURI_LOG(FuriLogLevelWarn, tag, format, ##__VA_ARGS__)
+#define FURI_LOG_I(tag, format, ...) _FURI_LOG(FuriLogLevelInfo, tag, format, ##__VA_ARGS__)
+#define FURI_LOG_D(tag, format, ...) _FURI_LOG(FuriLogLevelDebug, tag, format, ##__VA_ARGS__)
+#define FURI_LOG_T(tag, format, ...) _FURI_LOG(FuriLogLevelTrace, tag, format, ##__VA_ARGS__)
 
 /** Log methods
  *
  * @param      format  The raw format 
  * @param      ...     VA Args
  */
-#define FURI_LOG_RAW_E(format, ...) \
-    furi_log_print_raw_format(FuriLogLevelError, format, ##__VA_ARGS__)
-#define FURI_LOG_RAW_W(format, ...) \
-    furi_log_print_raw_format(FuriLogLevelWarn, format, ##__VA_ARGS__)
-#define FURI_LOG_RAW_I(format, ...) \
-    furi_log_print_raw_format(FuriLogLevelInfo, format, ##__VA_ARGS__)
-#define FURI_LOG_RAW_D(format, ...) \
-    furi_log_print_raw_format(FuriLogLevelDebug, format, ##__VA_ARGS__)
-#define FURI_LOG_RAW_T(format, ...) \
-    furi_log_print_raw_format(FuriLogLevelTrace, format, ##__VA_ARGS__)
+#define FURI_LOG_RAW_E(format, ...) _FURI_LOG_RAW(FuriLogLevelError, format, ##__VA_ARGS__)
+#define FURI_LOG_RAW_W(format, ...) _FURI_LOG_RAW(FuriLogLevelWarn, format, ##__VA_ARGS__)
+#define FURI_LOG_RAW_I(format, ...) _FURI_LOG_RAW(FuriLogLevelInfo, format, ##__VA_ARGS__)
+#define FURI_LOG_RAW_D(format, ...) _FURI_LOG_RAW(FuriLogLevelDebug, format, ##__VA_ARGS__)
+#define FURI_LOG_RAW_T(format, ...) _FURI_LOG_RAW(FuriLogLevelTrace, format, ##__VA_ARGS__)
 
 #ifdef __cplusplus
 }
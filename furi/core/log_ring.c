@@ -0,0 +1,470 @@
+#include "log_ring.h"
+
+#include <stdio.h>
+#include <string.h>
+
+typedef enum {
+    FuriLogRingStateFree = 0,
+    FuriLogRingStateCommitted,
+    FuriLogRingStatePadding,
+} FuriLogRingState;
+
+typedef struct {
+    uint16_t size;
+    uint8_t state;
+    uint8_t level;
+    uint32_t tick;
+    const char* tag;
+    const char* format;
+} FuriLogRingHeader;
+
+#define FURI_LOG_RING_ALIGNMENT (_Alignof(FuriLogRingHeader))
+#define FURI_LOG_RING_ALIGN(x) \
+    (((x) + FURI_LOG_RING_ALIGNMENT - 1) & ~(FURI_LOG_RING_ALIGNMENT - 1))
+
+typedef enum {
+    FuriLogRingArgNone,
+    FuriLogRingArgInt,
+    FuriLogRingArgLong,
+    FuriLogRingArgLongLong,
+    FuriLogRingArgSize,
+    FuriLogRingArgIntMax,
+    FuriLogRingArgPointer,
+    FuriLogRingArgString,
+    FuriLogRingArgDouble,
+    FuriLogRingArgLongDouble,
+    FuriLogRingArgInvalid,
+} FuriLogRingArg;
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t max;
+} FuriLogRingPacker;
+
+/* Parse conversion specification, spec points right after '%'.
+ * Returns pointer past the conversion character, star is count of '*' in it */
+static const char* furi_log_ring_parse(const char* spec, size_t* star, FuriLogRingArg* arg) {
+    *star = 0;
+    *arg = FuriLogRingArgInvalid;
+
+    while(*spec == '-' || *spec == '+' || *spec == ' ' || *spec == '#' || *spec == '0') {
+        spec++;
+    }
+
+    for(size_t i = 0; i < 2; i++) {
+        if(*spec == '*') {
+            (*star)++;
+            spec++;
+        } else {
+            while(*spec >= '0' && *spec <= '9') {
+                spec++;
+            }
+        }
+
+        if(i == 0 && *spec == '.') {
+            spec++;
+        } else {
+            break;
+        }
+    }
+
+    FuriLogRingArg integer = FuriLogRingArgInt;
+    bool long_double = false;
+    switch(*spec) {
+    case 'h':
+        spec += (spec[1] == 'h') ? 2 : 1;
+        break;
+    case 'l':
+        integer = (spec[1] == 'l') ? FuriLogRingArgLongLong : FuriLogRingArgLong;
+        spec += (spec[1] == 'l') ? 2 : 1;
+        break;
+    case 'z':
+    case 't':
+        integer = FuriLogRingArgSize;
+        spec++;
+        break;
+    case 'j':
+        integer = FuriLogRingArgIntMax;
+        spec++;
+        break;
+    case 'L':
+        long_double = true;
+        spec++;
+        break;
+    default:
+        break;
+    }
+
+    switch(*spec) {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        *arg = integer;
+        break;
+    case 'c':
+        *arg = FuriLogRingArgInt;
+        break;
+    case 'p':
+    case 'n':
+        *arg = FuriLogRingArgPointer;
+        break;
+    case 's':
+        *arg = (integer == FuriLogRingArgInt) ? FuriLogRingArgString : FuriLogRingArgInvalid;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        *arg = long_double ? FuriLogRingArgLongDouble : FuriLogRingArgDouble;
+        break;
+    case '%':
+        *arg = FuriLogRingArgNone;
+        break;
+    default:
+        return spec;
+    }
+
+    return spec + 1;
+}
+
+static bool furi_log_ring_pack(FuriLogRingPacker* packer, const void* value, size_t size) {
+    if(packer->size + size > packer->max) {
+        return false;
+    }
+    memcpy(&packer->data[packer->size], value, size);
+    packer->size += size;
+    return true;
+}
+
+static bool furi_log_ring_pack_string(FuriLogRingPacker* packer, const char* value) {
+    if(packer->size >= packer->max) {
+        return false;
+    }
+    if(!value) {
+        value = "(null)";
+    }
+
+    /* Strings may not outlive the call, so they are copied and cut to fit */
+    size_t length = strnlen(value, packer->max - packer->size - 1);
+    memcpy(&packer->data[packer->size], value, length);
+    packer->data[packer->size + length] = '\0';
+    packer->size += length + 1;
+    return true;
+}
+
+static void furi_log_ring_pack_args(FuriLogRingPacker* packer, const char* format, va_list args) {
+    bool packed = true;
+
+    while(packed && (format = strchr(format, '%')) != NULL) {
+        size_t star;
+        FuriLogRingArg arg;
+        format = furi_log_ring_parse(format + 1, &star, &arg);
+
+        for(size_t i = 0; packed && i < star; i++) {
+            int value = va_arg(args, int);
+            packed = furi_log_ring_pack(packer, &value, sizeof(value));
+        }
+        if(!packed) break;
+
+        switch(arg) {
+        case FuriLogRingArgInt: {
+            int value = va_arg(args, int);
+            packed = furi_log_ring_pack(packer, &value, sizeof(value));
+        } break;
+        case FuriLogRingArgLong: {
+            long value = va_arg(args, long);
+            packed = furi_log_ring_pack(packer, &value, sizeof(value));
+        } break;
+        case FuriLogRingArgLongLong: {
+            long long value = va_arg(args, long long);
+            packed = furi_log_ring_pack(packer, &value, sizeof(value));
+        } break;
+        case FuriLogRingArgSize: {
+            size_t value = va_arg(args, size_t);
+            packed = furi_log_ring_pack(packer, &value, sizeof(value));
+        } break;
+        case FuriLogRingArgIntMax: {
+            intmax_t value = va_arg(args, intmax_t);
+            packed = furi_log_ring_pack(packer, &value, sizeof(value));
+        } break;
+        case FuriLogRingArgPointer: {
+            void* value = va_arg(args, void*);
+            packed = furi_log_ring_pack(packer, &value, sizeof(value));
+        } break;
+        case FuriLogRingArgString:
+            packed = furi_log_ring_pack_string(packer, va_arg(args, const char*));
+            break;
+        case FuriLogRingArgDouble: {
+            double value = va_arg(args, double);
+            packed = furi_log_ring_pack(packer, &value, sizeof(value));
+        } break;
+        case FuriLogRingArgLongDouble: {
+            long double value = va_arg(args, long double);
+            packed = furi_log_ring_pack(packer, &value, sizeof(value));
+        } break;
+        case FuriLogRingArgNone:
+            break;
+        case FuriLogRingArgInvalid:
+            /* Rest of the arguments can't be located, formatter stops here too */
+            packed = false;
+            break;
+        }
+    }
+}
+
+void furi_log_ring_init(FuriLogRing* ring, uint8_t* buffer, uint32_t size) {
+    ring->buffer = buffer;
+    ring->size = size;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+}
+
+FuriLogRingPush furi_log_ring_vpush(
+    FuriLogRing* ring,
+    uint32_t tick,
+    uint8_t level,
+    const char* tag,
+    const char* format,
+    va_list args) {
+    _Alignas(FuriLogRingHeader) uint8_t record[FURI_LOG_RING_RECORD_MAX];
+
+    FuriLogRingPacker packer = {
+        .data = record,
+        .size = sizeof(FuriLogRingHeader),
+        .max = sizeof(record),
+    };
+    furi_log_ring_pack_args(&packer, format, args);
+
+    const uint32_t record_size = FURI_LOG_RING_ALIGN(packer.size);
+    FuriLogRingHeader* header = (FuriLogRingHeader*)record;
+    header->size = packer.size;
+    header->state = FuriLogRingStateFree;
+    header->level = level;
+    header->tick = tick;
+    header->tag = tag;
+    header->format = format;
+
+    /* Reserve space, record never wraps, end of buffer is skipped with padding */
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    uint32_t tail, offset, padding;
+    do {
+        tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        offset = head & (ring->size - 1);
+        padding = (offset + record_size > ring->size) ? ring->size - offset : 0;
+
+        if(head + padding + record_size - tail > ring->size) {
+            __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+            return FuriLogRingPushDropped;
+        }
+    } while(!__atomic_compare_exchange_n(
+        &ring->head,
+        &head,
+        head + padding + record_size,
+        true,
+        __ATOMIC_ACQ_REL,
+        __ATOMIC_RELAXED));
+
+    if(padding) {
+        FuriLogRingHeader* pad = (FuriLogRingHeader*)&ring->buffer[offset];
+        pad->size = padding;
+        __atomic_store_n(&pad->state, FuriLogRingStatePadding, __ATOMIC_RELEASE);
+        offset = 0;
+    }
+
+    /* State goes last, consumer doesn't touch record until it is committed */
+    FuriLogRingHeader* target = (FuriLogRingHeader*)&ring->buffer[offset];
+    memcpy(target, record, packer.size);
+    __atomic_store_n(&target->state, FuriLogRingStateCommitted, __ATOMIC_RELEASE);
+
+    return (head == tail) ? FuriLogRingPushFirst : FuriLogRingPushOk;
+}
+
+bool furi_log_ring_peek(FuriLogRing* ring, FuriLogRingRecord* record) {
+    while(!furi_log_ring_is_empty(ring)) {
+        const uint32_t offset = ring->tail & (ring->size - 1);
+        FuriLogRingHeader* header = (FuriLogRingHeader*)&ring->buffer[offset];
+        const uint8_t state = __atomic_load_n(&header->state, __ATOMIC_ACQUIRE);
+
+        if(state == FuriLogRingStatePadding) {
+            furi_log_ring_pop(ring);
+        } else if(state == FuriLogRingStateCommitted) {
+            record->tick = header->tick;
+            record->level = header->level;
+            record->tag = header->tag;
+            record->format = header->format;
+            record->args = (const uint8_t*)header + sizeof(FuriLogRingHeader);
+            record->args_size = header->size - sizeof(FuriLogRingHeader);
+            return true;
+        } else {
+            /* Reserved, but still being written */
+            break;
+        }
+    }
+
+    return false;
+}
+
+void furi_log_ring_pop(FuriLogRing* ring) {
+    const uint32_t offset = ring->tail & (ring->size - 1);
+    FuriLogRingHeader* header = (FuriLogRingHeader*)&ring->buffer[offset];
+    const uint32_t size = (header->state == FuriLogRingStatePadding) ?
+                              header->size :
+                              FURI_LOG_RING_ALIGN(header->size);
+
+    /* Free space is kept zeroed, so stale data never looks like a committed state */
+    memset(header, 0, size);
+    __atomic_store_n(&ring->tail, ring->tail + size, __ATOMIC_RELEASE);
+}
+
+bool furi_log_ring_is_empty(FuriLogRing* ring) {
+    return __atomic_load_n(&ring->tail, __ATOMIC_RELAXED) ==
+           __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+}
+
+static bool furi_log_ring_unpack(
+    const FuriLogRingRecord* record,
+    size_t* offset,
+    void* value,
+    size_t size) {
+    if(*offset + size > record->args_size) {
+        return false;
+    }
+    memcpy(value, &record->args[*offset], size);
+    *offset += size;
+    return true;
+}
+
+void furi_log_ring_format(
+    const FuriLogRingRecord* record,
+    FuriLogRingOutput output,
+    void* context) {
+    char spec[24];
+    char text[FURI_LOG_RING_RECORD_MAX];
+    const char* format = record->format;
+    size_t offset = 0;
+
+    while(*format) {
+        const char* percent = strchr(format, '%');
+        if(!percent) {
+            output(format, strlen(format), context);
+            break;
+        }
+        if(percent != format) {
+            output(format, percent - format, context);
+        }
+
+        size_t star;
+        FuriLogRingArg arg;
+        const char* end = furi_log_ring_parse(percent + 1, &star, &arg);
+        if(arg == FuriLogRingArgInvalid || (size_t)(end - percent) >= sizeof(spec) / 2) {
+            output(percent, strlen(percent), context);
+            break;
+        }
+
+        /* Rebuild specification with '*' replaced by stored values */
+        size_t spec_size = 0;
+        bool complete = true;
+        for(const char* c = percent; c < end; c++) {
+            if(*c != '*') {
+                spec[spec_size++] = *c;
+                continue;
+            }
+            int value;
+            if(!furi_log_ring_unpack(record, &offset, &value, sizeof(value))) {
+                complete = false;
+                break;
+            }
+            if(value < 0 && spec[spec_size - 1] == '.') {
+                // Negative precision is the same as omitted
+                spec_size--;
+            } else {
+                spec_size += snprintf(&spec[spec_size], sizeof(spec) - spec_size, "%d", value);
+            }
+        }
+        spec[spec_size] = '\0';
+
+        int length = -1;
+        switch(arg) {
+        case FuriLogRingArgInt: {
+            int value;
+            if((complete = furi_log_ring_unpack(record, &offset, &value, sizeof(value))))
+                length = snprintf(text, sizeof(text), spec, value);
+        } break;
+        case FuriLogRingArgLong: {
+            long value;
+            if((complete = furi_log_ring_unpack(record, &offset, &value, sizeof(value))))
+                length = snprintf(text, sizeof(text), spec, value);
+        } break;
+        case FuriLogRingArgLongLong: {
+            long long value;
+            if((complete = furi_log_ring_unpack(record, &offset, &value, sizeof(value))))
+                length = snprintf(text, sizeof(text), spec, value);
+        } break;
+        case FuriLogRingArgSize: {
+            size_t value;
+            if((complete = furi_log_ring_unpack(record, &offset, &value, sizeof(value))))
+                length = snprintf(text, sizeof(text), spec, value);
+        } break;
+        case FuriLogRingArgIntMax: {
+            intmax_t value;
+            if((complete = furi_log_ring_unpack(record, &offset, &value, sizeof(value))))
+                length = snprintf(text, sizeof(text), spec, value);
+        } break;
+        case FuriLogRingArgPointer: {
+            void* value;
+            if((complete = furi_log_ring_unpack(record, &offset, &value, sizeof(value))) &&
+               end[-1] == 'p')
+                length = snprintf(text, sizeof(text), spec, value);
+        } break;
+        case FuriLogRingArgString: {
+            const char* value = (const char*)&record->args[offset];
+            size_t value_size = strnlen(value, record->args_size - offset);
+            if((complete = offset + value_size < record->args_size)) {
+                offset += value_size + 1;
+                if(spec_size == 2) {
+                    output(value, value_size, context);
+                } else {
+                    length = snprintf(text, sizeof(text), spec, value);
+                }
+            }
+        } break;
+        case FuriLogRingArgDouble: {
+            double value;
+            if((complete = furi_log_ring_unpack(record, &offset, &value, sizeof(value))))
+                length = snprintf(text, sizeof(text), spec, value);
+        } break;
+        case FuriLogRingArgLongDouble: {
+            long double value;
+            if((complete = furi_log_ring_unpack(record, &offset, &value, sizeof(value))))
+                length = snprintf(text, sizeof(text), spec, value);
+        } break;
+        case FuriLogRingArgNone:
+            length = snprintf(text, sizeof(text), "%%");
+            break;
+        case FuriLogRingArgInvalid:
+            break;
+        }
+
+        if(!complete) {
+            // Arguments were cut to fit the record
+            output("...", 3, context);
+            break;
+        }
+        if(length > 0) {
+            // Longer conversions are truncated to the text buffer
+            size_t text_size = (size_t)length < sizeof(text) ? (size_t)length : sizeof(text) - 1;
+            output(text, text_size, context);
+        }
+
+        format = end;
+    }
+}
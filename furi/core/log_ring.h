@@ -0,0 +1,112 @@
+/**
+ * @file log_ring.h
+ * Furi Logging deferred records ring
+ *
+ * Lock-free multiple producers, single consumer ring of binary log records.
+ * Producers store format pointer and raw arguments, consumer formats them
+ * later. Depends on C library only, so it can be built and measured on host.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum size of one record, arguments and strings that don't fit are cut */
+#define FURI_LOG_RING_RECORD_MAX (160U)
+
+typedef struct {
+    uint8_t* buffer;
+    uint32_t size;
+    /* Free running counters, head is reserved by producers, tail is consumed */
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile uint32_t dropped;
+} FuriLogRing;
+
+typedef enum {
+    FuriLogRingPushDropped, /**< Ring is full, record is counted as dropped */
+    FuriLogRingPushOk, /**< Record is pushed */
+    FuriLogRingPushFirst, /**< Record is pushed into empty ring, consumer may need a wake up */
+} FuriLogRingPush;
+
+typedef struct {
+    uint32_t tick;
+    uint8_t level;
+    const char* tag;
+    const char* format;
+    const uint8_t* args;
+    size_t args_size;
+} FuriLogRingRecord;
+
+typedef void (*FuriLogRingOutput)(const char* data, size_t size, void* context);
+
+/** Initialize ring
+ *
+ * @param      ring    FuriLogRing instance
+ * @param      buffer  zero filled buffer, size must be power of 2
+ * @param      size    buffer size
+ */
+void furi_log_ring_init(FuriLogRing* ring, uint8_t* buffer, uint32_t size);
+
+/** Push record, safe to call from any thread and ISR
+ *
+ * @param      ring    FuriLogRing instance
+ * @param      tick    timestamp
+ * @param      level   log level
+ * @param      tag     tag, must stay valid until record is consumed
+ * @param      format  printf format, must stay valid until record is consumed
+ * @param      args    format arguments, strings are copied
+ *
+ * @return     push result
+ */
+FuriLogRingPush furi_log_ring_vpush(
+    FuriLogRing* ring,
+    uint32_t tick,
+    uint8_t level,
+    const char* tag,
+    const char* format,
+    va_list args);
+
+/** Get oldest record, consumer only
+ *
+ * @param      ring    FuriLogRing instance
+ * @param[out] record  record, valid until furi_log_ring_pop
+ *
+ * @return     true if there is a committed record
+ */
+bool furi_log_ring_peek(FuriLogRing* ring, FuriLogRingRecord* record);
+
+/** Release oldest record returned by furi_log_ring_peek, consumer only
+ *
+ * @param      ring    FuriLogRing instance
+ */
+void furi_log_ring_pop(FuriLogRing* ring);
+
+/** Check if all pushed records are consumed
+ *
+ * @param      ring    FuriLogRing instance
+ *
+ * @return     true if empty
+ */
+bool furi_log_ring_is_empty(FuriLogRing* ring);
+
+/** Format record message
+ *
+ * @param      record   record returned by furi_log_ring_peek
+ * @param      output   called for each formatted part
+ * @param      context  output context
+ */
+void furi_log_ring_format(
+    const FuriLogRingRecord* record,
+    FuriLogRingOutput output,
+    void* context);
+
+#ifdef __cplusplus
+}
+#endif
@@ -87,6 +87,9 @@ void flipper_application_free(FlipperApplication* app) {
         elf_file_call_fini(app->elf);
     }
 
+    // Deferred log records may still point to tag and format strings of the application
+    furi_log_flush();
+
     elf_file_free(app->elf);
 
     if(app->ep_thread_args) {
@@ -9,9 +9,25 @@
 #include "flipper_format_stream_i.h"
 
 /********************************** Private **********************************/
+typedef struct {
+    uint32_t hash;
+    uint32_t name;
+    uint32_t offset;
+} FlipperFormatIndexEntry;
+
+typedef struct {
+    FlipperFormatIndexEntry* entries;
+    size_t count;
+    size_t capacity;
+    char* names;
+    size_t names_size;
+    size_t names_capacity;
+} FlipperFormatIndex;
+
 struct FlipperFormat {
     Stream* stream;
     bool strict_mode;
+    FlipperFormatIndex* index;
 };
 
 static const char* const flipper_format_filetype_key = "Filetype";
@@ -21,6 +37,136 @@ Stream* flipper_format_get_raw_stream(FlipperFormat* flipper_format) {
     return flipper_format->stream;
 }
 
+static uint32_t flipper_format_index_hash(const char* key) {
+    // FNV-1a
+    uint32_t hash = 0x811C9DC5;
+    while(*key) {
+        hash = (hash ^ (uint8_t)*key++) * 0x01000193;
+    }
+    return hash;
+}
+
+static void flipper_format_index_free(FlipperFormat* flipper_format) {
+    FlipperFormatIndex* index = flipper_format->index;
+    if(index) {
+        free(index->entries);
+        free(index->names);
+        free(index);
+        flipper_format->index = NULL;
+    }
+}
+
+static void flipper_format_index_add(const char* key, size_t offset, void* context) {
+    FlipperFormatIndex* index = context;
+
+    if(index->count == index->capacity) {
+        index->capacity = index->capacity ? index->capacity * 2 : 32;
+        index->entries =
+            realloc(index->entries, index->capacity * sizeof(FlipperFormatIndexEntry));
+    }
+
+    const size_t key_size = strlen(key) + 1;
+    if(index->names_size + key_size > index->names_capacity) {
+        while(index->names_size + key_size > index->names_capacity) {
+            index->names_capacity = index->names_capacity ? index->names_capacity * 2 : 256;
+        }
+        index->names = realloc(index->names, index->names_capacity);
+    }
+
+    FlipperFormatIndexEntry* entry = &index->entries[index->count++];
+    entry->hash = flipper_format_index_hash(key);
+    entry->name = index->names_size;
+    entry->offset = offset;
+
+    memcpy(&index->names[index->names_size], key, key_size);
+    index->names_size += key_size;
+}
+
+static bool flipper_format_index_match(
+    const FlipperFormatIndex* index,
+    const FlipperFormatIndexEntry* entry,
+    const char* key,
+    uint32_t hash) {
+    return entry->hash == hash && strcmp(&index->names[entry->name], key) == 0;
+}
+
+/** Position the stream at the line holding the key, as seek_to_key would find it.
+ * Stream is left at the end if there is no such key.
+ *
+ * @return     false if the index can not be used from the current position
+ */
+static bool flipper_format_index_seek(FlipperFormat* flipper_format, const char* key) {
+    const FlipperFormatIndex* index = flipper_format->index;
+    if(!index) return false;
+
+    Stream* stream = flipper_format->stream;
+    size_t position = stream_tell(stream);
+
+    // Index knows only line starts, be sure we are at the line boundary
+    if(position > 0) {
+        uint8_t buffer[2];
+        if(!stream_seek(stream, -1, StreamOffsetFromCurrent)) return false;
+        size_t was_read = stream_read(stream, buffer, sizeof(buffer));
+        if(was_read == 1 || (was_read == 2 && buffer[0] == flipper_format_eoln)) {
+            // at line start or at the end of the stream
+        } else if(was_read == 2 && buffer[1] == flipper_format_eoln) {
+            position++;
+        } else {
+            stream_seek(stream, position, StreamOffsetFromStart);
+            return false;
+        }
+    }
+
+    // first entry at or after the position
+    size_t lo = 0;
+    size_t hi = index->count;
+    while(lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if(index->entries[mid].offset < position) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    const uint32_t hash = flipper_format_index_hash(key);
+    const FlipperFormatIndexEntry* found = NULL;
+    if(flipper_format->strict_mode) {
+        // strict mode fails on the first other key, the stream layer will find it out
+        if(lo < index->count) found = &index->entries[lo];
+    } else {
+        for(size_t i = lo; i < index->count; i++) {
+            if(flipper_format_index_match(index, &index->entries[i], key, hash)) {
+                found = &index->entries[i];
+                break;
+            }
+        }
+    }
+
+    if(found) {
+        stream_seek(stream, found->offset, StreamOffsetFromStart);
+    } else {
+        stream_seek(stream, 0, StreamOffsetFromEnd);
+    }
+
+    return true;
+}
+
+static bool flipper_format_read_value_line(
+    FlipperFormat* flipper_format,
+    const char* key,
+    FlipperStreamValue type,
+    void* data,
+    size_t data_size) {
+    bool strict_mode = flipper_format->strict_mode;
+
+    // Stream is at the key line now, key is still checked by the stream layer
+    if(flipper_format_index_seek(flipper_format, key)) strict_mode = true;
+
+    return flipper_format_stream_read_value_line(
+        flipper_format->stream, key, type, data, data_size, strict_mode);
+}
+
 /********************************** Public **********************************/
 
 FlipperFormat* flipper_format_string_alloc(void) {
@@ -46,17 +192,20 @@ FlipperFormat* flipper_format_buffered_file_alloc(Storage* storage) {
 
 bool flipper_format_file_open_existing(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_index_free(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
 }
 
 bool flipper_format_buffered_file_open_existing(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_index_free(flipper_format);
     return buffered_file_stream_open(
         flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
 }
 
 bool flipper_format_file_open_append(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_index_free(flipper_format);
 
     bool result =
         file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_APPEND);
@@ -88,32 +237,38 @@ bool flipper_format_file_open_append(FlipperFormat* flipper_format, const char*
 
 bool flipper_format_file_open_always(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_index_free(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
 }
 
 bool flipper_format_buffered_file_open_always(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_index_free(flipper_format);
     return buffered_file_stream_open(
         flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
 }
 
 bool flipper_format_file_open_new(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_index_free(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_NEW);
 }
 
 bool flipper_format_file_close(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
+    flipper_format_index_free(flipper_format);
     return file_stream_close(flipper_format->stream);
 }
 
 bool flipper_format_buffered_file_close(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
+    flipper_format_index_free(flipper_format);
     return buffered_file_stream_close(flipper_format->stream);
 }
 
 void flipper_format_free(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
+    flipper_format_index_free(flipper_format);
     stream_free(flipper_format->stream);
     free(flipper_format);
 }
@@ -132,7 +287,34 @@ bool flipper_format_seek_to_end(FlipperFormat* flipper_format) {
     return stream_seek(flipper_format->stream, 0, StreamOffsetFromEnd);
 }
 
+bool flipper_format_build_index(FlipperFormat* flipper_format) {
+    furi_check(flipper_format);
+    flipper_format_index_free(flipper_format);
+
+    Stream* stream = flipper_format->stream;
+    FlipperFormatIndex* index = malloc(sizeof(FlipperFormatIndex));
+    size_t position = stream_tell(stream);
+
+    bool result = stream_rewind(stream) &&
+                  flipper_format_stream_scan_keys(stream, flipper_format_index_add, index);
+    if(!stream_seek(stream, position, StreamOffsetFromStart)) result = false;
+
+    flipper_format->index = index;
+    if(!result) flipper_format_index_free(flipper_format);
+
+    return result;
+}
+
 bool flipper_format_key_exist(FlipperFormat* flipper_format, const char* key) {
+    const FlipperFormatIndex* index = flipper_format->index;
+    if(index) {
+        const uint32_t hash = flipper_format_index_hash(key);
+        for(size_t i = 0; i < index->count; i++) {
+            if(flipper_format_index_match(index, &index->entries[i], key, hash)) return true;
+        }
+        return false;
+    }
+
     size_t pos = stream_tell(flipper_format->stream);
     stream_seek(flipper_format->stream, 0, StreamOffsetFromStart);
     bool result = flipper_format_stream_seek_to_key(flipper_format->stream, key, false);
@@ -174,14 +356,22 @@ bool flipper_format_get_value_count(
     const char* key,
     uint32_t* count) {
     furi_check(flipper_format);
-    return flipper_format_stream_get_value_count(
-        flipper_format->stream, key, count, flipper_format->strict_mode);
+
+    size_t position = stream_tell(flipper_format->stream);
+    if(!flipper_format_index_seek(flipper_format, key)) {
+        return flipper_format_stream_get_value_count(
+            flipper_format->stream, key, count, flipper_format->strict_mode);
+    }
+
+    bool result = flipper_format_stream_get_value_count(flipper_format->stream, key, count, true);
+    if(!stream_seek(flipper_format->stream, position, StreamOffsetFromStart)) result = false;
+
+    return result;
 }
 
 bool flipper_format_read_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
     furi_check(flipper_format);
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream, key, FlipperStreamValueStr, data, 1, flipper_format->strict_mode);
+    return flipper_format_read_value_line(flipper_format, key, FlipperStreamValueStr, data, 1);
 }
 
 bool flipper_format_write_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
@@ -192,6 +382,7 @@ bool flipper_format_write_string(FlipperFormat* flipper_format, const char* key,
         .data = furi_string_get_cstr(data),
         .data_size = 1,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -207,6 +398,7 @@ bool flipper_format_write_string_cstr(
         .data = data,
         .data_size = 1,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -217,13 +409,8 @@ bool flipper_format_read_hex_uint64(
     uint64_t* data,
     const uint16_t data_size) {
     furi_check(flipper_format);
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueHexUint64,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value_line(
+        flipper_format, key, FlipperStreamValueHexUint64, data, data_size);
 }
 
 bool flipper_format_write_hex_uint64(
@@ -238,6 +425,7 @@ bool flipper_format_write_hex_uint64(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -248,13 +436,8 @@ bool flipper_format_read_uint32(
     uint32_t* data,
     const uint16_t data_size) {
     furi_check(flipper_format);
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueUint32,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value_line(
+        flipper_format, key, FlipperStreamValueUint32, data, data_size);
 }
 
 bool flipper_format_write_uint32(
@@ -269,6 +452,7 @@ bool flipper_format_write_uint32(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -278,13 +462,8 @@ bool flipper_format_read_int32(
     const char* key,
     int32_t* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueInt32,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value_line(
+        flipper_format, key, FlipperStreamValueInt32, data, data_size);
 }
 
 bool flipper_format_write_int32(
@@ -299,6 +478,7 @@ bool flipper_format_write_int32(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -308,13 +488,8 @@ bool flipper_format_read_bool(
     const char* key,
     bool* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueBool,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value_line(
+        flipper_format, key, FlipperStreamValueBool, data, data_size);
 }
 
 bool flipper_format_write_bool(
@@ -329,6 +504,7 @@ bool flipper_format_write_bool(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -338,13 +514,8 @@ bool flipper_format_read_float(
     const char* key,
     float* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueFloat,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value_line(
+        flipper_format, key, FlipperStreamValueFloat, data, data_size);
 }
 
 bool flipper_format_write_float(
@@ -359,6 +530,7 @@ bool flipper_format_write_float(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -368,13 +540,8 @@ bool flipper_format_read_hex(
     const char* key,
     uint8_t* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream,
-        key,
-        FlipperStreamValueHex,
-        data,
-        data_size,
-        flipper_format->strict_mode);
+    return flipper_format_read_value_line(
+        flipper_format, key, FlipperStreamValueHex, data, data_size);
 }
 
 bool flipper_format_write_hex(
@@ -389,6 +556,7 @@ bool flipper_format_write_hex(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
     return result;
 }
@@ -400,6 +568,7 @@ bool flipper_format_write_comment(FlipperFormat* flipper_format, FuriString* dat
 
 bool flipper_format_write_comment_cstr(FlipperFormat* flipper_format, const char* data) {
     furi_check(flipper_format);
+    flipper_format_index_free(flipper_format);
     return flipper_format_stream_write_comment_cstr(flipper_format->stream, data);
 }
 
@@ -411,6 +580,7 @@ bool flipper_format_delete_key(FlipperFormat* flipper_format, const char* key) {
         .data = NULL,
         .data_size = 0,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -424,6 +594,7 @@ bool flipper_format_update_string(FlipperFormat* flipper_format, const char* key
         .data = furi_string_get_cstr(data),
         .data_size = 1,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -440,6 +611,7 @@ bool flipper_format_update_string_cstr(
         .data = data,
         .data_size = 1,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -457,6 +629,7 @@ bool flipper_format_update_uint32(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -473,6 +646,7 @@ bool flipper_format_update_int32(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -489,6 +663,7 @@ bool flipper_format_update_bool(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -505,6 +680,7 @@ bool flipper_format_update_float(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
@@ -521,6 +697,7 @@ bool flipper_format_update_hex(
         .data = data,
         .data_size = data_size,
     };
+    flipper_format_index_free(flipper_format);
     bool result = flipper_format_stream_delete_key_and_write(
         flipper_format->stream, &write_data, flipper_format->strict_mode);
     return result;
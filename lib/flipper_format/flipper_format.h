@@ -225,6 +225,20 @@ bool flipper_format_rewind(FlipperFormat* flipper_format);
  */
 bool flipper_format_seek_to_end(FlipperFormat* flipper_format);
 
+/** Build the key offset index.
+ *
+ * Scans the whole file once and remembers where every key is, so following
+ * reads jump straight to the key line instead of scanning the file. Lookup
+ * results are the same as without the index. The index is dropped on any write
+ * through FlipperFormat, on open and on close. Rebuild it if the raw stream was
+ * modified directly.
+ *
+ * @param      flipper_format  Pointer to a FlipperFormat instance
+ *
+ * @return     True on success
+ */
+bool flipper_format_build_index(FlipperFormat* flipper_format);
+
 /** Check if the key exists.
  *
  * @param      flipper_format  Pointer to a FlipperFormat instance
@@ -1,4 +1,5 @@
 #include <inttypes.h>
+#include <string.h>
 #include <toolbox/hex.h>
 #include <core/check.h>
 #include "flipper_format_stream.h"
@@ -30,233 +31,368 @@ bool flipper_format_stream_write_eol(Stream* stream) {
     return flipper_format_stream_write(stream, &flipper_format_eoln, 1);
 }
 
-static bool flipper_format_stream_read_valid_key(Stream* stream, FuriString* key) {
-    furi_string_reset(key);
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
+#define FLIPPER_FORMAT_STREAM_BUFFER_SIZE 128
 
-    bool found = false;
-    bool error = false;
-    bool accumulate = true;
-    bool new_line = true;
+/** Block reader, scans the stream out of a local buffer instead of byte-sized reads */
+typedef struct {
+    Stream* stream;
+    size_t size;
+    size_t position;
+    uint8_t buffer[FLIPPER_FORMAT_STREAM_BUFFER_SIZE];
+} FlipperFormatStreamReader;
 
-    while(true) {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
-        if(was_read == 0) break;
+static void flipper_format_stream_reader_init(FlipperFormatStreamReader* reader, Stream* stream) {
+    reader->stream = stream;
+    reader->size = 0;
+    reader->position = 0;
+}
 
-        for(size_t i = 0; i < was_read; i++) {
-            uint8_t data = buffer[i];
-            if(data == flipper_format_eoln) {
-                // EOL found, clean data, start accumulating data and set the new_line flag
-                furi_string_reset(key);
+/** Make sure there is unconsumed data in the buffer, false on EOF or read error */
+static bool flipper_format_stream_reader_fill(FlipperFormatStreamReader* reader) {
+    if(reader->position < reader->size) return true;
+
+    reader->size = stream_read(reader->stream, reader->buffer, sizeof(reader->buffer));
+    reader->position = 0;
+    return reader->size != 0;
+}
+
+/** Return unconsumed data to the stream, so its position matches the reader position */
+static bool flipper_format_stream_reader_sync(FlipperFormatStreamReader* reader) {
+    const size_t unread = reader->size - reader->position;
+    reader->size = 0;
+    reader->position = 0;
+
+    if(unread == 0) return true;
+    return stream_seek(reader->stream, -(int32_t)unread, StreamOffsetFromCurrent);
+}
+
+bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode) {
+    FlipperFormatStreamReader reader;
+    flipper_format_stream_reader_init(&reader, stream);
+
+    const size_t key_size = strlen(key);
+    size_t matched = 0;
+    bool mismatch = false;
+    bool accumulate = true;
+    bool new_line = true;
+    bool found = false;
+    bool stop = false;
+
+    while(!stop && flipper_format_stream_reader_fill(&reader)) {
+        if(!accumulate) {
+            // comment or value, skip the rest of the line in one go
+            const uint8_t* data = &reader.buffer[reader.position];
+            const uint8_t* eol = memchr(data, flipper_format_eoln, reader.size - reader.position);
+            if(eol) {
+                reader.position += eol - data + 1;
+                matched = 0;
+                mismatch = false;
                 accumulate = true;
                 new_line = true;
-            } else if(data == flipper_format_eolr) {
-                // ignore
-            } else if(data == flipper_format_comment && new_line) {
-                // if there is a comment character and we are at the beginning of a new line
-                // do not accumulate comment data and reset the new_line flag
+            } else {
+                reader.position = reader.size;
+            }
+            continue;
+        }
+
+        const uint8_t data = reader.buffer[reader.position++];
+        if(data == flipper_format_eoln) {
+            // EOL found, start matching the key from scratch
+            matched = 0;
+            mismatch = false;
+            new_line = true;
+        } else if(data == flipper_format_eolr) {
+            // ignore
+        } else if(data == flipper_format_comment && new_line) {
+            // comment at the beginning of a line
+            accumulate = false;
+            new_line = false;
+        } else if(data == flipper_format_delimiter) {
+            if(new_line) {
+                // delimiter without a key, skip the line
                 accumulate = false;
                 new_line = false;
-            } else if(data == flipper_format_delimiter) {
-                if(new_line) {
-                    // we are on a "new line" and found the delimiter
-                    // this can only be if we have previously found some kind of key, so
-                    // clear the data, set the flag that we no longer want to accumulate data
-                    // and reset the new_line flag
-                    furi_string_reset(key);
-                    accumulate = false;
-                    new_line = false;
-                } else {
-                    // parse the delimiter only if we are accumulating data
-                    if(accumulate) {
-                        // we found the delimiter, move the rw pointer to the delimiter location
-                        // and signal that we have found something
-                        if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                            error = true;
-                            break;
-                        }
-
-                        found = true;
-                        break;
-                    }
-                }
+            } else if(!mismatch && matched == key_size) {
+                found = true;
+                stop = true;
+            } else if(strict_mode) {
+                stop = true;
             } else {
-                // just new symbol, reset the new_line flag
-                new_line = false;
-                if(accumulate) {
-                    // and accumulate data if we want
-                    furi_string_push_back(key, data);
-                }
+                // some other key, skip its value
+                accumulate = false;
+            }
+        } else {
+            // just new symbol, compare it with the key in place
+            new_line = false;
+            if(!mismatch && matched < key_size && key[matched] == (char)data) {
+                matched++;
+            } else {
+                mismatch = true;
             }
         }
+    }
 
-        if(found || error) break;
+    if(stop) {
+        // leave the rw pointer at the delimiter location
+        reader.position--;
+    }
+
+    if(!flipper_format_stream_reader_sync(&reader)) {
+        found = false;
+    } else if(found && !stream_seek(stream, 2, StreamOffsetFromCurrent)) {
+        found = false;
     }
 
     return found;
 }
 
-bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode) {
-    bool found = false;
-    FuriString* read_key;
-
-    read_key = furi_string_alloc();
+bool flipper_format_stream_scan_keys(
+    Stream* stream,
+    FlipperFormatStreamKeyCallback callback,
+    void* context) {
+    FlipperFormatStreamReader reader;
+    flipper_format_stream_reader_init(&reader, stream);
+    FuriString* key = furi_string_alloc();
+
+    size_t base = stream_tell(stream);
+    size_t line = base;
+    bool accumulate = true;
+    bool new_line = true;
 
-    while(!stream_eof(stream)) {
-        if(flipper_format_stream_read_valid_key(stream, read_key)) {
-            if(furi_string_cmp_str(read_key, key) == 0) {
-                if(!stream_seek(stream, 2, StreamOffsetFromCurrent)) break;
+    while(true) {
+        if(reader.position == reader.size) base += reader.size;
+        if(!flipper_format_stream_reader_fill(&reader)) break;
+
+        if(!accumulate) {
+            const uint8_t* data = &reader.buffer[reader.position];
+            const uint8_t* eol = memchr(data, flipper_format_eoln, reader.size - reader.position);
+            if(eol) {
+                reader.position += eol - data + 1;
+                line = base + reader.position;
+                furi_string_reset(key);
+                accumulate = true;
+                new_line = true;
+            } else {
+                reader.position = reader.size;
+            }
+            continue;
+        }
 
-                found = true;
-                break;
-            } else if(strict_mode) {
-                found = false;
-                break;
+        const uint8_t data = reader.buffer[reader.position++];
+        if(data == flipper_format_eoln) {
+            line = base + reader.position;
+            furi_string_reset(key);
+            new_line = true;
+        } else if(data == flipper_format_eolr) {
+            // ignore
+        } else if(data == flipper_format_comment && new_line) {
+            accumulate = false;
+            new_line = false;
+        } else if(data == flipper_format_delimiter) {
+            if(!new_line) {
+                callback(furi_string_get_cstr(key), line, context);
             }
+            accumulate = false;
+            new_line = false;
+        } else {
+            new_line = false;
+            furi_string_push_back(key, data);
         }
     }
-    furi_string_free(read_key);
 
-    return found;
+    furi_string_free(key);
+
+    return stream_eof(stream);
 }
 
-static bool flipper_format_stream_read_value(Stream* stream, FuriString* value, bool* last) {
+static bool flipper_format_stream_read_value(
+    FlipperFormatStreamReader* reader,
+    FuriString* value,
+    bool* last) {
     enum { LeadingSpace, ReadValue, TrailingSpace } state = LeadingSpace;
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
     bool result = false;
     bool error = false;
 
     furi_string_reset(value);
 
-    while(true) {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
-
-        if(was_read == 0) {
-            if(state != LeadingSpace && stream_eof(stream)) {
+    while(!result && !error) {
+        if(!flipper_format_stream_reader_fill(reader)) {
+            if(state != LeadingSpace && stream_eof(reader->stream)) {
                 result = true;
                 *last = true;
             } else {
                 error = true;
             }
+            break;
+        }
+
+        const uint8_t data = reader->buffer[reader->position];
+
+        if(state == LeadingSpace) {
+            if(flipper_format_stream_is_space(data)) {
+                reader->position++;
+            } else if(data == flipper_format_eoln) {
+                error = true;
+            } else {
+                state = ReadValue;
+                furi_string_push_back(value, data);
+                reader->position++;
+            }
+        } else if(state == ReadValue) {
+            if(flipper_format_stream_is_space(data)) {
+                state = TrailingSpace;
+                reader->position++;
+            } else if(data == flipper_format_eoln) {
+                result = true;
+                *last = true;
+            } else {
+                furi_string_push_back(value, data);
+                reader->position++;
+            }
+        } else if(state == TrailingSpace) {
+            if(flipper_format_stream_is_space(data)) {
+                reader->position++;
+            } else {
+                *last = (data == flipper_format_eoln);
+                result = true;
+            }
         }
+    }
+
+    return result;
+}
+
+/**
+ * Bulk hex array parser. Same grammar as reading the values one by one with
+ * flipper_format_stream_read_value, but bytes are decoded straight out of the
+ * reader buffer without intermediate strings.
+ */
+static bool flipper_format_stream_read_hex_values(
+    FlipperFormatStreamReader* reader,
+    uint8_t* data,
+    size_t data_size) {
+    enum { LeadingSpace, ReadValue, TrailingSpace } state = LeadingSpace;
+    size_t index = 0;
+    size_t length = 0;
+    char head[2] = {0};
+    bool result = false;
+    bool error = false;
 
-        for(uint16_t i = 0; i < was_read; i++) {
-            const uint8_t data = buffer[i];
+    while(!result && !error) {
+        bool value_done = false;
+        bool last = false;
+
+        if(!flipper_format_stream_reader_fill(reader)) {
+            if(state != LeadingSpace && stream_eof(reader->stream)) {
+                value_done = true;
+                last = true;
+            } else {
+                error = true;
+                break;
+            }
+        } else {
+            const uint8_t symbol = reader->buffer[reader->position];
 
             if(state == LeadingSpace) {
-                if(flipper_format_stream_is_space(data)) {
-                    continue;
-                } else if(data == flipper_format_eoln) {
-                    stream_seek(stream, i - was_read, StreamOffsetFromCurrent);
+                if(flipper_format_stream_is_space(symbol)) {
+                    reader->position++;
+                } else if(symbol == flipper_format_eoln) {
                     error = true;
-                    break;
                 } else {
                     state = ReadValue;
-                    furi_string_push_back(value, data);
+                    head[0] = symbol;
+                    length = 1;
+                    reader->position++;
                 }
             } else if(state == ReadValue) {
-                if(flipper_format_stream_is_space(data)) {
+                if(flipper_format_stream_is_space(symbol)) {
                     state = TrailingSpace;
-                } else if(data == flipper_format_eoln) {
-                    if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                        error = true;
-                    } else {
-                        result = true;
-                        *last = true;
-                    }
-                    break;
+                    reader->position++;
+                } else if(symbol == flipper_format_eoln) {
+                    value_done = true;
+                    last = true;
                 } else {
-                    furi_string_push_back(value, data);
+                    if(length == 1) head[1] = symbol;
+                    length++;
+                    reader->position++;
                 }
             } else if(state == TrailingSpace) {
-                if(flipper_format_stream_is_space(data)) {
-                    continue;
-                } else if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                    error = true;
+                if(flipper_format_stream_is_space(symbol)) {
+                    reader->position++;
                 } else {
-                    *last = (data == flipper_format_eoln);
-                    result = true;
+                    value_done = true;
+                    last = (symbol == flipper_format_eoln);
                 }
-                break;
             }
         }
 
-        if(error || result) break;
+        if(value_done) {
+            if(length < 2 || !hex_char_to_uint8(head[0], head[1], &data[index])) {
+                error = true;
+            } else if(++index == data_size) {
+                result = true;
+            } else if(last) {
+                error = true;
+            } else {
+                state = LeadingSpace;
+                length = 0;
+            }
+        }
     }
 
     return result;
 }
 
 static bool flipper_format_stream_read_line(Stream* stream, FuriString* str_result) {
+    FlipperFormatStreamReader reader;
+    flipper_format_stream_reader_init(&reader, stream);
     furi_string_reset(str_result);
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
 
-    do {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
-        if(was_read == 0) break;
-
-        bool result = false;
-        bool error = false;
+    while(flipper_format_stream_reader_fill(&reader)) {
+        const uint8_t* data = &reader.buffer[reader.position];
+        const size_t available = reader.size - reader.position;
+        const uint8_t* eol = memchr(data, flipper_format_eoln, available);
+        const size_t span = eol ? (size_t)(eol - data) : available;
 
-        for(size_t i = 0; i < was_read; i++) {
-            uint8_t data = buffer[i];
-            if(data == flipper_format_eoln) {
-                if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                    error = true;
-                    break;
-                }
-
-                result = true;
-                break;
-            } else if(data == flipper_format_eolr) {
-                // Ignore
-            } else {
-                furi_string_push_back(str_result, data);
+        for(size_t i = 0; i < span; i++) {
+            if(data[i] != flipper_format_eolr) {
+                furi_string_push_back(str_result, data[i]);
             }
         }
+        reader.position += span;
 
-        if(result || error) {
-            break;
-        }
-    } while(true);
+        // leave the rw pointer at the EOL
+        if(eol) break;
+    }
+
+    flipper_format_stream_reader_sync(&reader);
 
     return furi_string_size(str_result) != 0;
 }
 
 static bool flipper_format_stream_seek_to_next_line(Stream* stream) {
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
+    FlipperFormatStreamReader reader;
+    flipper_format_stream_reader_init(&reader, stream);
     bool result = false;
-    bool error = false;
 
-    do {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
-        if(was_read == 0) {
-            if(stream_eof(stream)) {
-                result = true;
-                break;
-            }
+    while(flipper_format_stream_reader_fill(&reader)) {
+        const uint8_t* data = &reader.buffer[reader.position];
+        const uint8_t* eol = memchr(data, flipper_format_eoln, reader.size - reader.position);
+        if(eol) {
+            reader.position += eol - data;
+            result = true;
+            break;
         }
+        reader.position = reader.size;
+    }
 
-        for(size_t i = 0; i < was_read; i++) {
-            if(buffer[i] == flipper_format_eoln) {
-                if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                    error = true;
-                    break;
-                }
-
-                result = true;
-                break;
-            }
-        }
+    if(!result) {
+        result = stream_eof(stream);
+    }
 
-        if(result || error) {
-            break;
-        }
-    } while(true);
+    if(!flipper_format_stream_reader_sync(&reader)) {
+        result = false;
+    }
 
     return result;
 }
@@ -353,30 +489,25 @@ bool flipper_format_stream_read_value_line(
                 result = true;
                 break;
             }
+        } else if(type == FlipperStreamValueHex) {
+            FlipperFormatStreamReader reader;
+            flipper_format_stream_reader_init(&reader, stream);
+            result = flipper_format_stream_read_hex_values(&reader, _data, data_size);
+            if(!flipper_format_stream_reader_sync(&reader)) result = false;
         } else {
+            FlipperFormatStreamReader reader;
+            flipper_format_stream_reader_init(&reader, stream);
             result = true;
             FuriString* value;
             value = furi_string_alloc();
 
             for(size_t i = 0; i < data_size; i++) {
                 bool last = false;
-                result = flipper_format_stream_read_value(stream, value, &last);
+                result = flipper_format_stream_read_value(&reader, value, &last);
                 if(result) {
                     int scan_values = 0;
 
                     switch(type) {
-                    case FlipperStreamValueHex: {
-                        uint8_t* data = _data;
-                        if(furi_string_size(value) >= 2) {
-                            // sscanf "%02X" does not work here
-                            if(hex_char_to_uint8(
-                                   furi_string_get_char(value, 0),
-                                   furi_string_get_char(value, 1),
-                                   &data[i])) {
-                                scan_values = 1;
-                            }
-                        }
-                    }; break;
 #ifndef FLIPPER_STREAM_LITE
                     case FlipperStreamValueFloat: {
                         float* data = _data;
@@ -430,6 +561,7 @@ bool flipper_format_stream_read_value_line(
             }
 
             furi_string_free(value);
+            if(!flipper_format_stream_reader_sync(&reader)) result = false;
         }
     } while(false);
 
@@ -452,9 +584,11 @@ bool flipper_format_stream_get_value_count(
         if(!flipper_format_stream_seek_to_key(stream, key, strict_mode)) break;
         *count = 0;
 
+        FlipperFormatStreamReader reader;
+        flipper_format_stream_reader_init(&reader, stream);
         result = true;
         while(true) {
-            if(!flipper_format_stream_read_value(stream, value, &last)) {
+            if(!flipper_format_stream_read_value(&reader, value, &last)) {
                 result = false;
                 break;
             }
@@ -29,6 +29,28 @@ bool flipper_format_stream_write_eol(Stream* stream);
  */
 bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode);
 
+/**
+ * Key callback for flipper_format_stream_scan_keys
+ * @param key key name
+ * @param offset offset of the line that holds the key
+ * @param context 
+ */
+typedef void (*FlipperFormatStreamKeyCallback)(const char* key, size_t offset, void* context);
+
+/**
+ * Report every key from the current position of the stream to the end, following the same rules as flipper_format_stream_seek_to_key.
+ * Position will be at the end of the stream.
+ * @param stream 
+ * @param callback 
+ * @param context 
+ * @return true whole stream was scanned
+ * @return false read error
+ */
+bool flipper_format_stream_scan_keys(
+    Stream* stream,
+    FlipperFormatStreamKeyCallback callback,
+    void* context);
+
 #ifdef __cplusplus
 }
 #endif
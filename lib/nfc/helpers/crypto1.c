@@ -13,6 +13,30 @@
 
 #define BEBIT(x, n) FURI_BIT(x, (n) ^ 24)
 
+// Filter input bits 0-15 folded a byte at a time into the index of the 0xEC57E80A output table
+static const uint8_t crypto1_filter_lo[256] = {
+    0, 0, 16, 16, 0, 16, 0, 0, 0, 16, 0, 0, 16, 16, 16, 16, 0, 0, 16, 16, 0, 16, 0, 0, 0, 16, 0, 0,
+    16, 16, 16, 16, 0, 0, 16, 16, 0, 16, 0, 0, 0, 16, 0, 0, 16, 16, 16, 16, 8, 8, 24, 24, 8, 24, 8,
+    8, 8, 24, 8, 8, 24, 24, 24, 24, 8, 8, 24, 24, 8, 24, 8, 8, 8, 24, 8, 8, 24, 24, 24, 24, 8, 8,
+    24, 24, 8, 24, 8, 8, 8, 24, 8, 8, 24, 24, 24, 24, 0, 0, 16, 16, 0, 16, 0, 0, 0, 16, 0, 0, 16,
+    16, 16, 16, 0, 0, 16, 16, 0, 16, 0, 0, 0, 16, 0, 0, 16, 16, 16, 16, 8, 8, 24, 24, 8, 24, 8, 8,
+    8, 24, 8, 8, 24, 24, 24, 24, 0, 0, 16, 16, 0, 16, 0, 0, 0, 16, 0, 0, 16, 16, 16, 16, 0, 0, 16,
+    16, 0, 16, 0, 0, 0, 16, 0, 0, 16, 16, 16, 16, 8, 8, 24, 24, 8, 24, 8, 8, 8, 24, 8, 8, 24, 24,
+    24, 24, 8, 8, 24, 24, 8, 24, 8, 8, 8, 24, 8, 8, 24, 24, 24, 24, 0, 0, 16, 16, 0, 16, 0, 0, 0,
+    16, 0, 0, 16, 16, 16, 16, 8, 8, 24, 24, 8, 24, 8, 8, 8, 24, 8, 8, 24, 24, 24, 24, 8, 8, 24, 24,
+    8, 24, 8, 8, 8, 24, 8, 8, 24, 24, 24, 24};
+
+static const uint8_t crypto1_filter_mid[256] = {
+    0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4,
+    2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6,
+    0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6,
+    0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4,
+    0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6,
+    0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4,
+    2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6,
+    2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6,
+    6};
+
 Crypto1* crypto1_alloc(void) {
     Crypto1* instance = malloc(sizeof(Crypto1));
 
@@ -41,16 +65,46 @@ void crypto1_init(Crypto1* crypto1, uint64_t key) {
     }
 }
 
-static uint32_t crypto1_filter(uint32_t in) {
-    uint32_t out = 0;
-    out = 0xf22c0 >> (in & 0xf) & 16;
-    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
-    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
-    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
+static inline uint32_t crypto1_filter(uint32_t in) {
+    uint32_t out = crypto1_filter_lo[in & 0xff];
+    out |= crypto1_filter_mid[in >> 8 & 0xff];
     out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
     return FURI_BIT(0xEC57E80A, out);
 }
 
+static inline uint32_t crypto1_parity(uint32_t in) {
+    in ^= in >> 16;
+    in ^= in >> 8;
+    in ^= in >> 4;
+    return 0x6996 >> (in & 0xf) & 1;
+}
+
+// Odd and even halves swap roles on every bit, so stepping two bits at a time keeps them in place
+static inline uint32_t crypto1_pair(Crypto1* crypto1, uint32_t in, uint32_t is_encrypted) {
+    uint32_t odd = crypto1->odd;
+    uint32_t even = crypto1->even;
+
+    uint32_t out = crypto1_filter(odd);
+    uint32_t feed = (in & 1) ^ (out & is_encrypted);
+    even = even << 1 | (feed ^ crypto1_parity((LF_POLY_ODD & odd) ^ (LF_POLY_EVEN & even)));
+
+    uint32_t out_next = crypto1_filter(even);
+    feed = (in >> 1 & 1) ^ (out_next & is_encrypted);
+    odd = odd << 1 | (feed ^ crypto1_parity((LF_POLY_ODD & even) ^ (LF_POLY_EVEN & odd)));
+
+    crypto1->odd = odd;
+    crypto1->even = even;
+    return out | out_next << 1;
+}
+
+static inline uint8_t crypto1_step_byte(Crypto1* crypto1, uint8_t in, uint32_t is_encrypted) {
+    uint8_t out = crypto1_pair(crypto1, in, is_encrypted);
+    out |= crypto1_pair(crypto1, in >> 2, is_encrypted) << 2;
+    out |= crypto1_pair(crypto1, in >> 4, is_encrypted) << 4;
+    out |= crypto1_pair(crypto1, in >> 6, is_encrypted) << 6;
+    return out;
+}
+
 uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     furi_assert(crypto1);
     uint8_t out = crypto1_filter(crypto1->odd);
@@ -58,7 +112,7 @@ uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     feed ^= !!in;
     feed ^= LF_POLY_ODD & crypto1->odd;
     feed ^= LF_POLY_EVEN & crypto1->even;
-    crypto1->even = crypto1->even << 1 | (nfc_util_even_parity32(feed));
+    crypto1->even = crypto1->even << 1 | crypto1_parity(feed);
 
     FURI_SWAP(crypto1->odd, crypto1->even);
     return out;
@@ -66,18 +120,15 @@ uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
 
 uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     furi_assert(crypto1);
-    uint8_t out = 0;
-    for(uint8_t i = 0; i < 8; i++) {
-        out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
-    }
-    return out;
+    return crypto1_step_byte(crypto1, in, !!is_encrypted);
 }
 
 uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     furi_assert(crypto1);
+    // Bits are clocked LSB first within bytes taken in big endian order
     uint32_t out = 0;
-    for(uint8_t i = 0; i < 32; i++) {
-        out |= (uint32_t)crypto1_bit(crypto1, BEBIT(in, i), is_encrypted) << (24 ^ i);
+    for(int8_t shift = 24; shift >= 0; shift -= 8) {
+        out |= (uint32_t)crypto1_step_byte(crypto1, in >> shift, !!is_encrypted) << shift;
     }
     return out;
 }
@@ -106,9 +157,14 @@ void crypto1_decrypt(Crypto1* crypto, const BitBuffer* buff, BitBuffer* out) {
         decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 3)) << 3;
         bit_buffer_set_byte(out, 0, decrypted_byte);
     } else {
+        // Parity bit of each byte is encrypted with the first keystream bit of the next one
+        const uint8_t* encrypted_parity = bit_buffer_get_parity(buff);
         for(size_t i = 0; i < bits / 8; i++) {
-            uint8_t decrypted_byte = crypto1_byte(crypto, 0, 0) ^ encrypted_data[i];
-            bit_buffer_set_byte(out, i, decrypted_byte);
+            uint8_t decrypted_byte = crypto1_step_byte(crypto, 0, 0) ^ encrypted_data[i];
+            bool parity_bit = (FURI_BIT(encrypted_parity[i / 8], i % 8) ^
+                               crypto1_filter(crypto->odd)) &
+                              0x01;
+            bit_buffer_set_byte_with_parity(out, i, decrypted_byte, parity_bit);
         }
     }
 }
@@ -129,8 +185,8 @@ void crypto1_encrypt(Crypto1* crypto, uint8_t* keystream, const BitBuffer* buff,
         bit_buffer_set_byte(out, 0, encrypted_byte);
     } else {
         for(size_t i = 0; i < bits / 8; i++) {
-            uint8_t encrypted_byte = crypto1_byte(crypto, keystream ? keystream[i] : 0, 0) ^
-                                     plain_data[i];
+            uint8_t encrypted_byte =
+                crypto1_step_byte(crypto, keystream ? keystream[i] : 0, 0) ^ plain_data[i];
             bool parity_bit =
                 ((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(plain_data[i])) & 0x01);
             bit_buffer_set_byte_with_parity(out, i, encrypted_byte, parity_bit);
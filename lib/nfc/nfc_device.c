@@ -6,6 +6,8 @@
 #include "nfc_common.h"
 #include "protocols/nfc_device_defs.h"
 
+#define TAG "NfcDevice"
+
 #define NFC_FILE_HEADER "Flipper NFC device"
 #define NFC_DEV_TYPE_ERROR "Protocol type mismatch"
 
@@ -341,6 +343,11 @@ bool nfc_device_load(NfcDevice* instance, const char* path) {
         if(furi_string_cmp_str(temp_str, NFC_FILE_HEADER)) break;
         if(version < NFC_MINIMUM_SUPPORTED_FORMAT_VERSION) break;
 
+        // Protocol loaders rewind and look keys up many times, index is optional
+        if(!flipper_format_build_index(ff)) {
+            FURI_LOG_W(TAG, "Failed to index %s", path);
+        }
+
         // Select loading method
         loaded = (version < NFC_UNIFIED_FORMAT_VERSION) ?
                      nfc_device_load_legacy(instance, ff, version) :
@@ -37,3 +37,16 @@ uint32_t subghz_protocol_blocks_get_hash_data_long(SubGhzBlockDecoder* decoder,
     }
     return hash.full;
 }
+
+void subghz_protocol_blocks_set_wakeup(
+    SubGhzProtocolDecoderWakeup* wakeup,
+    bool level,
+    uint32_t center,
+    uint32_t delta) {
+    furi_check(wakeup);
+    furi_check(delta);
+
+    wakeup->level = level;
+    wakeup->duration_min = (center >= delta) ? (center - delta + 1) : 0;
+    wakeup->duration_max = center + delta - 1;
+}
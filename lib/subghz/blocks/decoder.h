@@ -4,6 +4,8 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "../types.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -49,6 +51,19 @@ uint8_t subghz_protocol_blocks_get_hash_data(SubGhzBlockDecoder* decoder, size_t
  */
 uint32_t subghz_protocol_blocks_get_hash_data_long(SubGhzBlockDecoder* decoder, size_t len);
 
+/**
+ * Fill the wakeup window matching `DURATION_DIFF(duration, center) < delta`.
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ * @param level Signal level true-high false-low
+ * @param center Expected duration, us
+ * @param delta Allowed deviation (exclusive), us
+ */
+void subghz_protocol_blocks_set_wakeup(
+    SubGhzProtocolDecoderWakeup* wakeup,
+    bool level,
+    uint32_t center,
+    uint32_t delta);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
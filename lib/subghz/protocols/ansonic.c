@@ -55,6 +55,9 @@ const SubGhzProtocolDecoder subghz_protocol_ansonic_decoder = {
     .deserialize = subghz_protocol_decoder_ansonic_deserialize,
     .get_string = subghz_protocol_decoder_ansonic_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_ansonic_is_idle,
+    .get_wakeup = subghz_protocol_decoder_ansonic_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_ansonic_encoder = {
@@ -209,6 +212,23 @@ void subghz_protocol_decoder_ansonic_reset(void* context) {
     instance->decoder.parser_step = AnsonicDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_ansonic_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderAnsonic* instance = context;
+    return instance->decoder.parser_step == AnsonicDecoderStepReset;
+}
+
+void subghz_protocol_decoder_ansonic_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_ansonic_const.te_short * 35,
+        subghz_protocol_ansonic_const.te_delta * 35);
+}
+
 void subghz_protocol_decoder_ansonic_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderAnsonic* instance = context;
@@ -73,6 +73,22 @@ void subghz_protocol_decoder_ansonic_reset(void* context);
  */
 void subghz_protocol_decoder_ansonic_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderAnsonic is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderAnsonic instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_ansonic_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderAnsonic.
+ * @param context Pointer to a SubGhzProtocolDecoderAnsonic instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_ansonic_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderAnsonic instance
@@ -73,6 +73,20 @@ void subghz_protocol_decoder_bett_reset(void* context);
  */
 void subghz_protocol_decoder_bett_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderBETT is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderBETT instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_bett_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderBETT.
+ * @param context Pointer to a SubGhzProtocolDecoderBETT instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_bett_get_wakeup(void* context, SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderBETT instance
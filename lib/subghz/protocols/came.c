@@ -61,6 +61,9 @@ const SubGhzProtocolDecoder subghz_protocol_came_decoder = {
     .deserialize = subghz_protocol_decoder_came_deserialize,
     .get_string = subghz_protocol_decoder_came_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_came_is_idle,
+    .get_wakeup = subghz_protocol_decoder_came_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_encoder = {
@@ -237,6 +240,21 @@ void subghz_protocol_decoder_came_reset(void* context) {
     instance->decoder.parser_step = CameDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_came_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderCame* instance = context;
+    return instance->decoder.parser_step == CameDecoderStepReset;
+}
+
+void subghz_protocol_decoder_came_get_wakeup(void* context, SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_came_const.te_short * 56,
+        subghz_protocol_came_const.te_delta * 47);
+}
+
 void subghz_protocol_decoder_came_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderCame* instance = context;
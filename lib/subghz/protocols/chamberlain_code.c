@@ -79,6 +79,9 @@ const SubGhzProtocolDecoder subghz_protocol_chamb_code_decoder = {
     .deserialize = subghz_protocol_decoder_chamb_code_deserialize,
     .get_string = subghz_protocol_decoder_chamb_code_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_chamb_code_is_idle,
+    .get_wakeup = subghz_protocol_decoder_chamb_code_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_chamb_code_encoder = {
@@ -283,6 +286,23 @@ void subghz_protocol_decoder_chamb_code_reset(void* context) {
     instance->decoder.parser_step = Chamb_CodeDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_chamb_code_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderChamb_Code* instance = context;
+    return instance->decoder.parser_step == Chamb_CodeDecoderStepReset;
+}
+
+void subghz_protocol_decoder_chamb_code_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_chamb_code_const.te_short * 39,
+        subghz_protocol_chamb_code_const.te_delta * 20);
+}
+
 static bool subghz_protocol_chamb_code_to_bit(uint64_t* data, uint8_t size) {
     uint64_t data_tmp = data[0];
     uint64_t data_res = 0;
@@ -73,6 +73,22 @@ void subghz_protocol_decoder_chamb_code_reset(void* context);
  */
 void subghz_protocol_decoder_chamb_code_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderChamb_Code is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderChamb_Code instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_chamb_code_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderChamb_Code.
+ * @param context Pointer to a SubGhzProtocolDecoderChamb_Code instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_chamb_code_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderChamb_Code instance
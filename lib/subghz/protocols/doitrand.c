@@ -56,6 +56,9 @@ const SubGhzProtocolDecoder subghz_protocol_doitrand_decoder = {
     .deserialize = subghz_protocol_decoder_doitrand_deserialize,
     .get_string = subghz_protocol_decoder_doitrand_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_doitrand_is_idle,
+    .get_wakeup = subghz_protocol_decoder_doitrand_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_doitrand_encoder = {
@@ -208,6 +211,23 @@ void subghz_protocol_decoder_doitrand_reset(void* context) {
     instance->decoder.parser_step = DoitrandDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_doitrand_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderDoitrand* instance = context;
+    return instance->decoder.parser_step == DoitrandDecoderStepReset;
+}
+
+void subghz_protocol_decoder_doitrand_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_doitrand_const.te_short * 62,
+        subghz_protocol_doitrand_const.te_delta * 30);
+}
+
 void subghz_protocol_decoder_doitrand_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderDoitrand* instance = context;
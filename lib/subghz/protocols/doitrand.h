@@ -73,6 +73,22 @@ void subghz_protocol_decoder_doitrand_reset(void* context);
  */
 void subghz_protocol_decoder_doitrand_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderDoitrand is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderDoitrand instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_doitrand_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderDoitrand.
+ * @param context Pointer to a SubGhzProtocolDecoderDoitrand instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_doitrand_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderDoitrand instance
@@ -201,7 +201,6 @@ static bool subghz_protocol_faac_slh_gen_data(SubGhzProtocolEncoderFaacSLH* inst
     uint32_t hop = 0;
     uint32_t decrypt = 0;
     uint64_t man = 0;
-    int res = 0;
     char fixx[8] = {};
     int shiftby = 32;
     for(int i = 0; i < 8; i++) {
@@ -219,21 +218,18 @@ static bool subghz_protocol_faac_slh_gen_data(SubGhzProtocolEncoderFaacSLH* inst
         decrypt = fixx[2] << 28 | fixx[3] << 24 | fixx[4] << 20 |
                   (instance->generic.cnt & 0xFFFFF);
     }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            res = strcmp(furi_string_get_cstr(manufacture_code->name), instance->manufacture_name);
-            if(res == 0) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_FAAC:
-                    //FAAC Learning
-                    man = subghz_protocol_keeloq_common_faac_learning(
-                        instance->generic.seed, manufacture_code->key);
-                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                    break;
-                }
-                break;
-            }
+    const SubGhzKey* manufacture_code =
+        subghz_keystore_find(instance->keystore, instance->manufacture_name);
+    if(manufacture_code) {
+        switch(manufacture_code->type) {
+        case KEELOQ_LEARNING_FAAC:
+            //FAAC Learning
+            man = subghz_protocol_keeloq_common_faac_learning(
+                instance->generic.seed, manufacture_code->key);
+            hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+            break;
         }
+    }
     if(hop) {
         instance->generic.data = (uint64_t)fix << 32 | hop;
     }
@@ -561,7 +557,7 @@ static void subghz_protocol_faac_slh_check_remote_controller(
                 man = subghz_protocol_keeloq_common_faac_learning(
                     instance->seed, manufacture_code->key);
                 decrypt = subghz_protocol_keeloq_common_decrypt(code_hop, man);
-                *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                *manufacture_name = manufacture_code->name;
                 break;
             }
         }
@@ -49,6 +49,9 @@ const SubGhzProtocolDecoder subghz_protocol_gate_tx_decoder = {
     .deserialize = subghz_protocol_decoder_gate_tx_deserialize,
     .get_string = subghz_protocol_decoder_gate_tx_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_gate_tx_is_idle,
+    .get_wakeup = subghz_protocol_decoder_gate_tx_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_gate_tx_encoder = {
@@ -201,6 +204,23 @@ void subghz_protocol_decoder_gate_tx_reset(void* context) {
     instance->decoder.parser_step = GateTXDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_gate_tx_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderGateTx* instance = context;
+    return instance->decoder.parser_step == GateTXDecoderStepReset;
+}
+
+void subghz_protocol_decoder_gate_tx_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_gate_tx_const.te_short * 47,
+        subghz_protocol_gate_tx_const.te_delta * 47);
+}
+
 void subghz_protocol_decoder_gate_tx_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderGateTx* instance = context;
@@ -73,6 +73,22 @@ void subghz_protocol_decoder_gate_tx_reset(void* context);
  */
 void subghz_protocol_decoder_gate_tx_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderGateTx is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderGateTx instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_gate_tx_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderGateTx.
+ * @param context Pointer to a SubGhzProtocolDecoderGateTx instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_gate_tx_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderGateTx instance
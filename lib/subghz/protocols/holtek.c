@@ -59,6 +59,9 @@ const SubGhzProtocolDecoder subghz_protocol_holtek_decoder = {
     .deserialize = subghz_protocol_decoder_holtek_deserialize,
     .get_string = subghz_protocol_decoder_holtek_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_holtek_is_idle,
+    .get_wakeup = subghz_protocol_decoder_holtek_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_holtek_encoder = {
@@ -214,6 +217,23 @@ void subghz_protocol_decoder_holtek_reset(void* context) {
     instance->decoder.parser_step = HoltekDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_holtek_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderHoltek* instance = context;
+    return instance->decoder.parser_step == HoltekDecoderStepReset;
+}
+
+void subghz_protocol_decoder_holtek_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_holtek_const.te_short * 36,
+        subghz_protocol_holtek_const.te_delta * 36);
+}
+
 void subghz_protocol_decoder_holtek_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderHoltek* instance = context;
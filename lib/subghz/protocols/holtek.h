@@ -73,6 +73,20 @@ void subghz_protocol_decoder_holtek_reset(void* context);
  */
 void subghz_protocol_decoder_holtek_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderHoltek is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderHoltek instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_holtek_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderHoltek.
+ * @param context Pointer to a SubGhzProtocolDecoderHoltek instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_holtek_get_wakeup(void* context, SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderHoltek instance
@@ -73,6 +73,22 @@ void subghz_protocol_decoder_holtek_th12x_reset(void* context);
  */
 void subghz_protocol_decoder_holtek_th12x_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderHoltek_HT12X is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderHoltek_HT12X instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_holtek_th12x_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderHoltek_HT12X.
+ * @param context Pointer to a SubGhzProtocolDecoderHoltek_HT12X instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_holtek_th12x_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderHoltek_HT12X instance
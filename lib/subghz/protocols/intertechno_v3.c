@@ -58,6 +58,9 @@ const SubGhzProtocolDecoder subghz_protocol_intertechno_v3_decoder = {
     .deserialize = subghz_protocol_decoder_intertechno_v3_deserialize,
     .get_string = subghz_protocol_decoder_intertechno_v3_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_intertechno_v3_is_idle,
+    .get_wakeup = subghz_protocol_decoder_intertechno_v3_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_intertechno_v3_encoder = {
@@ -236,6 +239,23 @@ void subghz_protocol_decoder_intertechno_v3_reset(void* context) {
     instance->decoder.parser_step = IntertechnoV3DecoderStepReset;
 }
 
+bool subghz_protocol_decoder_intertechno_v3_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderIntertechno_V3* instance = context;
+    return instance->decoder.parser_step == IntertechnoV3DecoderStepReset;
+}
+
+void subghz_protocol_decoder_intertechno_v3_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_intertechno_v3_const.te_short * 37,
+        subghz_protocol_intertechno_v3_const.te_delta * 15);
+}
+
 void subghz_protocol_decoder_intertechno_v3_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderIntertechno_V3* instance = context;
@@ -74,6 +74,22 @@ void subghz_protocol_decoder_intertechno_v3_reset(void* context);
  */
 void subghz_protocol_decoder_intertechno_v3_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderIntertechno_V3 is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderIntertechno_V3 instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_intertechno_v3_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderIntertechno_V3.
+ * @param context Pointer to a SubGhzProtocolDecoderIntertechno_V3 instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_intertechno_v3_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderIntertechno_V3 instance
@@ -67,6 +67,9 @@ const SubGhzProtocolDecoder subghz_protocol_keeloq_decoder = {
     .deserialize = subghz_protocol_decoder_keeloq_deserialize,
     .get_string = subghz_protocol_decoder_keeloq_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_keeloq_is_idle,
+    .get_wakeup = subghz_protocol_decoder_keeloq_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_keeloq_encoder = {
@@ -139,7 +142,6 @@ static bool subghz_protocol_keeloq_gen_data(
     uint32_t hop = 0;
     uint64_t man = 0;
     uint64_t code_found_reverse;
-    int res = 0;
     // No mf name set? -> set to ""
     if(instance->manufacture_name == 0x0) {
         instance->manufacture_name = "";
@@ -266,69 +268,61 @@ static bool subghz_protocol_keeloq_gen_data(
             }
             // Old type selector fixage for compatibilitiy with old signal files
             uint8_t kl_type_en = instance->keystore->kl_type;
-            for
-                M_EACH(
-                    manufacture_code,
-                    *subghz_keystore_get_data(instance->keystore),
-                    SubGhzKeyArray_t) {
-                    res = strcmp(
-                        furi_string_get_cstr(manufacture_code->name), instance->manufacture_name);
-                    if(res == 0) {
-                        switch(manufacture_code->type) {
-                        case KEELOQ_LEARNING_SIMPLE:
-                            //Simple Learning
-                            hop = subghz_protocol_keeloq_common_encrypt(
-                                decrypt, manufacture_code->key);
-                            break;
-                        case KEELOQ_LEARNING_NORMAL:
-                            //Simple Learning
-                            man = subghz_protocol_keeloq_common_normal_learning(
-                                fix, manufacture_code->key);
-                            hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            break;
-                        case KEELOQ_LEARNING_SECURE:
-                            //Secure Learning
-                            man = subghz_protocol_keeloq_common_secure_learning(
-                                fix, instance->generic.seed, manufacture_code->key);
-                            hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            break;
-                        case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                            //Magic XOR type-1 Learning
-                            man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                                instance->generic.serial, manufacture_code->key);
-                            hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            break;
-                        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                            //Magic Serial Type 1 learning
-                            man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                                fix, manufacture_code->key);
-                            hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            break;
-                        case KEELOQ_LEARNING_UNKNOWN:
-                            if(kl_type_en == 1) {
-                                hop = subghz_protocol_keeloq_common_encrypt(
-                                    decrypt, manufacture_code->key);
-                            }
-                            if(kl_type_en == 2) {
-                                man = subghz_protocol_keeloq_common_normal_learning(
-                                    fix, manufacture_code->key);
-                                hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            }
-                            if(kl_type_en == 3) {
-                                man = subghz_protocol_keeloq_common_secure_learning(
-                                    fix, instance->generic.seed, manufacture_code->key);
-                                hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            }
-                            if(kl_type_en == 4) {
-                                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                                    instance->generic.serial, manufacture_code->key);
-                                hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            }
-                            break;
-                        }
-                        break;
+            const SubGhzKey* manufacture_code =
+                subghz_keystore_find(instance->keystore, instance->manufacture_name);
+            if(manufacture_code) {
+                switch(manufacture_code->type) {
+                case KEELOQ_LEARNING_SIMPLE:
+                    //Simple Learning
+                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, manufacture_code->key);
+                    break;
+                case KEELOQ_LEARNING_NORMAL:
+                    //Simple Learning
+                    man = subghz_protocol_keeloq_common_normal_learning(
+                        fix, manufacture_code->key);
+                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+                    break;
+                case KEELOQ_LEARNING_SECURE:
+                    //Secure Learning
+                    man = subghz_protocol_keeloq_common_secure_learning(
+                        fix, instance->generic.seed, manufacture_code->key);
+                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+                    break;
+                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+                    //Magic XOR type-1 Learning
+                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
+                        instance->generic.serial, manufacture_code->key);
+                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+                    break;
+                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+                    //Magic Serial Type 1 learning
+                    man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
+                        fix, manufacture_code->key);
+                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+                    break;
+                case KEELOQ_LEARNING_UNKNOWN:
+                    if(kl_type_en == 1) {
+                        hop = subghz_protocol_keeloq_common_encrypt(
+                            decrypt, manufacture_code->key);
+                    }
+                    if(kl_type_en == 2) {
+                        man = subghz_protocol_keeloq_common_normal_learning(
+                            fix, manufacture_code->key);
+                        hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+                    }
+                    if(kl_type_en == 3) {
+                        man = subghz_protocol_keeloq_common_secure_learning(
+                            fix, instance->generic.seed, manufacture_code->key);
+                        hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+                    }
+                    if(kl_type_en == 4) {
+                        man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
+                            instance->generic.serial, manufacture_code->key);
+                        hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
                     }
+                    break;
                 }
+            }
         }
     }
     if(hop || (prog_mode == PROG_MODE_KEELOQ_DEA_MIO) || (prog_mode == PROG_MODE_KEELOQ_BFT)) {
@@ -624,6 +618,23 @@ void subghz_protocol_decoder_keeloq_reset(void* context) {
     instance->keystore->kl_type = 0;
 }
 
+bool subghz_protocol_decoder_keeloq_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderKeeloq* instance = context;
+    return instance->decoder.parser_step == KeeloqDecoderStepReset;
+}
+
+void subghz_protocol_decoder_keeloq_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        true,
+        subghz_protocol_keeloq_const.te_short,
+        subghz_protocol_keeloq_const.te_delta);
+}
+
 void subghz_protocol_decoder_keeloq_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderKeeloq* instance = context;
@@ -767,6 +778,237 @@ static inline bool subghz_protocol_keeloq_check_decrypt_centurion(
     return false;
 }
 
+// Learning applied to the byte mirrored manufacture key
+#define KEELOQ_LEARNING_MIRRORED 0x80u
+
+// Learnings tried for keys of unknown learning type, in order
+static const uint8_t subghz_protocol_keeloq_learning_unknown[] = {
+    KEELOQ_LEARNING_SIMPLE,
+    KEELOQ_LEARNING_SIMPLE | KEELOQ_LEARNING_MIRRORED,
+    KEELOQ_LEARNING_NORMAL,
+    KEELOQ_LEARNING_NORMAL | KEELOQ_LEARNING_MIRRORED,
+    KEELOQ_LEARNING_SECURE,
+    KEELOQ_LEARNING_SECURE | KEELOQ_LEARNING_MIRRORED,
+    KEELOQ_LEARNING_MAGIC_XOR_TYPE_1,
+    KEELOQ_LEARNING_MAGIC_XOR_TYPE_1 | KEELOQ_LEARNING_MIRRORED,
+};
+
+// Keys of known learning type use exactly that learning, indexed by type
+static const uint8_t subghz_protocol_keeloq_learning_known[] = {
+    KEELOQ_LEARNING_UNKNOWN,
+    KEELOQ_LEARNING_SIMPLE,
+    KEELOQ_LEARNING_NORMAL,
+    KEELOQ_LEARNING_SECURE,
+    KEELOQ_LEARNING_MAGIC_XOR_TYPE_1,
+    KEELOQ_LEARNING_FAAC,
+    KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1,
+    KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2,
+    KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3,
+};
+
+/** 
+ * Get the learnings to try for a manufacture key
+ * @param type Learning type of the key from the keystore
+ * @param learnings Pointer to the array of learnings
+ * @return number of learnings
+ */
+static size_t subghz_protocol_keeloq_get_learnings(uint16_t type, const uint8_t** learnings) {
+    if(type == KEELOQ_LEARNING_UNKNOWN) {
+        *learnings = subghz_protocol_keeloq_learning_unknown;
+        return COUNT_OF(subghz_protocol_keeloq_learning_unknown);
+    } else if(
+        (type < COUNT_OF(subghz_protocol_keeloq_learning_known)) &&
+        (type != KEELOQ_LEARNING_FAAC)) {
+        *learnings = &subghz_protocol_keeloq_learning_known[type];
+        return 1;
+    } else {
+        // FAAC SLH keys are handled by their own protocol
+        *learnings = NULL;
+        return 0;
+    }
+}
+
+/** 
+ * Get the manufacture key the learning is applied to
+ * @param learning Learning, KEELOQ_LEARNING_* optionally with KEELOQ_LEARNING_MIRRORED
+ * @param key Manufacture key
+ * @return Manufacture key, byte mirrored if requested by the learning
+ */
+static uint64_t subghz_protocol_keeloq_learning_key(uint8_t learning, uint64_t key) {
+    if(learning & KEELOQ_LEARNING_MIRRORED) {
+        uint64_t man_rev = 0;
+        uint64_t man_rev_byte = 0;
+        for(uint8_t i = 0; i < 64; i += 8) {
+            man_rev_byte = (uint8_t)(key >> i);
+            man_rev = man_rev | man_rev_byte << (56 - i);
+        }
+        key = man_rev;
+    }
+    return key;
+}
+
+/** 
+ * Derive the decryption key for the remote from the manufacture key
+ * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param fix Fix part of the parcel
+ * @param learning Learning, KEELOQ_LEARNING_* optionally with KEELOQ_LEARNING_MIRRORED
+ * @param key Manufacture key
+ * @return Decryption key
+ */
+static uint64_t subghz_protocol_keeloq_derive_man(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint8_t learning,
+    uint64_t key) {
+    key = subghz_protocol_keeloq_learning_key(learning, key);
+
+    switch(learning & ~KEELOQ_LEARNING_MIRRORED) {
+    case KEELOQ_LEARNING_NORMAL:
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        return subghz_protocol_keeloq_common_normal_learning(fix, key);
+    case KEELOQ_LEARNING_SECURE:
+        return subghz_protocol_keeloq_common_secure_learning(fix, instance->seed, key);
+    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+        return subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+        return subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+        return subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+        return subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, key);
+    case KEELOQ_LEARNING_SIMPLE:
+    default:
+        return key;
+    }
+}
+
+/** 
+ * Validate the decrypted hop part of the parcel
+ * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param manufacture_code Pointer to a SubGhzKey from the keystore
+ * @param decrypt Decrypted hop part of the parcel
+ * @param fix Fix part of the parcel
+ * @return true if decrypted data is valid
+ */
+static bool subghz_protocol_keeloq_check_decrypted(
+    SubGhzBlockGeneric* instance,
+    const SubGhzKey* manufacture_code,
+    uint32_t decrypt,
+    uint32_t fix) {
+    // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
+    // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
+    // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
+    uint16_t end_serial = (uint16_t)(fix & 0xFF);
+    uint8_t btn = (uint8_t)(fix >> 28);
+
+    if((manufacture_code->type == KEELOQ_LEARNING_NORMAL) &&
+       (strcmp(manufacture_code->name, "Centurion") == 0)) {
+        return subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn);
+    } else {
+        return subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial);
+    }
+}
+
+/** 
+ * Try to decrypt the parcel with one manufacture key and learning
+ * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param manufacture_code Pointer to a SubGhzKey from the keystore
+ * @param learning Learning, KEELOQ_LEARNING_* optionally with KEELOQ_LEARNING_MIRRORED
+ * @param fix Fix part of the parcel
+ * @param hop Hop encrypted part of the parcel
+ * @return true if decrypted data is valid
+ */
+static bool subghz_protocol_keeloq_check_learning(
+    SubGhzBlockGeneric* instance,
+    const SubGhzKey* manufacture_code,
+    uint8_t learning,
+    uint32_t fix,
+    uint32_t hop) {
+    uint64_t man =
+        subghz_protocol_keeloq_derive_man(instance, fix, learning, manufacture_code->key);
+    uint32_t decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+
+    return subghz_protocol_keeloq_check_decrypted(instance, manufacture_code, decrypt, fix);
+}
+
+// Keystore candidates decrypted together by subghz_protocol_keeloq_common_decrypt_multi
+typedef struct {
+    const SubGhzKey* codes[KEELOQ_MULTI_KEY_COUNT];
+    size_t key_indexes[KEELOQ_MULTI_KEY_COUNT];
+    uint8_t learnings[KEELOQ_MULTI_KEY_COUNT];
+    uint64_t mans[KEELOQ_MULTI_KEY_COUNT];
+    size_t count;
+    size_t match;
+} SubGhzProtocolKeeloqBatch;
+
+/** 
+ * Try to decrypt the parcel with a batch of candidates, in order
+ * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param batch Pointer to a SubGhzProtocolKeeloqBatch, emptied if nothing matched
+ * @param fix Fix part of the parcel
+ * @param hop Hop encrypted part of the parcel
+ * @return true if a candidate matched, its index is in batch->match
+ */
+static bool subghz_protocol_keeloq_check_batch(
+    SubGhzBlockGeneric* instance,
+    SubGhzProtocolKeeloqBatch* batch,
+    uint32_t fix,
+    uint32_t hop) {
+    uint64_t keys[KEELOQ_MULTI_KEY_COUNT];
+    uint64_t mans[KEELOQ_MULTI_KEY_COUNT];
+    uint8_t positions[KEELOQ_MULTI_KEY_COUNT];
+    size_t normal_count = 0;
+    size_t secure_count = 0;
+
+    // Learnings built on decryption are derived for the whole batch at once:
+    // normal learning keys fill the array from the start, secure from the end
+    for(size_t i = 0; i < batch->count; i++) {
+        uint8_t learning = batch->learnings[i];
+        uint64_t key = batch->codes[i]->key;
+        switch(learning & ~KEELOQ_LEARNING_MIRRORED) {
+        case KEELOQ_LEARNING_NORMAL:
+            positions[normal_count] = i;
+            keys[normal_count++] = subghz_protocol_keeloq_learning_key(learning, key);
+            break;
+        case KEELOQ_LEARNING_SECURE:
+            secure_count++;
+            positions[KEELOQ_MULTI_KEY_COUNT - secure_count] = i;
+            keys[KEELOQ_MULTI_KEY_COUNT - secure_count] =
+                subghz_protocol_keeloq_learning_key(learning, key);
+            break;
+        default:
+            batch->mans[i] = subghz_protocol_keeloq_derive_man(instance, fix, learning, key);
+            break;
+        }
+    }
+    if(normal_count) {
+        subghz_protocol_keeloq_common_normal_learning_multi(fix, keys, normal_count, mans);
+        for(size_t i = 0; i < normal_count; i++) {
+            batch->mans[positions[i]] = mans[i];
+        }
+    }
+    if(secure_count) {
+        size_t first = KEELOQ_MULTI_KEY_COUNT - secure_count;
+        subghz_protocol_keeloq_common_secure_learning_multi(
+            fix, instance->seed, &keys[first], secure_count, &mans[first]);
+        for(size_t i = first; i < KEELOQ_MULTI_KEY_COUNT; i++) {
+            batch->mans[positions[i]] = mans[i];
+        }
+    }
+
+    uint32_t decrypts[KEELOQ_MULTI_KEY_COUNT];
+    subghz_protocol_keeloq_common_decrypt_multi(hop, batch->mans, batch->count, decrypts);
+    for(size_t i = 0; i < batch->count; i++) {
+        if(subghz_protocol_keeloq_check_decrypted(instance, batch->codes[i], decrypts[i], fix)) {
+            batch->match = i;
+            return true;
+        }
+    }
+
+    batch->count = 0;
+    return false;
+}
+
 /** 
  * Checking the accepted code against the database manafacture key
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -782,14 +1024,6 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     uint32_t hop,
     SubGhzKeystore* keystore,
     const char** manufacture_name) {
-    // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
-    // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
-    // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
-
-    uint16_t end_serial = (uint16_t)(fix & 0xFF);
-    uint8_t btn = (uint8_t)(fix >> 28);
-    uint32_t decrypt = 0;
-    uint64_t man;
     bool mf_not_set = false;
     // TODO:
     // if(mfname == 0x0) {
@@ -803,186 +1037,69 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     } else if(strcmp(mfname, "") == 0) {
         mf_not_set = true;
     }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if((strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0)) {
-                        if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    } else {
-                        if(subghz_protocol_keeloq_check_decrypt(
-                               instance, decrypt, btn, end_serial)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    }
-                    break;
-                case KEELOQ_LEARNING_SECURE:
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                    man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                    man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    uint64_t man_rev = 0;
-                    uint64_t man_rev_byte = 0;
-                    for(uint8_t i = 0; i < 64; i += 8) {
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev | man_rev_byte << (56 - i);
-                    }
-
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
 
-                    //###########################
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Secure Learning
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Magic xor type1 learning
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
+    SubGhzKeyArray_t* manufacture_codes = subghz_keystore_get_data(keystore);
+    uint32_t serial = fix & 0x0FFFFFFF;
+    const SubGhzKey* manufacture_code = NULL;
+    uint8_t learning = 0;
+
+    // Repeated transmission from a known remote: try the key and learning that matched last time
+    SubGhzKeystoreHint hint;
+    if(subghz_keystore_hint_get(keystore, serial, &hint) &&
+       hint.key_index < SubGhzKeyArray_size(*manufacture_codes)) {
+        const SubGhzKey* hint_code = SubGhzKeyArray_cget(*manufacture_codes, hint.key_index);
+        if((mf_not_set || (strcmp(hint_code->name, mfname) == 0)) &&
+           subghz_protocol_keeloq_check_learning(instance, hint_code, hint.learning, fix, hop)) {
+            manufacture_code = hint_code;
+            learning = hint.learning;
+            subghz_keystore_hint_set(keystore, serial, hint.key_index, learning);
+        }
+    }
 
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
+    // Full keystore scan, candidates are checked in batches of KEELOQ_MULTI_KEY_COUNT
+    if(!manufacture_code) {
+        SubGhzProtocolKeeloqBatch* batch = malloc(sizeof(SubGhzProtocolKeeloqBatch));
+        bool found = false;
+        size_t key_index = 0;
+        for
+            M_EACH(code, *manufacture_codes, SubGhzKeyArray_t) {
+                if(mf_not_set || (strcmp(code->name, mfname) == 0)) {
+                    const uint8_t* learnings = NULL;
+                    size_t learning_count =
+                        subghz_protocol_keeloq_get_learnings(code->type, &learnings);
+                    for(size_t i = 0; (i < learning_count) && !found; i++) {
+                        batch->codes[batch->count] = code;
+                        batch->key_indexes[batch->count] = key_index;
+                        batch->learnings[batch->count] = learnings[i];
+                        batch->count++;
+                        if(batch->count == KEELOQ_MULTI_KEY_COUNT) {
+                            found = subghz_protocol_keeloq_check_batch(instance, batch, fix, hop);
+                        }
                     }
-
-                    break;
+                    if(found) break;
                 }
+                key_index++;
             }
+        if(!found && batch->count) {
+            found = subghz_protocol_keeloq_check_batch(instance, batch, fix, hop);
+        }
+
+        if(found) {
+            manufacture_code = batch->codes[batch->match];
+            learning = batch->learnings[batch->match];
+            subghz_keystore_hint_set(keystore, serial, batch->key_indexes[batch->match], learning);
+        }
+        free(batch);
+    }
+
+    if(manufacture_code) {
+        *manufacture_name = manufacture_code->name;
+        keystore->mfname = *manufacture_name;
+        if(manufacture_code->type == KEELOQ_LEARNING_UNKNOWN) {
+            keystore->kl_type = learning & ~KEELOQ_LEARNING_MIRRORED;
         }
+        return 1;
+    }
 
     // MF not found
     *manufacture_name = "Unknown";
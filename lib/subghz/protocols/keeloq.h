@@ -74,6 +74,20 @@ void subghz_protocol_decoder_keeloq_reset(void* context);
  */
 void subghz_protocol_decoder_keeloq_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderKeeloq is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderKeeloq instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_keeloq_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderKeeloq.
+ * @param context Pointer to a SubGhzProtocolDecoderKeeloq instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_keeloq_get_wakeup(void* context, SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderKeeloq instance
@@ -35,6 +35,59 @@ inline uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const
     return x;
 }
 
+/** Simple Learning Decrypt with many keys at once
+ * Bitsliced: word i holds bit i of the state for every key, one key per bit of the word,
+ * so one pass of the 528 rounds decrypts with up to KEELOQ_MULTI_KEY_COUNT keys.
+ * @param data - keeloq encrypt data
+ * @param keys - manufacture keys (64bit)
+ * @param count - number of keys
+ * @param result - 0xBSSSCCCC for each key
+ */
+void subghz_protocol_keeloq_common_decrypt_multi(
+    const uint32_t data,
+    const uint64_t* keys,
+    size_t count,
+    uint32_t* result) {
+    furi_check(keys);
+    furi_check(result);
+    furi_check(count <= KEELOQ_MULTI_KEY_COUNT);
+
+    uint32_t k[64] = {0};
+    for(size_t j = 0; j < count; j++) {
+        for(size_t i = 0; i < 64; i++) {
+            k[i] |= (uint32_t)bit(keys[j], i) << j;
+        }
+    }
+
+    // Bit i of the state lives in x[(base + i) & 31], shifting is just moving base
+    uint32_t x[32];
+    for(size_t i = 0; i < 32; i++) {
+        x[i] = 0 - (uint32_t)bit(data, i);
+    }
+    uint32_t base = 0;
+    for(uint32_t r = 0; r < 528; r++) {
+        uint32_t a = x[base];
+        uint32_t b = x[(base + 8) & 31];
+        uint32_t c = x[(base + 19) & 31];
+        uint32_t d = x[(base + 25) & 31];
+        uint32_t e = x[(base + 30) & 31];
+        // KEELOQ_NLF in algebraic normal form
+        uint32_t nlf = (a | b) ^ (b & c) ^ (d & (a ^ c)) ^
+                       (e & ((a & ~b) ^ (c & ~a) ^ (d & (b ^ c))));
+        // New bit 0 takes the slot of the old bit 31
+        base = (base - 1) & 31;
+        x[base] ^= x[(base + 16) & 31] ^ k[(15 - r) & 63] ^ nlf;
+    }
+
+    for(size_t j = 0; j < count; j++) {
+        uint32_t value = 0;
+        for(size_t i = 0; i < 32; i++) {
+            value |= bit(x[(base + i) & 31], j) << i;
+        }
+        result[j] = value;
+    }
+}
+
 /** Normal Learning
  * @param data - serial number (28bit)
  * @param key - manufacture (64bit)
@@ -54,6 +107,29 @@ inline uint64_t subghz_protocol_keeloq_common_normal_learning(uint32_t data, con
     return ((uint64_t)k2 << 32) | k1; // key - shifrovanoya
 }
 
+/** Normal Learning with many keys at once
+ * @param data - serial number (28bit)
+ * @param keys - manufacture keys (64bit)
+ * @param count - number of keys
+ * @param result - manufacture for this serial number (64bit) for each key
+ */
+void subghz_protocol_keeloq_common_normal_learning_multi(
+    uint32_t data,
+    const uint64_t* keys,
+    size_t count,
+    uint64_t* result) {
+    uint32_t k1[KEELOQ_MULTI_KEY_COUNT];
+    uint32_t k2[KEELOQ_MULTI_KEY_COUNT];
+
+    data &= 0x0FFFFFFF;
+    subghz_protocol_keeloq_common_decrypt_multi(data | 0x20000000, keys, count, k1);
+    subghz_protocol_keeloq_common_decrypt_multi(data | 0x60000000, keys, count, k2);
+
+    for(size_t j = 0; j < count; j++) {
+        result[j] = ((uint64_t)k2[j] << 32) | k1[j];
+    }
+}
+
 /** Secure Learning
  * @param data - serial number (28bit)
  * @param seed - seed number (32bit)
@@ -74,6 +150,30 @@ inline uint64_t subghz_protocol_keeloq_common_secure_learning(
     return ((uint64_t)k1 << 32) | k2;
 }
 
+/** Secure Learning with many keys at once
+ * @param data - serial number (28bit)
+ * @param seed - seed number (32bit)
+ * @param keys - manufacture keys (64bit)
+ * @param count - number of keys
+ * @param result - manufacture for this serial number (64bit) for each key
+ */
+void subghz_protocol_keeloq_common_secure_learning_multi(
+    uint32_t data,
+    uint32_t seed,
+    const uint64_t* keys,
+    size_t count,
+    uint64_t* result) {
+    uint32_t k1[KEELOQ_MULTI_KEY_COUNT];
+    uint32_t k2[KEELOQ_MULTI_KEY_COUNT];
+
+    subghz_protocol_keeloq_common_decrypt_multi(data & 0x0FFFFFFF, keys, count, k1);
+    subghz_protocol_keeloq_common_decrypt_multi(seed, keys, count, k2);
+
+    for(size_t j = 0; j < count; j++) {
+        result[j] = ((uint64_t)k1[j] << 32) | k2[j];
+    }
+}
+
 /** Magic_xor_type1 Learning
  * @param data - serial number (28bit)
  * @param xor - magic xor (64bit)
@@ -4,6 +4,10 @@
 
 #include <furi.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*
  * Keeloq
  * https://ru.wikipedia.org/wiki/KeeLoq
@@ -12,6 +16,11 @@
  */
 #define KEELOQ_NLF 0x3A5C742E
 
+/*
+ * Number of keys processed at once by the *_multi functions, one per bit of a word
+ */
+#define KEELOQ_MULTI_KEY_COUNT 32
+
 /*
  * KeeLoq learning types
  * https://phreakerclub.com/forum/showthread.php?t=67
@@ -42,6 +51,19 @@ uint32_t subghz_protocol_keeloq_common_encrypt(const uint32_t data, const uint64
  */
 uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const uint64_t key);
 
+/**
+ * Simple Learning Decrypt of the same data with many keys at once.
+ * @param data - keeloq encrypt data
+ * @param keys - manufacture keys (64bit), up to KEELOQ_MULTI_KEY_COUNT
+ * @param count - number of keys
+ * @param result - 0xBSSSCCCC for each key
+ */
+void subghz_protocol_keeloq_common_decrypt_multi(
+    const uint32_t data,
+    const uint64_t* keys,
+    size_t count,
+    uint32_t* result);
+
 /** 
  * Normal Learning
  * @param data - serial number (28bit)
@@ -50,6 +72,19 @@ uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const uint64
  */
 uint64_t subghz_protocol_keeloq_common_normal_learning(uint32_t data, const uint64_t key);
 
+/**
+ * Normal Learning with many keys at once.
+ * @param data - serial number (28bit)
+ * @param keys - manufacture keys (64bit), up to KEELOQ_MULTI_KEY_COUNT
+ * @param count - number of keys
+ * @param result - manufacture for this serial number (64bit) for each key
+ */
+void subghz_protocol_keeloq_common_normal_learning_multi(
+    uint32_t data,
+    const uint64_t* keys,
+    size_t count,
+    uint64_t* result);
+
 /** 
  * Secure Learning
  * @param data - serial number (28bit)
@@ -60,6 +95,21 @@ uint64_t subghz_protocol_keeloq_common_normal_learning(uint32_t data, const uint
 uint64_t
     subghz_protocol_keeloq_common_secure_learning(uint32_t data, uint32_t seed, const uint64_t key);
 
+/**
+ * Secure Learning with many keys at once.
+ * @param data - serial number (28bit)
+ * @param seed - seed number (32bit)
+ * @param keys - manufacture keys (64bit), up to KEELOQ_MULTI_KEY_COUNT
+ * @param count - number of keys
+ * @param result - manufacture for this serial number (64bit) for each key
+ */
+void subghz_protocol_keeloq_common_secure_learning_multi(
+    uint32_t data,
+    uint32_t seed,
+    const uint64_t* keys,
+    size_t count,
+    uint64_t* result);
+
 /** 
  * Magic_xor_type1 Learning
  * @param data - serial number (28bit)
@@ -98,3 +148,7 @@ uint64_t subghz_protocol_keeloq_common_magic_serial_type2_learning(uint32_t data
  */
 
 uint64_t subghz_protocol_keeloq_common_magic_serial_type3_learning(uint32_t data, uint64_t man);
+
+#ifdef __cplusplus
+}
+#endif
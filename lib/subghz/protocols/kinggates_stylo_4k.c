@@ -143,18 +143,14 @@ static bool subghz_protocol_kinggates_stylo_4k_gen_data(
     UNUSED(btn);
     uint32_t hop = subghz_protocol_blocks_reverse_key(instance->generic.data_2 >> 4, 32);
     uint64_t fix = subghz_protocol_blocks_reverse_key(instance->generic.data, 53);
-    int res = 0;
     uint32_t decrypt = 0;
 
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            res = strcmp(furi_string_get_cstr(manufacture_code->name), "Kingates_Stylo4k");
-            if(res == 0) {
-                //Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                break;
-            }
-        }
+    const SubGhzKey* manufacture_code =
+        subghz_keystore_find(instance->keystore, "Kingates_Stylo4k");
+    if(manufacture_code) {
+        //Simple Learning
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+    }
     instance->generic.cnt = decrypt & 0xFFFF;
 
     if(instance->generic.cnt < 0xFFFF) {
@@ -173,17 +169,13 @@ static bool subghz_protocol_kinggates_stylo_4k_gen_data(
     uint32_t data = (decrypt & 0xFFFF0000) | instance->generic.cnt;
 
     uint64_t encrypt = 0;
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            res = strcmp(furi_string_get_cstr(manufacture_code->name), "Kingates_Stylo4k");
-            if(res == 0) {
-                //Simple Learning
-                encrypt = subghz_protocol_keeloq_common_encrypt(data, manufacture_code->key);
-                encrypt = subghz_protocol_blocks_reverse_key(encrypt, 32);
-                instance->generic.data_2 = encrypt << 4;
-                return true;
-            }
-        }
+    if(manufacture_code) {
+        //Simple Learning
+        encrypt = subghz_protocol_keeloq_common_encrypt(data, manufacture_code->key);
+        encrypt = subghz_protocol_blocks_reverse_key(encrypt, 32);
+        instance->generic.data_2 = encrypt << 4;
+        return true;
+    }
 
     return false;
 }
@@ -55,6 +55,9 @@ const SubGhzProtocolDecoder subghz_protocol_linear_decoder = {
     .deserialize = subghz_protocol_decoder_linear_deserialize,
     .get_string = subghz_protocol_decoder_linear_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_linear_is_idle,
+    .get_wakeup = subghz_protocol_decoder_linear_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_linear_encoder = {
@@ -219,6 +222,23 @@ void subghz_protocol_decoder_linear_reset(void* context) {
     instance->decoder.parser_step = LinearDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_linear_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderLinear* instance = context;
+    return instance->decoder.parser_step == LinearDecoderStepReset;
+}
+
+void subghz_protocol_decoder_linear_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_linear_const.te_short * 42,
+        subghz_protocol_linear_const.te_delta * 20);
+}
+
 void subghz_protocol_decoder_linear_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderLinear* instance = context;
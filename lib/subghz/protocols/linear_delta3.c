@@ -56,6 +56,9 @@ const SubGhzProtocolDecoder subghz_protocol_linear_delta3_decoder = {
     .deserialize = subghz_protocol_decoder_linear_delta3_deserialize,
     .get_string = subghz_protocol_decoder_linear_delta3_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_linear_delta3_is_idle,
+    .get_wakeup = subghz_protocol_decoder_linear_delta3_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_linear_delta3_encoder = {
@@ -225,6 +228,23 @@ void subghz_protocol_decoder_linear_delta3_reset(void* context) {
     instance->last_data = 0;
 }
 
+bool subghz_protocol_decoder_linear_delta3_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderLinearDelta3* instance = context;
+    return instance->decoder.parser_step == LinearDecoderStepReset;
+}
+
+void subghz_protocol_decoder_linear_delta3_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_linear_delta3_const.te_short * 70,
+        subghz_protocol_linear_delta3_const.te_delta * 24);
+}
+
 void subghz_protocol_decoder_linear_delta3_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderLinearDelta3* instance = context;
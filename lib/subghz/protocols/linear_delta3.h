@@ -73,6 +73,22 @@ void subghz_protocol_decoder_linear_delta3_reset(void* context);
  */
 void subghz_protocol_decoder_linear_delta3_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderLinearDelta3 is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderLinearDelta3 instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_linear_delta3_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderLinearDelta3.
+ * @param context Pointer to a SubGhzProtocolDecoderLinearDelta3 instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_linear_delta3_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderLinearDelta3 instance
@@ -63,6 +63,9 @@ const SubGhzProtocolDecoder subghz_protocol_mastercode_decoder = {
     .deserialize = subghz_protocol_decoder_mastercode_deserialize,
     .get_string = subghz_protocol_decoder_mastercode_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_mastercode_is_idle,
+    .get_wakeup = subghz_protocol_decoder_mastercode_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_mastercode_encoder = {
@@ -228,6 +231,23 @@ void subghz_protocol_decoder_mastercode_reset(void* context) {
     instance->decoder.parser_step = MastercodeDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_mastercode_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderMastercode* instance = context;
+    return instance->decoder.parser_step == MastercodeDecoderStepReset;
+}
+
+void subghz_protocol_decoder_mastercode_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_mastercode_const.te_short * 15,
+        subghz_protocol_mastercode_const.te_delta * 15);
+}
+
 void subghz_protocol_decoder_mastercode_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderMastercode* instance = context;
@@ -61,6 +61,9 @@ const SubGhzProtocolDecoder subghz_protocol_megacode_decoder = {
     .deserialize = subghz_protocol_decoder_megacode_deserialize,
     .get_string = subghz_protocol_decoder_megacode_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_megacode_is_idle,
+    .get_wakeup = subghz_protocol_decoder_megacode_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_megacode_encoder = {
@@ -247,6 +250,23 @@ void subghz_protocol_decoder_megacode_reset(void* context) {
     instance->decoder.parser_step = MegaCodeDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_megacode_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderMegaCode* instance = context;
+    return instance->decoder.parser_step == MegaCodeDecoderStepReset;
+}
+
+void subghz_protocol_decoder_megacode_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_megacode_const.te_short * 13,
+        subghz_protocol_megacode_const.te_delta * 17);
+}
+
 void subghz_protocol_decoder_megacode_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderMegaCode* instance = context;
@@ -73,6 +73,22 @@ void subghz_protocol_decoder_megacode_reset(void* context);
  */
 void subghz_protocol_decoder_megacode_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderMegaCode is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderMegaCode instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_megacode_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderMegaCode.
+ * @param context Pointer to a SubGhzProtocolDecoderMegaCode instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_megacode_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderMegaCode instance
@@ -48,6 +48,9 @@ const SubGhzProtocolDecoder subghz_protocol_nice_flo_decoder = {
     .deserialize = subghz_protocol_decoder_nice_flo_deserialize,
     .get_string = subghz_protocol_decoder_nice_flo_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_nice_flo_is_idle,
+    .get_wakeup = subghz_protocol_decoder_nice_flo_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nice_flo_encoder = {
@@ -206,6 +209,23 @@ void subghz_protocol_decoder_nice_flo_reset(void* context) {
     instance->decoder.parser_step = NiceFloDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_nice_flo_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderNiceFlo* instance = context;
+    return instance->decoder.parser_step == NiceFloDecoderStepReset;
+}
+
+void subghz_protocol_decoder_nice_flo_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_nice_flo_const.te_short * 36,
+        subghz_protocol_nice_flo_const.te_delta * 36);
+}
+
 void subghz_protocol_decoder_nice_flo_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderNiceFlo* instance = context;
@@ -73,6 +73,22 @@ void subghz_protocol_decoder_nice_flo_reset(void* context);
  */
 void subghz_protocol_decoder_nice_flo_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderNiceFlo is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderNiceFlo instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_nice_flo_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderNiceFlo.
+ * @param context Pointer to a SubGhzProtocolDecoderNiceFlo instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_nice_flo_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderNiceFlo instance
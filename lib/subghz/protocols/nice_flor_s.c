@@ -66,6 +66,9 @@ const SubGhzProtocolDecoder subghz_protocol_nice_flor_s_decoder = {
     .deserialize = subghz_protocol_decoder_nice_flor_s_deserialize,
     .get_string = subghz_protocol_decoder_nice_flor_s_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_nice_flor_s_is_idle,
+    .get_wakeup = subghz_protocol_decoder_nice_flor_s_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nice_flor_s_encoder = {
@@ -540,6 +543,23 @@ void subghz_protocol_decoder_nice_flor_s_reset(void* context) {
     instance->decoder.parser_step = NiceFlorSDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_nice_flor_s_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderNiceFlorS* instance = context;
+    return instance->decoder.parser_step == NiceFlorSDecoderStepReset;
+}
+
+void subghz_protocol_decoder_nice_flor_s_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_nice_flor_s_const.te_short * 38,
+        subghz_protocol_nice_flor_s_const.te_delta * 38);
+}
+
 void subghz_protocol_decoder_nice_flor_s_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderNiceFlorS* instance = context;
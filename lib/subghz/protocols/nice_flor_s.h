@@ -75,6 +75,22 @@ void subghz_protocol_decoder_nice_flor_s_reset(void* context);
  */
 void subghz_protocol_decoder_nice_flor_s_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderNiceFlorS is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderNiceFlorS instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_nice_flor_s_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderNiceFlorS.
+ * @param context Pointer to a SubGhzProtocolDecoderNiceFlorS instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_nice_flor_s_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderNiceFlorS instance
@@ -51,6 +51,9 @@ const SubGhzProtocolDecoder subghz_protocol_phoenix_v2_decoder = {
     .deserialize = subghz_protocol_decoder_phoenix_v2_deserialize,
     .get_string = subghz_protocol_decoder_phoenix_v2_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_phoenix_v2_is_idle,
+    .get_wakeup = subghz_protocol_decoder_phoenix_v2_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_phoenix_v2_encoder = {
@@ -204,6 +207,23 @@ void subghz_protocol_decoder_phoenix_v2_reset(void* context) {
     instance->decoder.parser_step = Phoenix_V2DecoderStepReset;
 }
 
+bool subghz_protocol_decoder_phoenix_v2_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderPhoenix_V2* instance = context;
+    return instance->decoder.parser_step == Phoenix_V2DecoderStepReset;
+}
+
+void subghz_protocol_decoder_phoenix_v2_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_phoenix_v2_const.te_short * 60,
+        subghz_protocol_phoenix_v2_const.te_delta * 30);
+}
+
 void subghz_protocol_decoder_phoenix_v2_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderPhoenix_V2* instance = context;
@@ -73,6 +73,22 @@ void subghz_protocol_decoder_phoenix_v2_reset(void* context);
  */
 void subghz_protocol_decoder_phoenix_v2_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderPhoenix_V2 is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderPhoenix_V2 instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_phoenix_v2_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderPhoenix_V2.
+ * @param context Pointer to a SubGhzProtocolDecoderPhoenix_V2 instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_phoenix_v2_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderPhoenix_V2 instance
@@ -62,6 +62,9 @@ const SubGhzProtocolDecoder subghz_protocol_princeton_decoder = {
     .deserialize = subghz_protocol_decoder_princeton_deserialize,
     .get_string = subghz_protocol_decoder_princeton_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_princeton_is_idle,
+    .get_wakeup = subghz_protocol_decoder_princeton_get_wakeup,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_princeton_encoder = {
@@ -235,6 +238,23 @@ void subghz_protocol_decoder_princeton_reset(void* context) {
     instance->last_data = 0;
 }
 
+bool subghz_protocol_decoder_princeton_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderPrinceton* instance = context;
+    return instance->decoder.parser_step == PrincetonDecoderStepReset;
+}
+
+void subghz_protocol_decoder_princeton_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup) {
+    UNUSED(context);
+    subghz_protocol_blocks_set_wakeup(
+        wakeup,
+        false,
+        subghz_protocol_princeton_const.te_short * 36,
+        subghz_protocol_princeton_const.te_delta * 36);
+}
+
 void subghz_protocol_decoder_princeton_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderPrinceton* instance = context;
@@ -77,6 +77,22 @@ void subghz_protocol_decoder_princeton_reset(void* context);
  */
 void subghz_protocol_decoder_princeton_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderPrinceton is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderPrinceton instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_princeton_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderPrinceton.
+ * @param context Pointer to a SubGhzProtocolDecoderPrinceton instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_princeton_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderPrinceton instance
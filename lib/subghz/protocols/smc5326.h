@@ -73,6 +73,22 @@ void subghz_protocol_decoder_smc5326_reset(void* context);
  */
 void subghz_protocol_decoder_smc5326_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Check whether SubGhzProtocolDecoderSMC5326 is waiting for a header.
+ * @param context Pointer to a SubGhzProtocolDecoderSMC5326 instance
+ * @return true if idle
+ */
+bool subghz_protocol_decoder_smc5326_is_idle(void* context);
+
+/**
+ * Get the pulse window that wakes up an idle SubGhzProtocolDecoderSMC5326.
+ * @param context Pointer to a SubGhzProtocolDecoderSMC5326 instance
+ * @param wakeup Pointer to a SubGhzProtocolDecoderWakeup instance
+ */
+void subghz_protocol_decoder_smc5326_get_wakeup(
+    void* context,
+    SubGhzProtocolDecoderWakeup* wakeup);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderSMC5326 instance
@@ -146,7 +146,6 @@ static bool
     uint32_t hop = 0;
     uint64_t man = 0;
     uint64_t code_found_reverse;
-    int res = 0;
 
     if(instance->manufacture_name == 0x0) {
         instance->manufacture_name = "";
@@ -158,41 +157,31 @@ static bool
         hop = code_found_reverse & 0x00000000ffffffff;
     } else {
         uint8_t kl_type_en = instance->keystore->kl_type;
-        for
-            M_EACH(
-                manufacture_code,
-                *subghz_keystore_get_data(instance->keystore),
-                SubGhzKeyArray_t) {
-                res = strcmp(
-                    furi_string_get_cstr(manufacture_code->name), instance->manufacture_name);
-                if(res == 0) {
-                    switch(manufacture_code->type) {
-                    case KEELOQ_LEARNING_SIMPLE:
-                        //Simple Learning
-                        hop =
-                            subghz_protocol_keeloq_common_encrypt(decrypt, manufacture_code->key);
-                        break;
-                    case KEELOQ_LEARNING_NORMAL:
-                        //Normal Learning
-                        man = subghz_protocol_keeloq_common_normal_learning(
-                            fix, manufacture_code->key);
-                        hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                        break;
-                    case KEELOQ_LEARNING_UNKNOWN:
-                        if(kl_type_en == 1) {
-                            hop = subghz_protocol_keeloq_common_encrypt(
-                                decrypt, manufacture_code->key);
-                        }
-                        if(kl_type_en == 2) {
-                            man = subghz_protocol_keeloq_common_normal_learning(
-                                fix, manufacture_code->key);
-                            hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                        }
-                        break;
-                    }
-                    break;
+        const SubGhzKey* manufacture_code =
+            subghz_keystore_find(instance->keystore, instance->manufacture_name);
+        if(manufacture_code) {
+            switch(manufacture_code->type) {
+            case KEELOQ_LEARNING_SIMPLE:
+                //Simple Learning
+                hop = subghz_protocol_keeloq_common_encrypt(decrypt, manufacture_code->key);
+                break;
+            case KEELOQ_LEARNING_NORMAL:
+                //Normal Learning
+                man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+                hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+                break;
+            case KEELOQ_LEARNING_UNKNOWN:
+                if(kl_type_en == 1) {
+                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, manufacture_code->key);
                 }
+                if(kl_type_en == 2) {
+                    man = subghz_protocol_keeloq_common_normal_learning(
+                        fix, manufacture_code->key);
+                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+                }
+                break;
             }
+        }
     }
     if(hop) {
         uint64_t yek = (uint64_t)fix << 32 | hop;
@@ -533,14 +522,14 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
     }
     for
         M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
+            if(mf_not_set || (strcmp(manufacture_code->name, mfname) == 0)) {
                 switch(manufacture_code->type) {
                 case KEELOQ_LEARNING_SIMPLE:
                     // Simple Learning
                     decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
                     if(subghz_protocol_star_line_check_decrypt(
                            instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                        *manufacture_name = manufacture_code->name;
                         keystore->mfname = *manufacture_name;
                         return 1;
                     }
@@ -553,7 +542,7 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
                     decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
                     if(subghz_protocol_star_line_check_decrypt(
                            instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                        *manufacture_name = manufacture_code->name;
                         keystore->mfname = *manufacture_name;
                         return 1;
                     }
@@ -563,7 +552,7 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
                     decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
                     if(subghz_protocol_star_line_check_decrypt(
                            instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                        *manufacture_name = manufacture_code->name;
                         keystore->mfname = *manufacture_name;
                         keystore->kl_type = 1;
                         return 1;
@@ -578,7 +567,7 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
                     decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
                     if(subghz_protocol_star_line_check_decrypt(
                            instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                        *manufacture_name = manufacture_code->name;
                         keystore->mfname = *manufacture_name;
                         keystore->kl_type = 1;
                         return 1;
@@ -591,7 +580,7 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
                     decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
                     if(subghz_protocol_star_line_check_decrypt(
                            instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                        *manufacture_name = manufacture_code->name;
                         keystore->mfname = *manufacture_name;
                         keystore->kl_type = 2;
                         return 1;
@@ -602,7 +591,7 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
                     decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
                     if(subghz_protocol_star_line_check_decrypt(
                            instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                        *manufacture_name = manufacture_code->name;
                         keystore->mfname = *manufacture_name;
                         keystore->kl_type = 2;
                         return 1;
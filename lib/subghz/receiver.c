@@ -4,15 +4,48 @@
 
 #include <m-array.h>
 
+/*
+ * Dispatch index
+ *
+ * Most decoders spend their time in the reset step waiting for a header pulse of a
+ * known level and duration. Decoders that report `is_idle`/`get_wakeup` are kept out
+ * of the per-pulse loop while idle and are only fed pulses that fall into their
+ * wakeup window. Windows are bucketed by duration at alloc time, so a pulse only
+ * visits decoders whose window overlaps its bucket. Busy decoders and decoders
+ * without wakeup information are fed every pulse, as before.
+ */
+#define SUBGHZ_RECEIVER_DISPATCH_BUCKET_SHIFT 10 // 1024us per bucket
+#define SUBGHZ_RECEIVER_DISPATCH_BUCKET_COUNT 32 // Last bucket holds everything longer
+
 typedef struct {
     SubGhzProtocolEncoderBase* base;
+
+    bool indexed;
+    bool idle;
+    uint32_t fed_sequence;
+    SubGhzProtocolDecoderWakeup wakeup;
 } SubGhzReceiverSlot;
 
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
 #define M_OPL_SubGhzReceiverSlotArray_t() ARRAY_OPLIST(SubGhzReceiverSlotArray, M_POD_OPLIST)
 
+typedef struct {
+    // Index of the first candidate in `candidates`, per level and bucket, plus end marker
+    uint16_t offset[2][SUBGHZ_RECEIVER_DISPATCH_BUCKET_COUNT + 1];
+    uint16_t* candidates;
+
+    // Slots that are always fed: not indexed or not idle
+    uint16_t* active;
+    size_t active_count;
+
+    uint32_t sequence;
+    bool is_decoding;
+    bool is_update_pending; // Reset was called from a decoder callback
+} SubGhzReceiverDispatch;
+
 struct SubGhzReceiver {
     SubGhzReceiverSlotArray_t slots;
+    SubGhzReceiverDispatch dispatch;
     SubGhzProtocolFlag filter;
     SubGhzProtocolFilter ignore_filter;
 
@@ -20,6 +53,117 @@ struct SubGhzReceiver {
     void* context;
 };
 
+static inline size_t subghz_receiver_dispatch_bucket(uint32_t duration) {
+    size_t bucket = duration >> SUBGHZ_RECEIVER_DISPATCH_BUCKET_SHIFT;
+    return (bucket < SUBGHZ_RECEIVER_DISPATCH_BUCKET_COUNT) ?
+               bucket :
+               (SUBGHZ_RECEIVER_DISPATCH_BUCKET_COUNT - 1);
+}
+
+static void subghz_receiver_dispatch_add_candidates(
+    SubGhzReceiver* instance,
+    uint16_t* fill,
+    bool count_only) {
+    SubGhzReceiverDispatch* dispatch = &instance->dispatch;
+
+    size_t index = 0;
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if(slot->indexed) {
+                size_t level = slot->wakeup.level ? 1 : 0;
+                size_t first = subghz_receiver_dispatch_bucket(slot->wakeup.duration_min);
+                size_t last = subghz_receiver_dispatch_bucket(slot->wakeup.duration_max);
+                for(size_t bucket = first; bucket <= last; bucket++) {
+                    if(count_only) {
+                        dispatch->offset[level][bucket + 1]++;
+                    } else {
+                        dispatch->candidates[fill[level * SUBGHZ_RECEIVER_DISPATCH_BUCKET_COUNT +
+                                                  bucket]++] = index;
+                    }
+                }
+            }
+            index++;
+        }
+}
+
+static void subghz_receiver_dispatch_build(SubGhzReceiver* instance) {
+    SubGhzReceiverDispatch* dispatch = &instance->dispatch;
+    size_t slot_count = SubGhzReceiverSlotArray_size(instance->slots);
+
+    // Collect wakeup windows
+    size_t index = 0;
+    dispatch->active = malloc(sizeof(uint16_t) * slot_count);
+    dispatch->active_count = 0;
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            const SubGhzProtocolDecoder* decoder = slot->base->protocol->decoder;
+            slot->indexed = (decoder->is_idle != NULL) && (decoder->get_wakeup != NULL);
+            slot->fed_sequence = 0;
+            if(slot->indexed) {
+                decoder->get_wakeup(slot->base, &slot->wakeup);
+                slot->idle = decoder->is_idle(slot->base);
+            } else {
+                slot->idle = false;
+            }
+            if(!slot->idle) {
+                dispatch->active[dispatch->active_count++] = index;
+            }
+            index++;
+        }
+
+    // Count candidates per bucket, then turn counts into offsets
+    memset(dispatch->offset, 0, sizeof(dispatch->offset));
+    subghz_receiver_dispatch_add_candidates(instance, NULL, true);
+    for(size_t level = 0; level < 2; level++) {
+        for(size_t bucket = 0; bucket < SUBGHZ_RECEIVER_DISPATCH_BUCKET_COUNT; bucket++) {
+            dispatch->offset[level][bucket + 1] += dispatch->offset[level][bucket];
+        }
+    }
+    // Both levels share one candidate array: level 1 starts right after level 0
+    size_t low_count = dispatch->offset[0][SUBGHZ_RECEIVER_DISPATCH_BUCKET_COUNT];
+    for(size_t bucket = 0; bucket <= SUBGHZ_RECEIVER_DISPATCH_BUCKET_COUNT; bucket++) {
+        dispatch->offset[1][bucket] += low_count;
+    }
+
+    size_t candidate_count = dispatch->offset[1][SUBGHZ_RECEIVER_DISPATCH_BUCKET_COUNT];
+    dispatch->candidates = malloc(sizeof(uint16_t) * (candidate_count ? candidate_count : 1));
+
+    uint16_t fill[2 * SUBGHZ_RECEIVER_DISPATCH_BUCKET_COUNT];
+    for(size_t level = 0; level < 2; level++) {
+        for(size_t bucket = 0; bucket < SUBGHZ_RECEIVER_DISPATCH_BUCKET_COUNT; bucket++) {
+            fill[level * SUBGHZ_RECEIVER_DISPATCH_BUCKET_COUNT + bucket] =
+                dispatch->offset[level][bucket];
+        }
+    }
+    subghz_receiver_dispatch_add_candidates(instance, fill, false);
+
+    dispatch->sequence = 0;
+    dispatch->is_decoding = false;
+    dispatch->is_update_pending = false;
+}
+
+/** Rebuild the list of always-fed slots from the idle flags */
+static void subghz_receiver_dispatch_update_active(SubGhzReceiver* instance) {
+    SubGhzReceiverDispatch* dispatch = &instance->dispatch;
+
+    size_t index = 0;
+    dispatch->active_count = 0;
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if(!slot->idle) {
+                dispatch->active[dispatch->active_count++] = index;
+            }
+            index++;
+        }
+    dispatch->is_update_pending = false;
+}
+
+static inline bool
+    subghz_receiver_slot_is_enabled(SubGhzReceiver* instance, SubGhzReceiverSlot* slot) {
+    return (slot->base->protocol->flag & instance->filter) != 0 &&
+           (slot->base->protocol->filter & instance->ignore_filter) == 0;
+}
+
 SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
     SubGhzReceiver* instance = malloc(sizeof(SubGhzReceiver));
     SubGhzReceiverSlotArray_init(instance->slots);
@@ -35,6 +179,7 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
             slot->base = protocol->decoder->alloc(environment);
         }
     }
+    subghz_receiver_dispatch_build(instance);
 
     instance->callback = NULL;
     instance->context = NULL;
@@ -55,20 +200,88 @@ void subghz_receiver_free(SubGhzReceiver* instance) {
         }
     SubGhzReceiverSlotArray_clear(instance->slots);
 
+    free(instance->dispatch.candidates);
+    free(instance->dispatch.active);
     free(instance);
 }
 
+static void subghz_receiver_decode_pair(SubGhzReceiver* instance, bool level, uint32_t duration) {
+    SubGhzReceiverDispatch* dispatch = &instance->dispatch;
+    uint32_t sequence = ++dispatch->sequence;
+    dispatch->is_decoding = true;
+
+    // Feed busy and non-indexed decoders, drop the ones that went back to idle
+    size_t active_count = 0;
+    for(size_t i = 0; i < dispatch->active_count; i++) {
+        SubGhzReceiverSlot* slot =
+            SubGhzReceiverSlotArray_get(instance->slots, dispatch->active[i]);
+        if(subghz_receiver_slot_is_enabled(instance, slot)) {
+            const SubGhzProtocolDecoder* decoder = slot->base->protocol->decoder;
+            decoder->feed(slot->base, level, duration);
+            slot->fed_sequence = sequence;
+            if(slot->indexed && decoder->is_idle(slot->base)) {
+                slot->idle = true;
+                continue;
+            }
+        }
+        dispatch->active[active_count++] = dispatch->active[i];
+    }
+    dispatch->active_count = active_count;
+
+    // Wake idle decoders whose header window matches this pulse
+    size_t bucket = subghz_receiver_dispatch_bucket(duration);
+    size_t level_index = level ? 1 : 0;
+    for(size_t i = dispatch->offset[level_index][bucket];
+        i < dispatch->offset[level_index][bucket + 1];
+        i++) {
+        SubGhzReceiverSlot* slot =
+            SubGhzReceiverSlotArray_get(instance->slots, dispatch->candidates[i]);
+        if(!slot->idle || slot->fed_sequence == sequence) continue;
+        if(duration < slot->wakeup.duration_min || duration > slot->wakeup.duration_max) continue;
+        if(!subghz_receiver_slot_is_enabled(instance, slot)) continue;
+
+        const SubGhzProtocolDecoder* decoder = slot->base->protocol->decoder;
+        decoder->feed(slot->base, level, duration);
+        slot->fed_sequence = sequence;
+        if(!decoder->is_idle(slot->base)) {
+            slot->idle = false;
+            if(!dispatch->is_update_pending) {
+                dispatch->active[dispatch->active_count++] = dispatch->candidates[i];
+            }
+        }
+    }
+
+    dispatch->is_decoding = false;
+    if(dispatch->is_update_pending) {
+        subghz_receiver_dispatch_update_active(instance);
+    }
+}
+
 void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration) {
     furi_check(instance);
     furi_check(instance->slots);
 
-    for
-        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if((slot->base->protocol->flag & instance->filter) != 0 &&
-               (slot->base->protocol->filter & instance->ignore_filter) == 0) {
-                slot->base->protocol->decoder->feed(slot->base, level, duration);
-            }
+    subghz_receiver_decode_pair(instance, level, duration);
+}
+
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* level_duration,
+    size_t count) {
+    furi_check(instance);
+    furi_check(instance->slots);
+    furi_check(level_duration || !count);
+
+    for(size_t i = 0; i < count; i++) {
+        if(level_duration_is_reset(level_duration[i])) {
+            subghz_receiver_reset(instance);
+        } else {
+            subghz_receiver_decode_pair(
+                instance,
+                level_duration_get_level(level_duration[i]),
+                level_duration_get_duration(level_duration[i]));
         }
+    }
 }
 
 void subghz_receiver_reset(SubGhzReceiver* instance) {
@@ -77,8 +290,19 @@ void subghz_receiver_reset(SubGhzReceiver* instance) {
 
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            slot->base->protocol->decoder->reset(slot->base);
+            const SubGhzProtocolDecoder* decoder = slot->base->protocol->decoder;
+            decoder->reset(slot->base);
+            if(slot->indexed) {
+                slot->idle = decoder->is_idle(slot->base);
+            }
         }
+
+    if(instance->dispatch.is_decoding) {
+        // Active list is being walked by subghz_receiver_decode, rebuild it afterwards
+        instance->dispatch.is_update_pending = true;
+    } else {
+        subghz_receiver_dispatch_update_active(instance);
+    }
 }
 
 static void subghz_receiver_rx_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
@@ -35,6 +35,18 @@ void subghz_receiver_free(SubGhzReceiver* instance);
  */
 void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration);
 
+/**
+ * Parse a block of levels and durations received from the air.
+ * Same as calling subghz_receiver_decode for every pair, reset entries reset the decoders.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param level_duration Array of LevelDuration
+ * @param count Number of elements in the array
+ */
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* level_duration,
+    size_t count);
+
 /**
  * Reset decoder SubGhzReceiver.
  * @param instance Pointer to a SubGhzReceiver instance
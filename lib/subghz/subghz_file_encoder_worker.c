@@ -8,6 +8,14 @@
 #define TAG "SubGhzFileEncoderWorker"
 
 #define SUBGHZ_FILE_ENCODER_LOAD 512
+#define SUBGHZ_FILE_ENCODER_CHUNK_SIZE 512
+#define SUBGHZ_FILE_ENCODER_CHUNK_COUNT 2
+
+typedef struct {
+    uint8_t* buff;
+    size_t bytes;
+    FS_Error error;
+} SubGhzFileEncoderChunk;
 
 struct SubGhzFileEncoderWorker {
     FuriThread* thread;
@@ -16,6 +24,14 @@ struct SubGhzFileEncoderWorker {
     Storage* storage;
     FlipperFormat* flipper_format;
 
+    // RAW data is read ahead with asynchronous requests while lines are parsed
+    File* file;
+    StorageAsync* async;
+    FuriMessageQueue* chunks_ready;
+    uint8_t* chunks;
+    volatile size_t file_size;
+    volatile size_t file_offset;
+
     volatile bool worker_running;
     volatile bool worker_stopping;
     bool is_storage_slow;
@@ -85,12 +101,15 @@ void subghz_file_encoder_worker_get_text_progress(
     SubGhzFileEncoderWorker* instance,
     FuriString* output) {
     UNUSED(output);
-    Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
-    size_t total_size = stream_size(stream);
-    size_t current_offset = stream_tell(stream);
+    size_t total_size = instance->file_size;
+    size_t current_offset = instance->file_offset;
     size_t buffer_avail = furi_stream_buffer_bytes_available(instance->stream);
 
-    furi_string_printf(output, "%03u%%", 100 * (current_offset - buffer_avail) / total_size);
+    if(total_size == 0) {
+        furi_string_set(output, "000%");
+    } else {
+        furi_string_printf(output, "%03u%%", 100 * (current_offset - buffer_avail) / total_size);
+    }
 }
 
 LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
@@ -116,16 +135,25 @@ LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
     }
 }
 
-/** Worker thread
- * 
- * @param context 
- * @return exit code 
- */
-static int32_t subghz_file_encoder_worker_thread(void* context) {
+static void subghz_file_encoder_worker_chunk_callback(
+    void* buff,
+    size_t bytes,
+    FS_Error error,
+    void* context) {
     SubGhzFileEncoderWorker* instance = context;
-    FURI_LOG_I(TAG, "Worker start");
+    SubGhzFileEncoderChunk chunk = {.buff = buff, .bytes = bytes, .error = error};
+    furi_check(furi_message_queue_put(instance->chunks_ready, &chunk, 0) == FuriStatusOk);
+}
+
+static void subghz_file_encoder_worker_chunk_request(
+    SubGhzFileEncoderWorker* instance,
+    uint8_t* buff) {
+    // Slot is returned before chunk callback, so this never waits for long
+    storage_async_read(instance->async, buff, SUBGHZ_FILE_ENCODER_CHUNK_SIZE, FuriWaitForever);
+}
+
+static bool subghz_file_encoder_worker_open(SubGhzFileEncoderWorker* instance) {
     bool res = false;
-    instance->is_storage_slow = false;
     Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
     do {
         if(!flipper_format_file_open_existing(
@@ -143,27 +171,114 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
 
         //skip the end of the previous line "\n"
         stream_seek(stream, 1, StreamOffsetFromCurrent);
+        instance->file_offset = stream_tell(stream);
+        instance->file_size = stream_size(stream);
         res = true;
+    } while(0);
+    flipper_format_file_close(instance->flipper_format);
+
+    // RAW data is read through a separate file to allow asynchronous requests
+    if(res) {
+        res = storage_file_open(
+                  instance->file,
+                  furi_string_get_cstr(instance->file_path),
+                  FSAM_READ,
+                  FSOM_OPEN_EXISTING) &&
+              storage_file_seek(instance->file, instance->file_offset, true);
+        if(!res) {
+            FURI_LOG_E(
+                TAG, "Unable to reopen file: %s", furi_string_get_cstr(instance->file_path));
+        }
+    }
+
+    return res;
+}
+
+/** Worker thread
+ * 
+ * @param context 
+ * @return exit code 
+ */
+static int32_t subghz_file_encoder_worker_thread(void* context) {
+    SubGhzFileEncoderWorker* instance = context;
+    FURI_LOG_I(TAG, "Worker start");
+    instance->is_storage_slow = false;
+    instance->file_offset = 0;
+    instance->file_size = 0;
+
+    bool res = subghz_file_encoder_worker_open(instance);
+    if(res) {
         instance->worker_stopping = false;
         FURI_LOG_I(TAG, "Start transmission");
-    } while(0);
+
+        // Keep every chunk in flight, parsed chunks are requested again
+        for(size_t i = 0; i < SUBGHZ_FILE_ENCODER_CHUNK_COUNT; i++) {
+            subghz_file_encoder_worker_chunk_request(
+                instance, instance->chunks + i * SUBGHZ_FILE_ENCODER_CHUNK_SIZE);
+        }
+    }
+
+    furi_string_reset(instance->str_data);
+    SubGhzFileEncoderChunk chunk = {0};
+    size_t chunk_pos = 0;
+    bool line_ready = false;
 
     while(res && instance->worker_running) {
-        size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
-        if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(stream_read_line(stream, instance->str_data)) {
-                furi_string_trim(instance->str_data);
-                if(!subghz_file_encoder_worker_data_parse(
-                       instance, furi_string_get_cstr(instance->str_data))) {
+        if(line_ready) {
+            size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
+            if((stream_free_byte / sizeof(int32_t)) < SUBGHZ_FILE_ENCODER_LOAD) {
+                furi_delay_ms(1);
+                continue;
+            }
+
+            line_ready = false;
+            furi_string_trim(instance->str_data);
+            if(!subghz_file_encoder_worker_data_parse(
+                   instance, furi_string_get_cstr(instance->str_data))) {
+                subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+                break;
+            }
+            furi_string_reset(instance->str_data);
+        }
+
+        if(!chunk.buff) {
+            if(furi_message_queue_get(instance->chunks_ready, &chunk, 1) != FuriStatusOk) {
+                continue;
+            }
+            chunk_pos = 0;
+            if(chunk.error != FSE_OK) {
+                FURI_LOG_E(TAG, "Read error: %s", filesystem_api_error_get_desc(chunk.error));
+                subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+                break;
+            }
+        }
+
+        // Collect the next line, it may span several chunks
+        size_t chunk_start = chunk_pos;
+        while(chunk_pos < chunk.bytes && !line_ready) {
+            char c = chunk.buff[chunk_pos++];
+            if(c == '\n') {
+                line_ready = true;
+            } else {
+                furi_string_push_back(instance->str_data, c);
+            }
+        }
+        instance->file_offset += chunk_pos - chunk_start;
+
+        if(chunk_pos == chunk.bytes) {
+            if(chunk.bytes < SUBGHZ_FILE_ENCODER_CHUNK_SIZE) {
+                // End of file: the last line may have no line feed
+                if(!line_ready && !furi_string_empty(instance->str_data)) {
+                    line_ready = true;
+                    continue;
+                } else if(!line_ready) {
                     subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
                     break;
                 }
             } else {
-                subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                break;
+                subghz_file_encoder_worker_chunk_request(instance, chunk.buff);
+                chunk.buff = NULL;
             }
-        } else {
-            furi_delay_ms(1);
         }
     }
     //waiting for the end of the transfer
@@ -184,7 +299,9 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
         }
         furi_delay_ms(50);
     }
-    flipper_format_file_close(instance->flipper_format);
+    storage_async_wait(instance->async, FuriWaitForever);
+    furi_message_queue_reset(instance->chunks_ready);
+    if(storage_file_is_open(instance->file)) storage_file_close(instance->file);
 
     FURI_LOG_I(TAG, "Worker stop");
     return 0;
@@ -200,6 +317,14 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc(void) {
     instance->storage = furi_record_open(RECORD_STORAGE);
     instance->flipper_format = flipper_format_file_alloc(instance->storage);
 
+    instance->file = storage_file_alloc(instance->storage);
+    instance->async = storage_async_alloc(instance->file, SUBGHZ_FILE_ENCODER_CHUNK_COUNT);
+    storage_async_set_callback(
+        instance->async, subghz_file_encoder_worker_chunk_callback, instance);
+    instance->chunks_ready =
+        furi_message_queue_alloc(SUBGHZ_FILE_ENCODER_CHUNK_COUNT, sizeof(SubGhzFileEncoderChunk));
+    instance->chunks = malloc(SUBGHZ_FILE_ENCODER_CHUNK_SIZE * SUBGHZ_FILE_ENCODER_CHUNK_COUNT);
+
     instance->str_data = furi_string_alloc();
     instance->file_path = furi_string_alloc();
     instance->worker_stopping = true;
@@ -216,6 +341,11 @@ void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
     furi_string_free(instance->str_data);
     furi_string_free(instance->file_path);
 
+    storage_async_free(instance->async);
+    storage_file_free(instance->file);
+    furi_message_queue_free(instance->chunks_ready);
+    free(instance->chunks);
+
     flipper_format_free(instance->flipper_format);
     furi_record_close(RECORD_STORAGE);
 
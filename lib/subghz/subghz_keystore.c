@@ -7,6 +7,7 @@
 #include <storage/storage.h>
 #include <toolbox/hex.h>
 #include <toolbox/stream/stream.h>
+#include <toolbox/stream/file_stream.h>
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
 
@@ -22,15 +23,50 @@
 #define SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE 512
 #define SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE (SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE * 2)
 
+#define SUBGHZ_KEYSTORE_COMPILED_MAGIC 0x424B4753 // "SGKB"
+#define SUBGHZ_KEYSTORE_COMPILED_VERSION 1
+#define SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE 16
+#define SUBGHZ_KEYSTORE_COMPILED_READ_RECORDS 16
+
+// Name index entries are 16 bit
+#define SUBGHZ_KEYSTORE_INDEX_SIZE_MAX (UINT16_MAX + 1)
+
 typedef enum {
     SubGhzKeystoreEncryptionNone,
     SubGhzKeystoreEncryptionAES256,
 } SubGhzKeystoreEncryption;
 
+/*
+ * Compiled keystore file:
+ * header, names block (string pool, key indexes sorted by name, padding), records.
+ * Names block and records are encrypted as one AES CBC stream.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t encryption;
+    uint8_t iv[16];
+    uint32_t key_count;
+    uint32_t names_size;
+    uint32_t index_offset;
+} SubGhzKeystoreCompiledHeader;
+
+typedef struct {
+    uint64_t key;
+    uint32_t name_offset;
+    uint16_t type;
+    uint16_t reserved;
+} SubGhzKeystoreCompiledRecord;
+
+static_assert(
+    sizeof(SubGhzKeystoreCompiledRecord) == SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE,
+    "Compiled keystore record must be one AES block");
+
 SubGhzKeystore* subghz_keystore_alloc(void) {
     SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
 
     SubGhzKeyArray_init(instance->data);
+    SubGhzKeystoreNameBlock_init(instance->name_blocks);
 
     subghz_keystore_reset_kl(instance);
 
@@ -44,16 +80,62 @@ void subghz_keystore_reset_kl(SubGhzKeystore* instance) {
     instance->kl_type = 0;
 }
 
+bool subghz_keystore_hint_get(
+    SubGhzKeystore* instance,
+    uint32_t serial,
+    SubGhzKeystoreHint* hint) {
+    furi_check(instance);
+    furi_check(hint);
+
+    for(size_t i = 0; i < instance->hint_count; i++) {
+        if(instance->hints[i].serial == serial) {
+            *hint = instance->hints[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+void subghz_keystore_hint_set(
+    SubGhzKeystore* instance,
+    uint32_t serial,
+    size_t key_index,
+    uint8_t learning) {
+    furi_check(instance);
+
+    // Drop the old entry for this serial, or the least recent one if full
+    size_t position = 0;
+    while(position < instance->hint_count && instance->hints[position].serial != serial) {
+        position++;
+    }
+    if(position == SUBGHZ_KEYSTORE_HINT_COUNT) {
+        position--;
+    } else if(position == instance->hint_count) {
+        instance->hint_count++;
+    }
+
+    memmove(&instance->hints[1], &instance->hints[0], position * sizeof(SubGhzKeystoreHint));
+    instance->hints[0].serial = serial;
+    instance->hints[0].key_index = key_index;
+    instance->hints[0].learning = learning;
+}
+
 void subghz_keystore_free(SubGhzKeystore* instance) {
     furi_assert(instance);
 
     for
         M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
-            furi_string_free(manufacture_code->name);
             manufacture_code->key = 0;
         }
     SubGhzKeyArray_clear(instance->data);
 
+    for
+        M_EACH(name_block, instance->name_blocks, SubGhzKeystoreNameBlock_t) {
+            free(*name_block);
+        }
+    SubGhzKeystoreNameBlock_clear(instance->name_blocks);
+    free(instance->index_buffer);
+
     free(instance);
 }
 
@@ -62,12 +144,50 @@ static void subghz_keystore_add_key(
     const char* name,
     uint64_t key,
     uint16_t type) {
+    char* name_block = strdup(name);
+    SubGhzKeystoreNameBlock_push_back(instance->name_blocks, name_block);
+
     SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
-    manufacture_code->name = furi_string_alloc_set(name);
+    manufacture_code->name = name_block;
     manufacture_code->key = key;
     manufacture_code->type = type;
 }
 
+static int subghz_keystore_index_compare(const SubGhzKeyArray_t data, uint16_t a, uint16_t b) {
+    int res = strcmp(SubGhzKeyArray_cget(data, a)->name, SubGhzKeyArray_cget(data, b)->name);
+    // Keys with the same name keep their order, so the first one is found first
+    return res ? res : (int)a - (int)b;
+}
+
+static void
+    subghz_keystore_index_sort(const SubGhzKeyArray_t data, uint16_t* index, size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        index[i] = i;
+    }
+    // Shell sort: no recursion, no extra memory
+    for(size_t gap = count / 2; gap > 0; gap /= 2) {
+        for(size_t i = gap; i < count; i++) {
+            uint16_t value = index[i];
+            size_t j = i;
+            while(j >= gap && subghz_keystore_index_compare(data, index[j - gap], value) > 0) {
+                index[j] = index[j - gap];
+                j -= gap;
+            }
+            index[j] = value;
+        }
+    }
+}
+
+static void subghz_keystore_index_update(SubGhzKeystore* instance) {
+    size_t count = SubGhzKeyArray_size(instance->data);
+    if(instance->index_size == count || count > SUBGHZ_KEYSTORE_INDEX_SIZE_MAX) return;
+
+    instance->index_buffer = realloc(instance->index_buffer, count * sizeof(uint16_t));
+    subghz_keystore_index_sort(instance->data, instance->index_buffer, count);
+    instance->index = instance->index_buffer;
+    instance->index_size = count;
+}
+
 static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
     uint64_t key = 0;
     uint16_t type = 0;
@@ -190,8 +310,7 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
     return result;
 }
 
-bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
-    furi_assert(instance);
+static bool subghz_keystore_load_text(SubGhzKeystore* instance, const char* file_name) {
     bool result = false;
     uint8_t iv[16];
     uint32_t version;
@@ -200,8 +319,6 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
     FuriString* filetype;
     filetype = furi_string_alloc();
 
-    FURI_LOG_I(TAG, "Loading keystore %s", file_name);
-
     Storage* storage = furi_record_open(RECORD_STORAGE);
 
     FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
@@ -249,6 +366,157 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
     return result;
 }
 
+static bool subghz_keystore_read_compiled(SubGhzKeystore* instance, Stream* stream) {
+    bool result = false;
+    bool key_loaded = false;
+    SubGhzKeystoreCompiledHeader header;
+    char* names = NULL;
+    size_t first = SubGhzKeyArray_size(instance->data);
+
+    do {
+        if(stream_read(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) {
+            FURI_LOG_E(TAG, "Missing header");
+            break;
+        }
+        if(header.version != SUBGHZ_KEYSTORE_COMPILED_VERSION) {
+            FURI_LOG_E(TAG, "Version mismatch");
+            break;
+        }
+        if(header.key_count == 0 || header.key_count > SUBGHZ_KEYSTORE_INDEX_SIZE_MAX ||
+           header.names_size % SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE != 0 ||
+           header.index_offset == 0 || header.index_offset % sizeof(uint16_t) != 0 ||
+           header.index_offset >= header.names_size ||
+           (header.names_size - header.index_offset) / sizeof(uint16_t) < header.key_count) {
+            FURI_LOG_E(TAG, "Malformed header");
+            break;
+        }
+
+        // Sizes come from the file, check them before allocating
+        const uint64_t file_size = (uint64_t)sizeof(header) + header.names_size +
+                                   (uint64_t)header.key_count *
+                                       sizeof(SubGhzKeystoreCompiledRecord);
+        if(file_size > stream_size(stream)) {
+            FURI_LOG_E(TAG, "Truncated file");
+            break;
+        }
+        if(header.names_size >= memmgr_heap_get_max_free_block()) {
+            FURI_LOG_E(TAG, "Not enough memory for names");
+            break;
+        }
+
+        // Names block in one read
+        names = malloc(header.names_size);
+        if(stream_read(stream, (uint8_t*)names, header.names_size) != header.names_size) {
+            FURI_LOG_E(TAG, "Truncated names");
+            break;
+        }
+        if(header.encryption == SubGhzKeystoreEncryptionAES256) {
+            subghz_keystore_mess_with_iv(header.iv);
+            if(!furi_hal_crypto_enclave_load_key(
+                   SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, header.iv)) {
+                FURI_LOG_E(TAG, "Unable to load decryption key");
+                break;
+            }
+            key_loaded = true;
+            if(!furi_hal_crypto_decrypt((uint8_t*)names, (uint8_t*)names, header.names_size)) {
+                FURI_LOG_E(TAG, "Decryption failed");
+                break;
+            }
+        } else if(header.encryption != SubGhzKeystoreEncryptionNone) {
+            FURI_LOG_E(TAG, "Unknown encryption");
+            break;
+        }
+
+        const uint16_t* index = (const uint16_t*)&names[header.index_offset];
+        bool is_valid = names[header.index_offset - 1] == '\0';
+        for(size_t i = 0; is_valid && i < header.key_count; i++) {
+            is_valid = index[i] < header.key_count;
+        }
+        if(!is_valid) {
+            FURI_LOG_E(TAG, "Malformed names");
+            break;
+        }
+
+        // Fixed width records, decrypted in place in small chunks
+        SubGhzKeystoreCompiledRecord records[SUBGHZ_KEYSTORE_COMPILED_READ_RECORDS];
+        SubGhzKeyArray_reserve(instance->data, first + header.key_count);
+        size_t left = header.key_count;
+        while(is_valid && left > 0) {
+            size_t count = MIN(left, COUNT_OF(records));
+            size_t size = count * sizeof(SubGhzKeystoreCompiledRecord);
+            is_valid = stream_read(stream, (uint8_t*)records, size) == size;
+            if(is_valid && key_loaded) {
+                is_valid = furi_hal_crypto_decrypt((uint8_t*)records, (uint8_t*)records, size);
+            }
+            for(size_t i = 0; is_valid && i < count; i++) {
+                is_valid = records[i].name_offset < header.index_offset;
+                if(is_valid) {
+                    SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
+                    manufacture_code->name = &names[records[i].name_offset];
+                    manufacture_code->key = records[i].key;
+                    manufacture_code->type = records[i].type;
+                }
+            }
+            left -= count;
+        }
+        // Wipe decrypted keys
+        memset(records, 0, sizeof(records));
+        if(!is_valid) {
+            FURI_LOG_E(TAG, "Malformed records");
+            // Drop keys pointing to the names block
+            SubGhzKeyArray_resize(instance->data, first);
+            break;
+        }
+
+        SubGhzKeystoreNameBlock_push_back(instance->name_blocks, names);
+        names = NULL;
+        if(first == 0) {
+            // Index from the file covers the whole keystore, use it in place
+            instance->index = index;
+            instance->index_size = header.key_count;
+        }
+        FURI_LOG_I(TAG, "Loaded %lu keys", header.key_count);
+        result = true;
+    } while(false);
+
+    if(key_loaded) furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+    if(names) {
+        memset(names, 0, header.names_size);
+        free(names);
+    }
+
+    return result;
+}
+
+bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
+    furi_assert(instance);
+    bool result = false;
+    bool is_compiled = false;
+
+    FURI_LOG_I(TAG, "Loading keystore %s", file_name);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* stream = file_stream_alloc(storage);
+    if(file_stream_open(stream, file_name, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        uint32_t magic = 0;
+        is_compiled = stream_read(stream, (uint8_t*)&magic, sizeof(magic)) == sizeof(magic) &&
+                      magic == SUBGHZ_KEYSTORE_COMPILED_MAGIC;
+        if(is_compiled) {
+            stream_rewind(stream);
+            result = subghz_keystore_read_compiled(instance, stream);
+        }
+    }
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+
+    if(!is_compiled) {
+        result = subghz_keystore_load_text(instance, file_name);
+    }
+    subghz_keystore_index_update(instance);
+
+    return result;
+}
+
 bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8_t* iv) {
     furi_assert(instance);
     bool result = false;
@@ -300,7 +568,7 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
                     (uint32_t)(key->key >> 32),
                     (uint32_t)key->key,
                     key->type,
-                    furi_string_get_cstr(key->name));
+                    key->name);
                 // Verify length and align
                 furi_assert(len > 0);
                 if(len % 16 != 0) {
@@ -349,6 +617,137 @@ SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance) {
     return &instance->data;
 }
 
+bool subghz_keystore_save_compiled(SubGhzKeystore* instance, const char* file_name, uint8_t* iv) {
+    furi_check(instance);
+    furi_check(file_name);
+
+    size_t key_count = SubGhzKeyArray_size(instance->data);
+    if(key_count == 0 || key_count > SUBGHZ_KEYSTORE_INDEX_SIZE_MAX) {
+        FURI_LOG_E(TAG, "Unsupported key count: %zu", key_count);
+        return false;
+    }
+
+    SubGhzKeystoreCompiledHeader header = {
+        .magic = SUBGHZ_KEYSTORE_COMPILED_MAGIC,
+        .version = SUBGHZ_KEYSTORE_COMPILED_VERSION,
+        .encryption = iv ? SubGhzKeystoreEncryptionAES256 : SubGhzKeystoreEncryptionNone,
+        .key_count = key_count,
+    };
+
+    // String pool, then key indexes sorted by name, then padding
+    size_t pool_size = 0;
+    for
+        M_EACH(key, instance->data, SubGhzKeyArray_t) {
+            pool_size += strlen(key->name) + 1;
+        }
+    header.index_offset = pool_size + pool_size % sizeof(uint16_t);
+    header.names_size = header.index_offset + key_count * sizeof(uint16_t);
+    if(header.names_size % SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE) {
+        header.names_size += SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE -
+                             header.names_size % SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE;
+    }
+
+    char* names = malloc(header.names_size);
+    size_t records_size = key_count * sizeof(SubGhzKeystoreCompiledRecord);
+    SubGhzKeystoreCompiledRecord* records = malloc(records_size);
+    size_t name_offset = 0;
+    size_t record_index = 0;
+    for
+        M_EACH(key, instance->data, SubGhzKeyArray_t) {
+            size_t name_size = strlen(key->name) + 1;
+            memcpy(&names[name_offset], key->name, name_size);
+            records[record_index].key = key->key;
+            records[record_index].name_offset = name_offset;
+            records[record_index].type = key->type;
+            name_offset += name_size;
+            record_index++;
+        }
+    subghz_keystore_index_sort(instance->data, (uint16_t*)&names[header.index_offset], key_count);
+
+    bool result = false;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* stream = file_stream_alloc(storage);
+    do {
+        if(iv) {
+            // File keeps the original IV, same as text keystore
+            memcpy(header.iv, iv, sizeof(header.iv));
+            uint32_t key_iv[4];
+            memcpy(key_iv, iv, sizeof(key_iv));
+            subghz_keystore_mess_with_iv((uint8_t*)key_iv);
+            if(!furi_hal_crypto_enclave_load_key(
+                   SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, (uint8_t*)key_iv)) {
+                FURI_LOG_E(TAG, "Unable to load encryption key");
+                break;
+            }
+            bool is_encrypted =
+                furi_hal_crypto_encrypt((uint8_t*)names, (uint8_t*)names, header.names_size) &&
+                furi_hal_crypto_encrypt((uint8_t*)records, (uint8_t*)records, records_size);
+            furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+            if(!is_encrypted) {
+                FURI_LOG_E(TAG, "Encryption failed");
+                break;
+            }
+        }
+
+        if(!file_stream_open(stream, file_name, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Unable to open file for write: %s", file_name);
+            break;
+        }
+        if(stream_write(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+           stream_write(stream, (uint8_t*)names, header.names_size) != header.names_size ||
+           stream_write(stream, (uint8_t*)records, records_size) != records_size) {
+            FURI_LOG_E(TAG, "Write failed");
+            break;
+        }
+        FURI_LOG_I(TAG, "Success. Compiled %zu keys", key_count);
+        result = true;
+    } while(false);
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+
+    // Wipe buffers before freeing
+    memset(names, 0, header.names_size);
+    memset(records, 0, records_size);
+    free(records);
+    free(names);
+
+    return result;
+}
+
+const SubGhzKey* subghz_keystore_find(SubGhzKeystore* instance, const char* name) {
+    furi_check(instance);
+    furi_check(name);
+
+    subghz_keystore_index_update(instance);
+
+    size_t count = SubGhzKeyArray_size(instance->data);
+    if(instance->index_size != count) {
+        // Too many keys for the index
+        for
+            M_EACH(key, instance->data, SubGhzKeyArray_t) {
+                if(strcmp(key->name, name) == 0) return key;
+            }
+        return NULL;
+    }
+
+    // Lower bound of the name in the sorted index
+    size_t left = 0;
+    size_t right = count;
+    while(left < right) {
+        size_t middle = left + (right - left) / 2;
+        if(strcmp(SubGhzKeyArray_cget(instance->data, instance->index[middle])->name, name) < 0) {
+            left = middle + 1;
+        } else {
+            right = middle;
+        }
+    }
+    if(left < count) {
+        const SubGhzKey* key = SubGhzKeyArray_cget(instance->data, instance->index[left]);
+        if(strcmp(key->name, name) == 0) return key;
+    }
+    return NULL;
+}
+
 bool subghz_keystore_raw_encrypted_save(
     const char* input_file_name,
     const char* output_file_name,
@@ -9,7 +9,7 @@ extern "C" {
 #endif
 
 typedef struct {
-    FuriString* name;
+    const char* name; // Owned by the keystore
     uint64_t key;
     uint16_t type;
 } SubGhzKey;
@@ -20,6 +20,13 @@ ARRAY_DEF(SubGhzKeyArray, SubGhzKey, M_POD_OPLIST)
 
 typedef struct SubGhzKeystore SubGhzKeystore;
 
+/** Key that matched a remote last time, protocol specific learning */
+typedef struct {
+    uint32_t serial;
+    size_t key_index;
+    uint8_t learning;
+} SubGhzKeystoreHint;
+
 /**
  * Allocate SubGhzKeystore.
  * @return SubGhzKeystore* pointer to a SubGhzKeystore instance
@@ -34,6 +41,7 @@ void subghz_keystore_free(SubGhzKeystore* instance);
 
 /** 
  * Loading manufacture key from file
+ * Both text and compiled keystore files are accepted.
  * @param instance Pointer to a SubGhzKeystore instance
  * @param filename Full path to the file
  */
@@ -47,6 +55,16 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* filename);
  */
 bool subghz_keystore_save(SubGhzKeystore* instance, const char* filename, uint8_t* iv);
 
+/** 
+ * Save manufacture keys to compiled keystore file
+ * Compiled file is loaded with a few bulk reads and keeps names in a single block.
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param filename Full path to the file
+ * @param iv IV, 16 bytes, NULL to save unencrypted
+ * @return true On success
+ */
+bool subghz_keystore_save_compiled(SubGhzKeystore* instance, const char* filename, uint8_t* iv);
+
 /** 
  * Get array of keys and names manufacture
  * @param instance Pointer to a SubGhzKeystore instance
@@ -54,6 +72,14 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* filename, uint8_
  */
 SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance);
 
+/** 
+ * Find the first manufacture key with this name
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param name Manufacture name
+ * @return const SubGhzKey* pointer to the key, NULL if not found
+ */
+const SubGhzKey* subghz_keystore_find(SubGhzKeystore* instance, const char* name);
+
 /** 
  * Save RAW encrypted to file
  * @param input_file_name Full path to the input file
@@ -77,6 +103,29 @@ bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t*
 
 void subghz_keystore_reset_kl(SubGhzKeystore* instance);
 
+/** 
+ * Find the key that matched the remote with this serial last time
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param serial Serial number of the remote
+ * @param hint Pointer to a SubGhzKeystoreHint, filled on success
+ * @return true if found
+ */
+bool subghz_keystore_hint_get(SubGhzKeystore* instance, uint32_t serial, SubGhzKeystoreHint* hint);
+
+/** 
+ * Remember the key that matched the remote with this serial
+ * Only a few most recent remotes are kept.
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param serial Serial number of the remote
+ * @param key_index Index of the key in the keystore data
+ * @param learning Protocol specific learning that matched
+ */
+void subghz_keystore_hint_set(
+    SubGhzKeystore* instance,
+    uint32_t serial,
+    size_t key_index,
+    uint8_t learning);
+
 #ifdef __cplusplus
 }
 #endif
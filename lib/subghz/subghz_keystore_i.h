@@ -2,8 +2,24 @@
 
 #include <m-array.h>
 
+#define SUBGHZ_KEYSTORE_HINT_COUNT 8
+
+ARRAY_DEF(SubGhzKeystoreNameBlock, char*, M_PTR_OPLIST);
+
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
+    // Memory holding key names: one block per text key, one per compiled file
+    SubGhzKeystoreNameBlock_t name_blocks;
+
+    // Key indexes sorted by name, valid while index_size matches the key count
+    const uint16_t* index;
+    uint16_t* index_buffer;
+    size_t index_size;
+
     const char* mfname;
     uint8_t kl_type;
+
+    // Most recently matched remotes, most recent first
+    SubGhzKeystoreHint hints[SUBGHZ_KEYSTORE_HINT_COUNT];
+    size_t hint_count;
 };
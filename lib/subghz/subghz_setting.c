@@ -223,6 +223,11 @@ void subghz_setting_load(SubGhzSetting* instance, const char* file_path) {
                 break;
             }
 
+            // Every key kind is read from the start of the file, index is optional
+            if(!flipper_format_build_index(fff_data_file)) {
+                FURI_LOG_W(TAG, "Failed to index %s", file_path);
+            }
+
             // Standard frequencies (optional)
             temp_bool = true;
             flipper_format_read_bool(fff_data_file, "Add_standard_frequencies", &temp_bool, 1);
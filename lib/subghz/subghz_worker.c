@@ -4,6 +4,8 @@
 
 #define TAG "SubGhzWorker"
 
+#define SUBGHZ_WORKER_BATCH_SIZE 64
+
 struct SubGhzWorker {
     FuriThread* thread;
     FuriStreamBuffer* stream;
@@ -16,7 +18,11 @@ struct SubGhzWorker {
 
     SubGhzWorkerOverrunCallback overrun_callback;
     SubGhzWorkerPairCallback pair_callback;
+    SubGhzWorkerBatchCallback batch_callback;
     void* context;
+
+    LevelDuration batch_in[SUBGHZ_WORKER_BATCH_SIZE];
+    LevelDuration batch_out[SUBGHZ_WORKER_BATCH_SIZE];
 };
 
 /** Rx callback timer
@@ -38,16 +44,39 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
     if(sizeof(LevelDuration) != ret) instance->overrun = true;
 }
 
-/** Worker callback thread
+/** Glue short durations and same level pairs into the pending pair
  * 
- * @param context 
- * @return exit code 
+ * @param instance Pointer to a SubGhzWorker instance
+ * @param level received signal level
+ * @param duration received signal duration
+ * @param output filled with the completed pair, if any
+ * @return true if output contains a completed pair
  */
-static int32_t subghz_worker_thread_callback(void* context) {
-    SubGhzWorker* instance = context;
+static inline bool subghz_worker_filter(
+    SubGhzWorker* instance,
+    bool level,
+    uint32_t duration,
+    LevelDuration* output) {
+    if((duration < instance->filter_duration) ||
+       (instance->filter_level_duration.level == level)) {
+        instance->filter_level_duration.duration += duration;
+        return false;
+    }
+
+    *output = level_duration_make(
+        instance->filter_level_duration.level, instance->filter_level_duration.duration);
+    instance->filter_level_duration.duration = duration;
+    instance->filter_level_duration.level = level;
+    return true;
+}
 
+/** Worker callback thread, one pair per callback
+ * 
+ * @param instance Pointer to a SubGhzWorker instance
+ */
+static void subghz_worker_process_pairs(SubGhzWorker* instance) {
     LevelDuration level_duration;
-    while(instance->running) {
+    while(instance->running && !instance->batch_callback) {
         int ret = furi_stream_buffer_receive(
             instance->stream, &level_duration, sizeof(LevelDuration), 10);
         if(ret == sizeof(LevelDuration)) {
@@ -55,25 +84,73 @@ static int32_t subghz_worker_thread_callback(void* context) {
                 FURI_LOG_E(TAG, "Overrun buffer");
                 if(instance->overrun_callback) instance->overrun_callback(instance->context);
             } else {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-
-                if((duration < instance->filter_duration) ||
-                   (instance->filter_level_duration.level == level)) {
-                    instance->filter_level_duration.duration += duration;
-
-                } else if(instance->filter_level_duration.level != level) {
+                LevelDuration pair;
+                if(subghz_worker_filter(
+                       instance,
+                       level_duration_get_level(level_duration),
+                       level_duration_get_duration(level_duration),
+                       &pair)) {
                     if(instance->pair_callback)
                         instance->pair_callback(
                             instance->context,
-                            instance->filter_level_duration.level,
-                            instance->filter_level_duration.duration);
+                            level_duration_get_level(pair),
+                            level_duration_get_duration(pair));
+                }
+            }
+        }
+    }
+}
 
-                    instance->filter_level_duration.duration = duration;
-                    instance->filter_level_duration.level = level;
+/** Worker callback thread, drains the stream in blocks and delivers them at once
+ * 
+ * @param instance Pointer to a SubGhzWorker instance
+ */
+static void subghz_worker_process_batches(SubGhzWorker* instance) {
+    while(instance->running && instance->batch_callback) {
+        size_t ret = furi_stream_buffer_receive(
+            instance->stream, instance->batch_in, sizeof(instance->batch_in), 10);
+        size_t count_in = ret / sizeof(LevelDuration);
+        size_t count_out = 0;
+
+        for(size_t i = 0; i < count_in; i++) {
+            LevelDuration level_duration = instance->batch_in[i];
+            if(level_duration_is_reset(level_duration)) {
+                // Deliver what was received before the overrun, then report it
+                if(count_out) {
+                    instance->batch_callback(instance->context, instance->batch_out, count_out);
+                    count_out = 0;
                 }
+                FURI_LOG_E(TAG, "Overrun buffer");
+                if(instance->overrun_callback) instance->overrun_callback(instance->context);
+            } else if(subghz_worker_filter(
+                          instance,
+                          level_duration_get_level(level_duration),
+                          level_duration_get_duration(level_duration),
+                          &instance->batch_out[count_out])) {
+                count_out++;
             }
         }
+
+        if(count_out) {
+            instance->batch_callback(instance->context, instance->batch_out, count_out);
+        }
+    }
+}
+
+/** Worker callback thread
+ * 
+ * @param context 
+ * @return exit code 
+ */
+static int32_t subghz_worker_thread_callback(void* context) {
+    SubGhzWorker* instance = context;
+
+    while(instance->running) {
+        if(instance->batch_callback) {
+            subghz_worker_process_batches(instance);
+        } else {
+            subghz_worker_process_pairs(instance);
+        }
     }
 
     return 0;
@@ -115,6 +192,13 @@ void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCal
     instance->pair_callback = callback;
 }
 
+void subghz_worker_set_batch_callback(
+    SubGhzWorker* instance,
+    SubGhzWorkerBatchCallback callback) {
+    furi_check(instance);
+    instance->batch_callback = callback;
+}
+
 void subghz_worker_set_context(SubGhzWorker* instance, void* context) {
     furi_check(instance);
     instance->context = context;
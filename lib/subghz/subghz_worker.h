@@ -1,6 +1,7 @@
 #pragma once
 
 #include <furi_hal.h>
+#include <lib/toolbox/level_duration.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,6 +13,11 @@ typedef void (*SubGhzWorkerOverrunCallback)(void* context);
 
 typedef void (*SubGhzWorkerPairCallback)(void* context, bool level, uint32_t duration);
 
+typedef void (*SubGhzWorkerBatchCallback)(
+    void* context,
+    const LevelDuration* level_duration,
+    size_t count);
+
 void subghz_worker_rx_callback(bool level, uint32_t duration, void* context);
 
 /** 
@@ -42,6 +48,17 @@ void subghz_worker_set_overrun_callback(
  */
 void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCallback callback);
 
+/** 
+ * Batch callback SubGhzWorker.
+ * When set, the worker drains received pairs in blocks, filters them in one pass and
+ * delivers the whole block at once instead of calling the pair callback per pair.
+ * @param instance Pointer to a SubGhzWorker instance
+ * @param callback SubGhzWorkerBatchCallback callback, NULL to go back to the pair callback
+ */
+void subghz_worker_set_batch_callback(
+    SubGhzWorker* instance,
+    SubGhzWorkerBatchCallback callback);
+
 /** 
  * Context callback SubGhzWorker.
  * @param instance Pointer to a SubGhzWorker instance
@@ -83,6 +83,16 @@ typedef uint32_t (*SubGhzGetHashDataLong)(void* decoder);
 typedef void (*SubGhzGetString)(void* decoder, FuriString* output);
 typedef void (*SubGhzGetStringBrief)(void* decoder, FuriString* output);
 
+/** Pulse window that can move an idle decoder out of its reset step */
+typedef struct {
+    bool level;
+    uint32_t duration_min;
+    uint32_t duration_max;
+} SubGhzProtocolDecoderWakeup;
+
+typedef bool (*SubGhzDecoderIsIdle)(void* decoder);
+typedef void (*SubGhzDecoderGetWakeup)(void* decoder, SubGhzProtocolDecoderWakeup* wakeup);
+
 // Encoder specific
 typedef void (*SubGhzEncoderStop)(void* encoder);
 typedef LevelDuration (*SubGhzEncoderYield)(void* context);
@@ -101,6 +111,11 @@ typedef struct {
 
     SubGhzGetHashDataLong get_hash_data_long;
     SubGhzGetStringBrief get_string_brief;
+
+    // Optional, used by SubGhzReceiver to skip idle decoders on unrelated pulses.
+    // Appended in API 64.0, applications built with older SDK are not loaded.
+    SubGhzDecoderIsIdle is_idle;
+    SubGhzDecoderGetWakeup get_wakeup;
 } SubGhzProtocolDecoder;
 
 typedef struct {
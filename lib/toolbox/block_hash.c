@@ -0,0 +1,75 @@
+#include "block_hash.h"
+
+#include <mbedtls/md5.h>
+
+/* Both halves are kept modulo 2^16 as in rsync */
+#define BLOCK_HASH_LOW(hash) ((hash) & 0xFFFF)
+#define BLOCK_HASH_HIGH(hash) ((hash) >> 16)
+#define BLOCK_HASH(a, b) ((((b) & 0xFFFF) << 16) | ((a) & 0xFFFF))
+
+uint32_t block_hash_weak(const uint8_t* data, size_t size) {
+    furi_check(data || !size);
+
+    uint32_t a = 0;
+    uint32_t b = 0;
+    for(size_t i = 0; i < size; i++) {
+        a += data[i];
+        b += (uint32_t)(size - i) * data[i];
+    }
+
+    return BLOCK_HASH(a, b);
+}
+
+uint32_t block_hash_roll(uint32_t hash, size_t size, uint8_t out, uint8_t in) {
+    uint32_t a = BLOCK_HASH_LOW(hash) - out + in;
+    uint32_t b = BLOCK_HASH_HIGH(hash) - (uint32_t)size * out + a;
+
+    return BLOCK_HASH(a, b);
+}
+
+bool block_hash_calc_file(
+    File* file,
+    size_t block_size,
+    BlockHashCallback callback,
+    void* context) {
+    furi_check(file);
+    furi_check(block_size);
+    furi_check(callback);
+
+    if(!storage_file_seek(file, 0, true)) {
+        return false;
+    }
+
+    uint8_t* data = malloc(block_size);
+    uint8_t strong[BLOCK_HASH_STRONG_SIZE];
+    mbedtls_md5_context* md5_ctx = malloc(sizeof(mbedtls_md5_context));
+    bool result = true;
+
+    for(uint32_t index = 0;; index++) {
+        size_t read_size = storage_file_read(file, data, block_size);
+        if(storage_file_get_error(file) != FSE_OK) {
+            result = false;
+            break;
+        }
+        if(read_size == 0) {
+            break;
+        }
+
+        mbedtls_md5_init(md5_ctx);
+        mbedtls_md5_starts(md5_ctx);
+        mbedtls_md5_update(md5_ctx, data, read_size);
+        mbedtls_md5_finish(md5_ctx, strong);
+        mbedtls_md5_free(md5_ctx);
+
+        callback(index, read_size, block_hash_weak(data, read_size), strong, context);
+
+        if(read_size < block_size) {
+            break;
+        }
+    }
+
+    free(md5_ctx);
+    free(data);
+
+    return result;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdint.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BLOCK_HASH_STRONG_SIZE 16
+
+/**
+ * Rolling (weak) block hash, same as rsync checksum
+ * @param data block data
+ * @param size block size
+ * @return uint32_t hash
+ */
+uint32_t block_hash_weak(const uint8_t* data, size_t size);
+
+/**
+ * Move rolling hash window by one byte
+ * @param hash hash of the previous window
+ * @param size window size
+ * @param out byte leaving the window
+ * @param in byte entering the window
+ * @return uint32_t hash of the new window
+ */
+uint32_t block_hash_roll(uint32_t hash, size_t size, uint8_t out, uint8_t in);
+
+/**
+ * Block hash callback
+ * @param index block index
+ * @param size block size, last block may be shorter
+ * @param weak rolling hash of the block
+ * @param strong md5 of the block
+ * @param context callback context
+ */
+typedef void (*BlockHashCallback)(
+    uint32_t index,
+    size_t size,
+    uint32_t weak,
+    const uint8_t strong[BLOCK_HASH_STRONG_SIZE],
+    void* context);
+
+/**
+ * Hash opened file from the start in blocks of block_size bytes
+ * @param file opened file
+ * @param block_size block size
+ * @param callback called for each block
+ * @param context callback context
+ * @return true if whole file was hashed
+ */
+bool block_hash_calc_file(
+    File* file,
+    size_t block_size,
+    BlockHashCallback callback,
+    void* context);
+
+#ifdef __cplusplus
+}
+#endif
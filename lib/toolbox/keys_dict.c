@@ -5,14 +5,46 @@
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/stream/buffered_file_stream.h>
 #include <toolbox/args.h>
+#include <toolbox/path.h>
 
 #define TAG "KeysDict"
 
+#define KEYS_DICT_COMPILED_MAGIC (0x5444424BUL) // "KBDT"
+#define KEYS_DICT_COMPILED_VERSION (1U)
+#define KEYS_DICT_COMPILED_BLOCK (512U)
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t key_size;
+    uint16_t reserved;
+    uint32_t source_timestamp;
+    uint32_t source_size;
+    uint32_t total_keys;
+} KeysDictCompiledHeader;
+
 struct KeysDict {
     Stream* stream;
     size_t key_size;
     size_t key_size_symbols;
     size_t total_keys;
+
+    // Loaded mode
+    bool loaded;
+    bool modified;
+    uint64_t* keys; // In file order, deleted keys are kept until write back
+    uint16_t* keys_sorted; // Indexes of not deleted keys, sorted by value
+    uint32_t* keys_deleted; // Bitmap over keys
+    size_t keys_count;
+    size_t keys_capacity;
+    size_t keys_in_file;
+    size_t keys_position;
+
+    // Compiled mode
+    File* compiled;
+    uint8_t* block;
+    size_t block_keys;
+    size_t block_position;
 };
 
 static inline void keys_dict_add_ending_new_line(KeysDict* instance) {
@@ -52,6 +84,474 @@ static bool keys_dict_read_key_line(KeysDict* instance, FuriString* line, bool*
     return false;
 }
 
+static void keys_dict_int_to_str(KeysDict* instance, const uint8_t* key_int, FuriString* key_str) {
+    furi_assert(instance);
+    furi_assert(key_str);
+    furi_assert(key_int);
+
+    furi_string_reset(key_str);
+
+    for(size_t i = 0; i < instance->key_size; i++)
+        furi_string_cat_printf(key_str, "%02X", key_int[i]);
+}
+
+static void keys_dict_str_to_int(KeysDict* instance, FuriString* key_str, uint64_t* key_int) {
+    furi_assert(instance);
+    furi_assert(key_str);
+    furi_assert(key_int);
+
+    uint8_t key_byte_tmp;
+    char h, l;
+
+    *key_int = 0ULL;
+
+    for(size_t i = 0; i < instance->key_size_symbols - 1; i += 2) {
+        h = furi_string_get_char(key_str, i);
+        l = furi_string_get_char(key_str, i + 1);
+
+        args_char_to_hex(h, l, &key_byte_tmp);
+        *key_int |= (uint64_t)key_byte_tmp << (8 * (instance->key_size - 1 - i / 2));
+    }
+}
+
+static uint64_t keys_dict_bytes_to_int(const uint8_t* key, size_t key_size) {
+    uint64_t key_int = 0;
+    for(size_t i = 0; i < key_size; i++) {
+        key_int = (key_int << 8) | key[i];
+    }
+    return key_int;
+}
+
+static void keys_dict_int_to_bytes(uint64_t key_int, uint8_t* key, size_t key_size) {
+    while(key_size--) {
+        key[key_size] = (uint8_t)key_int;
+        key_int >>= 8;
+    }
+}
+
+static inline bool keys_dict_loaded_is_deleted(KeysDict* instance, size_t index) {
+    return instance->keys_deleted[index / 32] & (1UL << (index % 32));
+}
+
+// Position of the first sorted entry not less than key
+static size_t keys_dict_loaded_lower_bound(KeysDict* instance, uint64_t key) {
+    size_t low = 0;
+    size_t high = instance->total_keys;
+
+    while(low < high) {
+        size_t mid = low + (high - low) / 2;
+        if(instance->keys[instance->keys_sorted[mid]] < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+static bool keys_dict_loaded_find(KeysDict* instance, uint64_t key, size_t* position) {
+    *position = keys_dict_loaded_lower_bound(instance, key);
+    return *position < instance->total_keys &&
+           instance->keys[instance->keys_sorted[*position]] == key;
+}
+
+static size_t keys_dict_loaded_size(size_t keys) {
+    return keys * (sizeof(uint64_t) + sizeof(uint16_t)) + (keys + 31) / 32 * sizeof(uint32_t);
+}
+
+// Index of this size fits in memory, keeping a safety margin
+static bool keys_dict_loaded_fits(size_t keys) {
+    return keys_dict_loaded_size(keys) < memmgr_heap_get_max_free_block() / 2;
+}
+
+static bool keys_dict_loaded_reserve(KeysDict* instance, size_t capacity) {
+    if(capacity <= instance->keys_capacity) return true;
+    if(capacity > KEYS_DICT_LOADED_KEYS_MAX) return false;
+
+    // Grow in steps to keep adding cheap, unless memory is short
+    size_t grown =
+        MIN(MAX(capacity, instance->keys_capacity * 3 / 2), KEYS_DICT_LOADED_KEYS_MAX);
+    if(keys_dict_loaded_fits(grown)) {
+        capacity = grown;
+    } else if(!keys_dict_loaded_fits(capacity)) {
+        return false;
+    }
+    size_t bitmap_words_old = (instance->keys_capacity + 31) / 32;
+    size_t bitmap_words = (capacity + 31) / 32;
+
+    instance->keys = realloc(instance->keys, capacity * sizeof(uint64_t)); //-V701
+    instance->keys_sorted = realloc(instance->keys_sorted, capacity * sizeof(uint16_t)); //-V701
+    instance->keys_deleted =
+        realloc(instance->keys_deleted, bitmap_words * sizeof(uint32_t)); //-V701
+    memset(
+        &instance->keys_deleted[bitmap_words_old],
+        0,
+        (bitmap_words - bitmap_words_old) * sizeof(uint32_t));
+    instance->keys_capacity = capacity;
+
+    return true;
+}
+
+static bool keys_dict_loaded_add(KeysDict* instance, uint64_t key) {
+    size_t position;
+    if(keys_dict_loaded_find(instance, key, &position)) return true;
+    if(!keys_dict_loaded_reserve(instance, instance->keys_count + 1)) return false;
+
+    memmove(
+        &instance->keys_sorted[position + 1],
+        &instance->keys_sorted[position],
+        (instance->total_keys - position) * sizeof(uint16_t));
+    instance->keys_sorted[position] = instance->keys_count;
+    instance->keys[instance->keys_count++] = key;
+    instance->total_keys++;
+
+    return true;
+}
+
+static bool keys_dict_loaded_delete(KeysDict* instance, uint64_t key) {
+    size_t position;
+    if(!keys_dict_loaded_find(instance, key, &position)) return false;
+
+    size_t index = instance->keys_sorted[position];
+    instance->keys_deleted[index / 32] |= 1UL << (index % 32);
+    instance->total_keys--;
+    memmove(
+        &instance->keys_sorted[position],
+        &instance->keys_sorted[position + 1],
+        (instance->total_keys - position) * sizeof(uint16_t));
+
+    return true;
+}
+
+static void keys_dict_loaded_free(KeysDict* instance) {
+    free(instance->keys);
+    free(instance->keys_sorted);
+    free(instance->keys_deleted);
+    instance->keys = NULL;
+    instance->keys_sorted = NULL;
+    instance->keys_deleted = NULL;
+    instance->keys_count = 0;
+    instance->keys_capacity = 0;
+    instance->loaded = false;
+}
+
+static void keys_dict_load(KeysDict* instance) {
+    size_t file_keys = instance->total_keys;
+
+    if(file_keys > KEYS_DICT_LOADED_KEYS_MAX || instance->key_size > sizeof(uint64_t)) {
+        FURI_LOG_W(TAG, "Dictionary is too big to load, using file access");
+        return;
+    }
+    if(!keys_dict_loaded_reserve(instance, MAX(file_keys, 16U))) {
+        FURI_LOG_W(TAG, "Not enough memory to load dictionary, using file access");
+        return;
+    }
+
+    instance->loaded = true;
+    instance->total_keys = 0;
+
+    FuriString* line = furi_string_alloc();
+    bool is_endfile = false;
+    uint64_t key = 0;
+
+    // Keep duplicates, so every key line in the file has its own entry for the write back
+    while(!is_endfile) {
+        if(keys_dict_read_key_line(instance, line, &is_endfile)) {
+            if(!keys_dict_loaded_reserve(instance, instance->keys_count + 1)) break;
+
+            keys_dict_str_to_int(instance, line, &key);
+            // Duplicates go after the present ones, so the first line is deleted first
+            size_t position = (key == UINT64_MAX) ?
+                                  instance->total_keys :
+                                  keys_dict_loaded_lower_bound(instance, key + 1);
+
+            memmove(
+                &instance->keys_sorted[position + 1],
+                &instance->keys_sorted[position],
+                (instance->total_keys - position) * sizeof(uint16_t));
+            instance->keys_sorted[position] = instance->keys_count;
+            instance->keys[instance->keys_count++] = key;
+            instance->total_keys++;
+        }
+    }
+
+    instance->keys_in_file = instance->keys_count;
+    stream_rewind(instance->stream);
+
+    furi_string_free(line);
+}
+
+static void keys_dict_save(KeysDict* instance) {
+    FuriString* line = furi_string_alloc();
+    bool is_endfile = false;
+    size_t index = 0;
+
+    stream_rewind(instance->stream);
+
+    // Drop lines of deleted keys
+    while(!is_endfile && index < instance->keys_in_file) {
+        size_t line_start = stream_tell(instance->stream);
+        if(!keys_dict_read_key_line(instance, line, &is_endfile)) continue;
+
+        if(keys_dict_loaded_is_deleted(instance, index)) {
+            size_t line_size = stream_tell(instance->stream) - line_start;
+            if(!stream_seek(instance->stream, line_start, StreamOffsetFromStart) ||
+               !stream_delete(instance->stream, line_size)) {
+                FURI_LOG_E(TAG, "Failed to delete key line");
+                break;
+            }
+        }
+        index++;
+    }
+
+    // Append new keys
+    uint8_t* key = malloc(instance->key_size);
+    if(stream_seek(instance->stream, 0, StreamOffsetFromEnd)) {
+        for(index = instance->keys_in_file; index < instance->keys_count; index++) {
+            if(keys_dict_loaded_is_deleted(instance, index)) continue;
+
+            keys_dict_int_to_bytes(instance->keys[index], key, instance->key_size);
+            keys_dict_int_to_str(instance, key, line);
+            furi_string_cat_str(line, "\n");
+            if(!stream_insert_string(instance->stream, line)) {
+                FURI_LOG_E(TAG, "Failed to write key");
+                break;
+            }
+        }
+    }
+
+    free(key);
+    furi_string_free(line);
+}
+
+static void keys_dict_compiled_path(const char* path, FuriString* compiled_path) {
+    FuriString* name = furi_string_alloc();
+
+    path_extract_dirname(path, compiled_path);
+    path_extract_filename_no_ext(path, name);
+    furi_string_cat_str(name, KEYS_DICT_COMPILED_EXTENSION);
+    path_append(compiled_path, furi_string_get_cstr(name));
+
+    furi_string_free(name);
+}
+
+static bool keys_dict_compiled_stat(
+    Storage* storage,
+    const char* path,
+    KeysDictCompiledHeader* header) {
+    FileInfo info;
+    if(storage_common_stat(storage, path, &info) != FSE_OK) return false;
+    if(storage_common_timestamp(storage, path, &header->source_timestamp) != FSE_OK) return false;
+    header->source_size = info.size;
+
+    return true;
+}
+
+static bool keys_dict_compiled_is_valid(
+    KeysDict* instance,
+    const KeysDictCompiledHeader* source,
+    KeysDictCompiledHeader* header) {
+    if(storage_file_read(instance->compiled, header, sizeof(KeysDictCompiledHeader)) !=
+       sizeof(KeysDictCompiledHeader))
+        return false;
+
+    return header->magic == KEYS_DICT_COMPILED_MAGIC &&
+           header->version == KEYS_DICT_COMPILED_VERSION &&
+           header->key_size == instance->key_size &&
+           header->source_timestamp == source->source_timestamp &&
+           header->source_size == source->source_size &&
+           storage_file_size(instance->compiled) ==
+               sizeof(KeysDictCompiledHeader) + header->total_keys * instance->key_size;
+}
+
+static bool keys_dict_compile(
+    KeysDict* instance,
+    Storage* storage,
+    const char* path,
+    KeysDictMode mode,
+    KeysDictCompiledHeader* header) {
+    // Dedup through the loaded mode if its index fits in memory
+    size_t keys_max = header->source_size / instance->key_size_symbols + 1;
+    if(instance->key_size <= sizeof(uint64_t) && keys_max <= KEYS_DICT_LOADED_KEYS_MAX &&
+       keys_dict_loaded_fits(keys_max)) {
+        mode |= KeysDictModeLoad;
+    } else {
+        FURI_LOG_W(TAG, "Not enough memory to remove duplicates");
+    }
+
+    KeysDict* source = keys_dict_alloc(path, mode & ~KeysDictModeCompiled, instance->key_size);
+    uint8_t* block = malloc(KEYS_DICT_COMPILED_BLOCK);
+    const size_t block_keys = KEYS_DICT_COMPILED_BLOCK / instance->key_size;
+    size_t block_count = 0;
+    bool success = false;
+
+    header->magic = KEYS_DICT_COMPILED_MAGIC;
+    header->version = KEYS_DICT_COMPILED_VERSION;
+    header->key_size = instance->key_size;
+    header->total_keys = 0;
+
+    do {
+        // Header is rewritten with the final key count once all keys are written
+        if(storage_file_write(instance->compiled, header, sizeof(KeysDictCompiledHeader)) !=
+           sizeof(KeysDictCompiledHeader))
+            break;
+
+        size_t index = 0;
+        bool write_error = false;
+        while(!write_error) {
+            uint8_t* key = &block[block_count * instance->key_size];
+            if(source->loaded) {
+                // Only the first occurrence of a key is sorted first among its duplicates
+                for(; index < source->keys_count; index++) {
+                    uint64_t key_int = source->keys[index];
+                    size_t position = keys_dict_loaded_lower_bound(source, key_int);
+                    if(source->keys_sorted[position] == index) break;
+                }
+                if(index == source->keys_count) break;
+                keys_dict_int_to_bytes(source->keys[index++], key, instance->key_size);
+            } else if(!keys_dict_get_next_key(source, key, instance->key_size)) {
+                break;
+            }
+
+            header->total_keys++;
+            if(++block_count == block_keys) {
+                size_t block_size = block_count * instance->key_size;
+                write_error = storage_file_write(instance->compiled, block, block_size) !=
+                              block_size;
+                block_count = 0;
+            }
+        }
+        if(write_error) break;
+
+        size_t block_size = block_count * instance->key_size;
+        if(storage_file_write(instance->compiled, block, block_size) != block_size) break;
+
+        // Reading the list may have fixed its last line ending, so take its state after that
+        keys_dict_free(source);
+        source = NULL;
+        if(!keys_dict_compiled_stat(storage, path, header)) break;
+        if(!storage_file_seek(instance->compiled, 0, true)) break;
+        if(storage_file_write(instance->compiled, header, sizeof(KeysDictCompiledHeader)) !=
+           sizeof(KeysDictCompiledHeader))
+            break;
+
+        success = true;
+    } while(false);
+
+    FURI_LOG_I(TAG, "Compiled %lu keys, success: %d", header->total_keys, success);
+
+    free(block);
+    if(source) keys_dict_free(source);
+
+    return success;
+}
+
+static bool keys_dict_compiled_open(
+    KeysDict* instance,
+    Storage* storage,
+    const char* path,
+    KeysDictMode mode) {
+    KeysDictCompiledHeader source = {};
+    KeysDictCompiledHeader header = {};
+    FuriString* compiled_path = furi_string_alloc();
+    bool success = false;
+
+    keys_dict_compiled_path(path, compiled_path);
+    instance->compiled = storage_file_alloc(storage);
+
+    do {
+        // Missing list is left to the text mode
+        if(!keys_dict_compiled_stat(storage, path, &source)) break;
+
+        bool is_valid = storage_file_open(
+                            instance->compiled,
+                            furi_string_get_cstr(compiled_path),
+                            FSAM_READ,
+                            FSOM_OPEN_EXISTING) &&
+                        keys_dict_compiled_is_valid(instance, &source, &header);
+
+        if(!is_valid) {
+            storage_file_close(instance->compiled);
+            header = source;
+            if(!storage_file_open(
+                   instance->compiled,
+                   furi_string_get_cstr(compiled_path),
+                   FSAM_READ_WRITE,
+                   FSOM_CREATE_ALWAYS))
+                break;
+            if(!keys_dict_compile(instance, storage, path, mode, &header)) break;
+            if(!storage_file_seek(instance->compiled, sizeof(KeysDictCompiledHeader), true))
+                break;
+        }
+
+        instance->total_keys = header.total_keys;
+        instance->block = malloc(KEYS_DICT_COMPILED_BLOCK);
+        success = true;
+    } while(false);
+
+    if(!success) {
+        storage_file_close(instance->compiled);
+        storage_file_free(instance->compiled);
+        instance->compiled = NULL;
+        storage_common_remove(storage, furi_string_get_cstr(compiled_path));
+    }
+
+    furi_string_free(compiled_path);
+
+    return success;
+}
+
+static bool keys_dict_compiled_read_block(KeysDict* instance) {
+    size_t block_size = KEYS_DICT_COMPILED_BLOCK / instance->key_size * instance->key_size;
+    instance->block_keys =
+        storage_file_read(instance->compiled, instance->block, block_size) / instance->key_size;
+    instance->block_position = 0;
+
+    return instance->block_keys > 0;
+}
+
+static bool keys_dict_compiled_get_next_key(KeysDict* instance, uint8_t* key) {
+    if(instance->block_position == instance->block_keys &&
+       !keys_dict_compiled_read_block(instance)) {
+        return false;
+    }
+
+    memcpy(
+        key, &instance->block[instance->block_position * instance->key_size], instance->key_size);
+    instance->block_position++;
+
+    return true;
+}
+
+static bool keys_dict_compiled_rewind(KeysDict* instance) {
+    instance->block_keys = 0;
+    instance->block_position = 0;
+
+    return storage_file_seek(instance->compiled, sizeof(KeysDictCompiledHeader), true);
+}
+
+static bool keys_dict_compiled_is_key_present(KeysDict* instance, const uint8_t* key) {
+    // Restore the iteration position after the scan
+    uint64_t position = storage_file_tell(instance->compiled) -
+                        (instance->block_keys - instance->block_position) * instance->key_size;
+    bool key_found = false;
+
+    keys_dict_compiled_rewind(instance);
+    while(!key_found && keys_dict_compiled_read_block(instance)) {
+        for(size_t i = 0; i < instance->block_keys && !key_found; i++) {
+            key_found =
+                memcmp(&instance->block[i * instance->key_size], key, instance->key_size) == 0;
+        }
+    }
+
+    instance->block_keys = 0;
+    instance->block_position = 0;
+    storage_file_seek(instance->compiled, position, true);
+
+    return key_found;
+}
+
 bool keys_dict_check_presence(const char* path) {
     furi_check(path);
 
@@ -73,8 +573,8 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
     Storage* storage = furi_record_open(RECORD_STORAGE);
     instance->stream = buffered_file_stream_alloc(storage);
 
-    FS_OpenMode open_mode = (mode == KeysDictModeOpenAlways) ? FSOM_OPEN_ALWAYS :
-                                                               FSOM_OPEN_EXISTING;
+    FS_OpenMode open_mode = (mode & KeysDictModeOpenAlways) ? FSOM_OPEN_ALWAYS :
+                                                              FSOM_OPEN_EXISTING;
 
     // Byte = 2 symbols + 1 end of line
     instance->key_size = key_size;
@@ -82,6 +582,15 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
 
     instance->total_keys = 0;
 
+    if(mode & KeysDictModeCompiled) {
+        furi_check(!(mode & KeysDictModeLoad));
+        if(keys_dict_compiled_open(instance, storage, path, mode)) {
+            FURI_LOG_I(TAG, "Loaded compiled dictionary with %zu keys", instance->total_keys);
+            return instance;
+        }
+        FURI_LOG_W(TAG, "Compiled dictionary unavailable, using text");
+    }
+
     bool file_exists =
         buffered_file_stream_open(instance->stream, path, FSAM_READ_WRITE, open_mode);
 
@@ -105,10 +614,14 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
         }
     }
     stream_rewind(instance->stream);
-    FURI_LOG_I(TAG, "Loaded dictionary with %zu keys", instance->total_keys);
-
     furi_string_free(line);
 
+    if(file_exists && (mode & KeysDictModeLoad)) {
+        keys_dict_load(instance);
+    }
+
+    FURI_LOG_I(TAG, "Loaded dictionary with %zu keys", instance->total_keys);
+
     return instance;
 }
 
@@ -116,6 +629,17 @@ void keys_dict_free(KeysDict* instance) {
     furi_check(instance);
     furi_check(instance->stream);
 
+    if(instance->loaded) {
+        if(instance->modified) keys_dict_save(instance);
+        keys_dict_loaded_free(instance);
+    }
+
+    if(instance->compiled) {
+        storage_file_close(instance->compiled);
+        storage_file_free(instance->compiled);
+        free(instance->block);
+    }
+
     buffered_file_stream_close(instance->stream);
     stream_free(instance->stream);
     free(instance);
@@ -123,36 +647,6 @@ void keys_dict_free(KeysDict* instance) {
     furi_record_close(RECORD_STORAGE);
 }
 
-static void keys_dict_int_to_str(KeysDict* instance, const uint8_t* key_int, FuriString* key_str) {
-    furi_assert(instance);
-    furi_assert(key_str);
-    furi_assert(key_int);
-
-    furi_string_reset(key_str);
-
-    for(size_t i = 0; i < instance->key_size; i++)
-        furi_string_cat_printf(key_str, "%02X", key_int[i]);
-}
-
-static void keys_dict_str_to_int(KeysDict* instance, FuriString* key_str, uint64_t* key_int) {
-    furi_assert(instance);
-    furi_assert(key_str);
-    furi_assert(key_int);
-
-    uint8_t key_byte_tmp;
-    char h, l;
-
-    *key_int = 0ULL;
-
-    for(size_t i = 0; i < instance->key_size_symbols - 1; i += 2) {
-        h = furi_string_get_char(key_str, i);
-        l = furi_string_get_char(key_str, i + 1);
-
-        args_char_to_hex(h, l, &key_byte_tmp);
-        *key_int |= (uint64_t)key_byte_tmp << (8 * (instance->key_size - 1 - i / 2));
-    }
-}
-
 size_t keys_dict_get_total_keys(KeysDict* instance) {
     furi_check(instance);
 
@@ -163,6 +657,15 @@ bool keys_dict_rewind(KeysDict* instance) {
     furi_check(instance);
     furi_check(instance->stream);
 
+    if(instance->loaded) {
+        instance->keys_position = 0;
+        return true;
+    }
+
+    if(instance->compiled) {
+        return keys_dict_compiled_rewind(instance);
+    }
+
     return stream_rewind(instance->stream);
 }
 
@@ -187,6 +690,21 @@ bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size) {
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    if(instance->loaded) {
+        while(instance->keys_position < instance->keys_count &&
+              keys_dict_loaded_is_deleted(instance, instance->keys_position)) {
+            instance->keys_position++;
+        }
+        if(instance->keys_position == instance->keys_count) return false;
+
+        keys_dict_int_to_bytes(instance->keys[instance->keys_position++], key, key_size);
+        return true;
+    }
+
+    if(instance->compiled) {
+        return keys_dict_compiled_get_next_key(instance, key);
+    }
+
     FuriString* temp_key = furi_string_alloc();
 
     bool key_read = keys_dict_get_next_key_str(instance, temp_key);
@@ -239,6 +757,15 @@ bool keys_dict_is_key_present(KeysDict* instance, const uint8_t* key, size_t key
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    if(instance->loaded) {
+        size_t position;
+        return keys_dict_loaded_find(instance, keys_dict_bytes_to_int(key, key_size), &position);
+    }
+
+    if(instance->compiled) {
+        return keys_dict_compiled_is_key_present(instance, key);
+    }
+
     FuriString* temp_key = furi_string_alloc();
 
     keys_dict_int_to_str(instance, key, temp_key);
@@ -276,10 +803,22 @@ bool keys_dict_add_key(KeysDict* instance, const uint8_t* key, size_t key_size)
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    if(instance->compiled) {
+        FURI_LOG_E(TAG, "Compiled dictionary is read only");
+        return false;
+    }
+
     FuriString* temp_key = furi_string_alloc();
 
     keys_dict_int_to_str(instance, key, temp_key);
-    bool key_added = keys_dict_add_key_str(instance, temp_key);
+    bool key_added;
+    if(instance->loaded) {
+        size_t keys_count = instance->keys_count;
+        key_added = keys_dict_loaded_add(instance, keys_dict_bytes_to_int(key, key_size));
+        instance->modified |= instance->keys_count != keys_count;
+    } else {
+        key_added = keys_dict_add_key_str(instance, temp_key);
+    }
 
     FURI_LOG_I(TAG, "Added key %s", furi_string_get_cstr(temp_key));
 
@@ -294,6 +833,18 @@ bool keys_dict_delete_key(KeysDict* instance, const uint8_t* key, size_t key_siz
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    if(instance->compiled) {
+        FURI_LOG_E(TAG, "Compiled dictionary is read only");
+        return false;
+    }
+
+    if(instance->loaded) {
+        uint64_t key_int = keys_dict_bytes_to_int(key, key_size);
+        bool key_removed = keys_dict_loaded_delete(instance, key_int);
+        instance->modified |= key_removed;
+        return key_removed;
+    }
+
     bool key_removed = false;
 
     uint8_t* temp_key = malloc(key_size);
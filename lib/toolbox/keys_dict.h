@@ -8,9 +8,27 @@
 extern "C" {
 #endif
 
+/** Maximum number of keys in a loaded list */
+#define KEYS_DICT_LOADED_KEYS_MAX (UINT16_MAX)
+
+/** Extension of the compiled list stored next to the text one */
+#define KEYS_DICT_COMPILED_EXTENSION ".bdict"
+
 typedef enum {
-    KeysDictModeOpenExisting,
-    KeysDictModeOpenAlways,
+    KeysDictModeOpenExisting = 0,
+    KeysDictModeOpenAlways = (1 << 0),
+    /** Flag: parse the list into memory once.
+     * Lookups use a sorted index and adding a present key is a no-op.
+     * Changes are written back to the file on keys_dict_free().
+     * Lists bigger than KEYS_DICT_LOADED_KEYS_MAX stay file backed.
+     */
+    KeysDictModeLoad = (1 << 1),
+    /** Flag: read keys from a compiled binary copy of the list.
+     * The copy is built on first use with duplicate keys removed, and rebuilt when the
+     * text list changes. The list is read only: adding and deleting keys fails.
+     * Can not be combined with KeysDictModeLoad.
+     */
+    KeysDictModeCompiled = (1 << 2),
 } KeysDictMode;
 
 typedef struct KeysDict KeysDict;
@@ -27,8 +45,8 @@ bool keys_dict_check_presence(const char* path);
  * Depending on mode, list will be opened or created.
  *
  * @param path      - Path of the file that contain the list
- * @param mode      - ListKeysMode value
- * @param key_size  - Size of each key in bytes
+ * @param mode      - KeysDictMode value, optionally combined with KeysDictModeLoad
+ * @param key_size  - Size of each key in bytes, up to 8 bytes in loaded mode
  *
  * @return Returns KeysDict list instance
 */
@@ -4,11 +4,23 @@
 #include "file_stream.h"
 #include "stream_cache.h"
 
+// Consecutive cache refills without seeking that enable read-ahead
+#define BUFFERED_FILE_STREAM_SEQUENTIAL_FILLS 2
+
 typedef struct {
     Stream stream_base;
     Stream* file_stream;
     StreamCache* cache;
     bool sync_pending;
+
+    // Read-ahead of the next cache block, the file position is past the prefetched data
+    StorageAsync* async;
+    uint8_t* prefetch_data;
+    volatile size_t prefetch_size;
+    bool prefetch_active;
+    uint8_t sequential_fills;
+
+    BufferedFileStreamStats stats;
 } BufferedFileStream;
 
 static void buffered_file_stream_free(BufferedFileStream* stream);
@@ -29,6 +41,8 @@ static bool buffered_file_stream_delete_and_insert(
 
 static bool buffered_file_stream_flush(BufferedFileStream* stream);
 static bool buffered_file_stream_unread(BufferedFileStream* stream);
+static size_t buffered_file_stream_fill(BufferedFileStream* stream);
+static bool buffered_file_stream_prefetch_drop(BufferedFileStream* stream);
 
 const StreamVTable buffered_file_stream_vtable = {
     .free = (StreamFreeFn)buffered_file_stream_free,
@@ -61,6 +75,8 @@ bool buffered_file_stream_open(
     furi_check(_stream);
     BufferedFileStream* stream = (BufferedFileStream*)_stream;
     furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
+    stream->sequential_fills = 0;
+    memset(&stream->stats, 0, sizeof(BufferedFileStreamStats));
     return file_stream_open(stream->file_stream, path, access_mode, open_mode);
 }
 
@@ -93,9 +109,21 @@ FS_Error buffered_file_stream_get_error(Stream* _stream) {
     return file_stream_get_error(stream->file_stream);
 }
 
+void buffered_file_stream_get_stats(Stream* _stream, BufferedFileStreamStats* stats) {
+    furi_check(_stream);
+    furi_check(stats);
+    BufferedFileStream* stream = (BufferedFileStream*)_stream;
+    furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
+    *stats = stream->stats;
+}
+
 static void buffered_file_stream_free(BufferedFileStream* stream) {
     furi_check(stream);
     buffered_file_stream_sync((Stream*)stream);
+    if(stream->async) {
+        storage_async_free(stream->async);
+        free(stream->prefetch_data);
+    }
     stream_free(stream->file_stream);
     stream_cache_free(stream->cache);
     free(stream);
@@ -106,12 +134,15 @@ static bool buffered_file_stream_eof(BufferedFileStream* stream) {
     const bool file_stream_eof = stream_eof(stream->file_stream);
     const bool cache_at_end = stream_cache_at_end(stream->cache);
     if(!stream->sync_pending) {
-        ret = file_stream_eof && cache_at_end;
+        if(stream->prefetch_active) {
+            storage_async_wait(stream->async, FuriWaitForever);
+        }
+        ret = file_stream_eof && cache_at_end &&
+              !(stream->prefetch_active && stream->prefetch_size);
     } else {
         const size_t remaining_size =
             stream_size(stream->file_stream) - stream_tell(stream->file_stream);
-        ret = stream_cache_size(stream->cache) >=
-              (remaining_size ? cache_at_end : file_stream_eof);
+        ret = cache_at_end && stream_cache_size(stream->cache) >= remaining_size;
     }
     return ret;
 }
@@ -119,6 +150,7 @@ static bool buffered_file_stream_eof(BufferedFileStream* stream) {
 static void buffered_file_stream_clean(BufferedFileStream* stream) {
     // Not syncing because data will be deleted anyway
     stream->sync_pending = false;
+    buffered_file_stream_prefetch_drop(stream);
     stream_cache_drop(stream->cache);
     stream_clean(stream->file_stream);
 }
@@ -132,7 +164,8 @@ static bool buffered_file_stream_seek(
 
     if(offset_type == StreamOffsetFromCurrent) {
         new_offset -= stream_cache_seek(stream->cache, offset);
-        if(new_offset < 0) {
+        // After a flush the file position is at the cache start, otherwise at its end
+        if(new_offset < 0 && !stream->sync_pending) {
             new_offset -= (int32_t)stream_cache_size(stream->cache);
         }
     }
@@ -141,8 +174,10 @@ static bool buffered_file_stream_seek(
         if(stream->sync_pending) {
             success = buffered_file_stream_sync((Stream*)stream);
         } else {
+            success = buffered_file_stream_prefetch_drop(stream);
             stream_cache_drop(stream->cache);
         }
+        stream->sequential_fills = 0;
         if(success) {
             success = stream_seek(stream->file_stream, new_offset, offset_type);
         }
@@ -155,6 +190,10 @@ static size_t buffered_file_stream_tell(BufferedFileStream* stream) {
     size_t pos = stream_tell(stream->file_stream) + stream_cache_pos(stream->cache);
     if(!stream->sync_pending) {
         pos -= stream_cache_size(stream->cache);
+        if(stream->prefetch_active) {
+            storage_async_wait(stream->async, FuriWaitForever);
+            pos -= stream->prefetch_size;
+        }
     }
     return pos;
 }
@@ -193,6 +232,10 @@ static size_t
 
 static size_t buffered_file_stream_read(BufferedFileStream* stream, uint8_t* data, size_t size) {
     size_t need_to_read = size;
+    if(need_to_read && stream_cache_size(stream->cache) - stream_cache_pos(stream->cache) >=
+                           need_to_read) {
+        stream->stats.hits++;
+    }
     while(need_to_read) {
         need_to_read -=
             stream_cache_read(stream->cache, data + (size - need_to_read), need_to_read);
@@ -200,7 +243,7 @@ static size_t buffered_file_stream_read(BufferedFileStream* stream, uint8_t* dat
             if(stream->sync_pending) {
                 if(!buffered_file_stream_flush(stream)) break;
             }
-            if(!stream_cache_fill(stream->cache, stream->file_stream)) break;
+            if(!buffered_file_stream_fill(stream)) break;
         }
     }
     return size - need_to_read;
@@ -237,13 +280,87 @@ static bool buffered_file_stream_flush(BufferedFileStream* stream) {
     return success;
 }
 
+static void buffered_file_stream_prefetch_callback(
+    void* buff,
+    size_t bytes,
+    FS_Error error,
+    void* context) {
+    UNUSED(buff);
+    UNUSED(error);
+    BufferedFileStream* stream = context;
+    stream->prefetch_size = bytes;
+}
+
+// Start reading the next block in background
+static void buffered_file_stream_prefetch(BufferedFileStream* stream) {
+    const size_t capacity = stream_cache_capacity(stream->cache);
+    if(!stream->async) {
+        stream->async = storage_async_alloc(file_stream_get_file(stream->file_stream), 1);
+        storage_async_set_callback(
+            stream->async, buffered_file_stream_prefetch_callback, stream);
+        stream->prefetch_data = malloc(capacity);
+    }
+
+    stream->prefetch_size = 0;
+    stream->prefetch_active =
+        storage_async_read(stream->async, stream->prefetch_data, capacity, FuriWaitForever);
+}
+
+// Wait for the read-ahead and return its data to the file
+static bool buffered_file_stream_prefetch_drop(BufferedFileStream* stream) {
+    bool success = true;
+    if(stream->prefetch_active) {
+        storage_async_wait(stream->async, FuriWaitForever);
+        stream->prefetch_active = false;
+        if(stream->prefetch_size > 0) {
+            success = stream_seek(
+                stream->file_stream, -(int32_t)stream->prefetch_size, StreamOffsetFromCurrent);
+        }
+    }
+    stream->sequential_fills = 0;
+    return success;
+}
+
+// Load the next block into the cache, from the read-ahead if there is one
+static size_t buffered_file_stream_fill(BufferedFileStream* stream) {
+    size_t size_read;
+    if(stream->prefetch_active) {
+        storage_async_wait(stream->async, FuriWaitForever);
+        stream->prefetch_active = false;
+        size_read = stream->prefetch_size;
+        if(size_read > 0) {
+            stream_cache_swap(stream->cache, &stream->prefetch_data, size_read);
+        } else {
+            stream_cache_drop(stream->cache);
+        }
+        stream->stats.prefetches++;
+    } else {
+        size_read = stream_cache_fill(stream->cache, stream->file_stream);
+        stream->stats.refills++;
+    }
+    stream->stats.bytes += size_read;
+
+    if(size_read == stream_cache_capacity(stream->cache)) {
+        if(stream->sequential_fills < BUFFERED_FILE_STREAM_SEQUENTIAL_FILLS) {
+            stream->sequential_fills++;
+        }
+        if(stream->sequential_fills >= BUFFERED_FILE_STREAM_SEQUENTIAL_FILLS) {
+            buffered_file_stream_prefetch(stream);
+        }
+    } else {
+        stream->sequential_fills = 0;
+    }
+
+    return size_read;
+}
+
 // Drop read cache and adjust the underlying stream seek position
 static bool buffered_file_stream_unread(BufferedFileStream* stream) {
-    bool success = true;
+    bool success = buffered_file_stream_prefetch_drop(stream);
     const size_t cache_size = stream_cache_size(stream->cache);
     if(cache_size > 0) {
         const size_t cache_pos = stream_cache_pos(stream->cache);
-        if(cache_pos < cache_size) {
+        if(success && cache_pos < cache_size) {
             const int32_t offset = cache_size - cache_pos;
             success = stream_seek(stream->file_stream, -offset, StreamOffsetFromCurrent);
         }
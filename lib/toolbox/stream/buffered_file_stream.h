@@ -7,6 +7,16 @@
 extern "C" {
 #endif
 
+/**
+ * Buffered file stream statistics
+ */
+typedef struct {
+    uint32_t hits; /**< Reads served from the cache without touching the file */
+    uint32_t refills; /**< Cache refills that waited for a synchronous file read */
+    uint32_t prefetches; /**< Cache refills served by read-ahead */
+    uint32_t bytes; /**< Bytes loaded from the file into the cache */
+} BufferedFileStreamStats;
+
 /**
  * Allocate a file stream with buffered read operations
  * @return Stream*
@@ -48,6 +58,13 @@ bool buffered_file_stream_sync(Stream* stream);
  */
 FS_Error buffered_file_stream_get_error(Stream* stream);
 
+/**
+ * Get cache statistics, reset when the file is opened
+ * @param stream pointer to stream object.
+ * @param stats pointer to statistics structure to fill
+ */
+void buffered_file_stream_get_stats(Stream* stream, BufferedFileStreamStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
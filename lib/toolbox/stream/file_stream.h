@@ -42,6 +42,13 @@ bool file_stream_close(Stream* stream);
  */
 FS_Error file_stream_get_error(Stream* stream);
 
+/**
+ * Get the file object used by the stream
+ * @param stream pointer to stream object.
+ * @return File* pointer to the file object, owned by the stream
+ */
+File* file_stream_get_file(Stream* stream);
+
 #ifdef __cplusplus
 }
 #endif
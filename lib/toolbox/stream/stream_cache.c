@@ -1,23 +1,26 @@
 #include "stream_cache.h"
 
-#define STREAM_CACHE_MAX_SIZE 1024U
-
 struct StreamCache {
-    uint8_t data[STREAM_CACHE_MAX_SIZE];
+    uint8_t* data;
+    size_t capacity;
     size_t data_size;
     size_t position;
 };
 
 StreamCache* stream_cache_alloc(void) {
     StreamCache* cache = malloc(sizeof(StreamCache));
+    cache->data = malloc(STREAM_CACHE_DEFAULT_SIZE);
+    cache->capacity = STREAM_CACHE_DEFAULT_SIZE;
     cache->data_size = 0;
     cache->position = 0;
     return cache;
 }
+
 void stream_cache_free(StreamCache* cache) {
     furi_assert(cache);
     cache->data_size = 0;
     cache->position = 0;
+    free(cache->data);
     free(cache);
 }
 
@@ -35,17 +38,31 @@ size_t stream_cache_size(StreamCache* cache) {
     return cache->data_size;
 }
 
+size_t stream_cache_capacity(StreamCache* cache) {
+    return cache->capacity;
+}
+
 size_t stream_cache_pos(StreamCache* cache) {
     return cache->position;
 }
 
 size_t stream_cache_fill(StreamCache* cache, Stream* stream) {
-    const size_t size_read = stream_read(stream, cache->data, STREAM_CACHE_MAX_SIZE);
+    const size_t size_read = stream_read(stream, cache->data, cache->capacity);
     cache->data_size = size_read;
     cache->position = 0;
     return size_read;
 }
 
+void stream_cache_swap(StreamCache* cache, uint8_t** buffer, size_t data_size) {
+    furi_assert(buffer && *buffer);
+    furi_assert(data_size <= cache->capacity);
+    uint8_t* data = cache->data;
+    cache->data = *buffer;
+    *buffer = data;
+    cache->data_size = data_size;
+    cache->position = 0;
+}
+
 bool stream_cache_flush(StreamCache* cache, Stream* stream) {
     const size_t size_written = stream_write(stream, cache->data, cache->data_size);
     const bool success = (size_written == cache->data_size);
@@ -66,7 +83,7 @@ size_t stream_cache_read(StreamCache* cache, uint8_t* data, size_t size) {
 
 size_t stream_cache_write(StreamCache* cache, const uint8_t* data, size_t size) {
     furi_assert(cache->data_size >= cache->position);
-    const size_t size_written = MIN(size, STREAM_CACHE_MAX_SIZE - cache->position);
+    const size_t size_written = MIN(size, cache->capacity - cache->position);
     if(size_written > 0) {
         memcpy(cache->data + cache->position, data, size_written);
         cache->position += size_written;
@@ -6,10 +6,12 @@
 extern "C" {
 #endif
 
+#define STREAM_CACHE_DEFAULT_SIZE 1024U
+
 typedef struct StreamCache StreamCache;
 
 /**
- * Allocate stream cache.
+ * Allocate stream cache of the default size.
  * @return StreamCache* pointer to a StreamCache instance
  */
 StreamCache* stream_cache_alloc(void);
@@ -40,6 +42,13 @@ bool stream_cache_at_end(StreamCache* cache);
  */
 size_t stream_cache_size(StreamCache* cache);
 
+/**
+ * Get the size of the cache buffer.
+ * @param cache Pointer to a StreamCache instance
+ * @return Maximum size of cached data.
+ */
+size_t stream_cache_capacity(StreamCache* cache);
+
 /**
  * Get the internal cursor position.
  * @param cache Pointer to a StreamCache instance
@@ -55,6 +64,14 @@ size_t stream_cache_pos(StreamCache* cache);
  */
 size_t stream_cache_fill(StreamCache* cache, Stream* stream);
 
+/**
+ * Exchange the cache buffer with an external one holding data loaded elsewhere.
+ * @param cache Pointer to a StreamCache instance
+ * @param buffer Pointer to a buffer of the cache capacity, receives the previous cache buffer.
+ * @param data_size Size of valid data in the buffer.
+ */
+void stream_cache_swap(StreamCache* cache, uint8_t** buffer, size_t data_size);
+
 /**
  * Write as much cached data as possible to a stream.
  * @param cache Pointer to a StreamCache instance
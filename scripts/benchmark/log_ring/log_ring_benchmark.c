@@ -0,0 +1,187 @@
+// Host benchmark of logging cost per call.
+// Compares eager formatting under a mutex, as done by synchronous FURI_LOG,
+// with pushing raw arguments into the deferred log ring. Then checks that
+// records pushed from several threads are all formatted or counted as dropped.
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "log_ring.h"
+
+#define BENCH_RING_SIZE (1U << 16)
+#define BENCH_ITERATIONS (1000000U)
+#define BENCH_PRODUCERS (4U)
+#define BENCH_PRODUCER_RECORDS (200000U)
+
+static const char* bench_tag = "Bench";
+static const char* bench_format = "decoded %s te=%lu bits=%u data=%08lx";
+
+static uint8_t bench_buffer[BENCH_RING_SIZE];
+static FuriLogRing bench_ring;
+
+static pthread_mutex_t bench_mutex = PTHREAD_MUTEX_INITIALIZER;
+static volatile size_t bench_sink;
+
+static atomic_bool bench_producers_done;
+static uint64_t bench_consumed;
+
+static uint64_t bench_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_eager(const char* format, ...) {
+    char text[FURI_LOG_RING_RECORD_MAX];
+    pthread_mutex_lock(&bench_mutex);
+    int length = snprintf(text, sizeof(text), "%" PRIu32 " [I][%s] ", (uint32_t)0, bench_tag);
+    va_list args;
+    va_start(args, format);
+    length += vsnprintf(&text[length], sizeof(text) - length, format, args);
+    va_end(args);
+    bench_sink += length;
+    pthread_mutex_unlock(&bench_mutex);
+}
+
+static FuriLogRingPush bench_push(uint32_t tick, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    FuriLogRingPush result = furi_log_ring_vpush(&bench_ring, tick, 4, bench_tag, format, args);
+    va_end(args);
+    return result;
+}
+
+static void bench_output(const char* data, size_t size, void* context) {
+    char* text = context;
+    size_t length = strlen(text);
+    if(length + size < FURI_LOG_RING_RECORD_MAX) {
+        memcpy(&text[length], data, size);
+        text[length + size] = '\0';
+    }
+}
+
+static size_t bench_drain(bool check) {
+    size_t count = 0;
+    FuriLogRingRecord record;
+    while(furi_log_ring_peek(&bench_ring, &record)) {
+        char text[FURI_LOG_RING_RECORD_MAX] = {0};
+        furi_log_ring_format(&record, bench_output, text);
+        if(check && strncmp(text, "decoded Princeton te=", 21) != 0) {
+            fprintf(stderr, "Unexpected record: %s\n", text);
+            exit(1);
+        }
+        bench_sink += strlen(text);
+        furi_log_ring_pop(&bench_ring);
+        count++;
+    }
+    return count;
+}
+
+static void bench_single(void) {
+    uint64_t start = bench_time_ns();
+    for(uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        bench_eager(bench_format, "Princeton", (unsigned long)i, 24U, (unsigned long)i * 31);
+    }
+    const uint64_t eager = bench_time_ns() - start;
+
+    // Consumer time is excluded, ring is drained whenever push is dropped
+    uint64_t push = 0;
+    uint32_t pushed = 0;
+    while(pushed < BENCH_ITERATIONS) {
+        start = bench_time_ns();
+        while(pushed < BENCH_ITERATIONS &&
+              bench_push(
+                  pushed,
+                  bench_format,
+                  "Princeton",
+                  (unsigned long)pushed,
+                  24U,
+                  (unsigned long)pushed * 31) != FuriLogRingPushDropped) {
+            pushed++;
+        }
+        push += bench_time_ns() - start;
+        bench_drain(false);
+    }
+
+    start = bench_time_ns();
+    for(uint32_t i = 0; i < BENCH_ITERATIONS / 100; i++) {
+        bench_push(i, bench_format, "Princeton", (unsigned long)i, 24U, (unsigned long)i * 31);
+        bench_drain(false);
+    }
+    const uint64_t format = bench_time_ns() - start;
+
+    printf("Per call, %u calls:\n", BENCH_ITERATIONS);
+    printf("  eager format under mutex: %6.1f ns\n", (double)eager / BENCH_ITERATIONS);
+    printf("  deferred ring push:       %6.1f ns\n", (double)push / BENCH_ITERATIONS);
+    printf("  push and consumer format: %6.1f ns\n", (double)format / (BENCH_ITERATIONS / 100));
+}
+
+static void* bench_producer(void* context) {
+    uint32_t* dropped = context;
+    for(uint32_t i = 0; i < BENCH_PRODUCER_RECORDS; i++) {
+        if(bench_push(i, bench_format, "Princeton", (unsigned long)i, 24U, 0UL) ==
+           FuriLogRingPushDropped) {
+            (*dropped)++;
+        }
+    }
+    return NULL;
+}
+
+static void* bench_consumer(void* context) {
+    (void)context;
+    while(!atomic_load(&bench_producers_done) || !furi_log_ring_is_empty(&bench_ring)) {
+        bench_consumed += bench_drain(true);
+    }
+    return NULL;
+}
+
+static void bench_concurrent(void) {
+    pthread_t producers[BENCH_PRODUCERS];
+    uint32_t dropped[BENCH_PRODUCERS] = {0};
+    pthread_t consumer;
+
+    furi_log_ring_init(&bench_ring, bench_buffer, sizeof(bench_buffer));
+    pthread_create(&consumer, NULL, bench_consumer, NULL);
+
+    const uint64_t start = bench_time_ns();
+    for(size_t i = 0; i < BENCH_PRODUCERS; i++) {
+        pthread_create(&producers[i], NULL, bench_producer, &dropped[i]);
+    }
+    uint32_t dropped_total = 0;
+    for(size_t i = 0; i < BENCH_PRODUCERS; i++) {
+        pthread_join(producers[i], NULL);
+        dropped_total += dropped[i];
+    }
+    const uint64_t elapsed = bench_time_ns() - start;
+
+    atomic_store(&bench_producers_done, true);
+    pthread_join(consumer, NULL);
+
+    const uint64_t total = (uint64_t)BENCH_PRODUCERS * BENCH_PRODUCER_RECORDS;
+    printf(
+        "%u producers: %" PRIu64 " records, %" PRIu64 " formatted, %" PRIu32
+        " dropped (counter %" PRIu32 "), %.1f ns per call\n",
+        BENCH_PRODUCERS,
+        total,
+        bench_consumed,
+        dropped_total,
+        bench_ring.dropped,
+        (double)elapsed * BENCH_PRODUCERS / total);
+
+    if(bench_consumed + dropped_total != total || bench_ring.dropped != dropped_total) {
+        fprintf(stderr, "Records lost\n");
+        exit(1);
+    }
+}
+
+int main(void) {
+    furi_log_ring_init(&bench_ring, bench_buffer, sizeof(bench_buffer));
+    bench_single();
+    bench_concurrent();
+    return 0;
+}
@@ -1,6 +1,7 @@
 import multiprocessing
 import logging
 import os
+import struct
 from collections import Counter
 
 from flipper.utils.fff import FlipperFormatFile
@@ -22,6 +23,9 @@ def _convert_image(source_filename: str):
 class DolphinBubbleAnimation:
     FILE_TYPE = "Flipper Animation"
     FILE_VERSION = 1
+    # Packed frames, read by firmware instead of separate frame files
+    BUNDLE_FILENAME = "frames.bundle"
+    BUNDLE_MAGIC = b"FBND"
 
     def __init__(
         self,
@@ -231,6 +235,29 @@ class DolphinBubbleAnimation:
             for image in to_pack:
                 _convert_image_to_bm(image)
 
+        self._save_bundle(list(filename for _, filename in to_pack), animation_directory)
+
+    def _save_bundle(self, frame_filenames: list, animation_directory: str):
+        frames = []
+        for filename in frame_filenames:
+            with open(filename, "rb") as file:
+                frames.append(file.read())
+
+        # Header, then frame offsets from the file start, one extra for the end
+        offset = 8 + 4 * (len(frames) + 1)
+        offsets = []
+        for frame in frames:
+            offsets.append(offset)
+            offset += len(frame)
+        offsets.append(offset)
+
+        bundle_filename = os.path.join(animation_directory, self.BUNDLE_FILENAME)
+        with open(bundle_filename, "wb") as file:
+            file.write(struct.pack("<4sHH", self.BUNDLE_MAGIC, len(frames), 0))
+            file.write(struct.pack(f"<{len(offsets)}I", *offsets))
+            for frame in frames:
+                file.write(frame)
+
     def process(self):
         if ImageTools.is_processing_slow():
             pool = multiprocessing.Pool()
@@ -1,11 +1,13 @@
 import enum
 import hashlib
+import struct
 import logging
 import math
 import os
 import posixpath
 import sys
 import time
+from typing import Optional
 
 import serial
 
@@ -87,6 +89,42 @@ class BufferedRead:
             data = self.stream.read(i)
             self.buffer.extend(data)
 
+    def exactly(self, size: int):
+        while len(self.buffer) < size:
+            data = self.stream.read(size - len(self.buffer))
+            if not data:
+                raise FlipperStorageException("Read timeout")
+            self.buffer.extend(data)
+        read = self.buffer[:size]
+        self.buffer = self.buffer[size:]
+        return read
+
+
+def block_hash_weak(data: bytes):
+    """Rolling block hash, same as on Flipper"""
+    a = sum(data) & 0xFFFF
+    b = sum((len(data) - i) * byte for i, byte in enumerate(data)) & 0xFFFF
+    return (b << 16) | a
+
+
+def block_hashes_local(filename: str, block_size: int):
+    """Block hashes of local file, as in Flipper manifest"""
+    blocks = []
+    with open(filename, "rb") as f:
+        for block in iter(lambda: f.read(block_size), b""):
+            blocks.append(
+                (len(block), block_hash_weak(block), hashlib.md5(block).hexdigest())
+            )
+    return blocks
+
+
+class FlipperManifestEntry:
+    def __init__(self, is_dir: bool, size: int, timestamp: int):
+        self.is_dir = is_dir
+        self.size = size
+        self.timestamp = timestamp
+        self.blocks = []
+
 
 class FlipperStorage:
     CLI_PROMPT = ">: "
@@ -387,6 +425,123 @@ class FlipperStorage:
         self.read.until(self.CLI_PROMPT)
         self._check_no_error(response, path)
 
+    def manifest(self, path: str, block_size: int = 0):
+        """Sizes, timestamps and block hashes of files in path on Flipper, recursive"""
+        self.send_and_wait_eol(f'storage manifest "{path}" {block_size}\r')
+        response = self.read.until(self.CLI_PROMPT)
+
+        manifest = {}
+        entry = None
+        for line in response.split(self.CLI_EOL.encode("ascii")):
+            if not line:
+                continue
+            self._check_no_error(line, path)
+            kind, fields = line[:1], line[2:].decode("ascii")
+            if kind == b"D":
+                timestamp, name = fields.split(" ", 1)
+                entry = FlipperManifestEntry(True, 0, int(timestamp))
+                manifest[name] = entry
+            elif kind == b"F":
+                size, timestamp, name = fields.split(" ", 2)
+                entry = FlipperManifestEntry(False, int(size), int(timestamp))
+                manifest[name] = entry
+            elif kind == b"B":
+                _, size, weak, strong = fields.split(" ")
+                entry.blocks.append((int(size), int(weak, 16), strong))
+        return manifest
+
+    def read_blocks(self, filename: str, block_size: int, index: int, count: int):
+        """Read count blocks from file on Flipper, starting from block index"""
+        self.send_and_wait_eol(
+            f'storage read_blocks "{filename}" {block_size} {index} {count}\r'
+        )
+        answer = self.read.until(self.CLI_EOL)
+        if self.has_error(answer):
+            last_error = self.get_error(answer)
+            self.read.until(self.CLI_PROMPT)
+            raise FlipperStorageException.from_error_code(filename, last_error)
+        size = int(answer.split(b": ")[1])
+        data = self.read.exactly(size)
+        self.read.until(self.CLI_PROMPT)
+        return data
+
+    def patch_file(
+        self,
+        filename_from: str,
+        filename_to: str,
+        block_size: int,
+        blocks: Optional[list],
+    ):
+        """Send only blocks of local file which differ from given Flipper block hashes
+
+        Blocks are None if the Flipper file doesn't exist, it is created then
+        """
+        filesize = os.path.getsize(filename_from)
+        local_blocks = block_hashes_local(filename_from, block_size)
+        remote_exists = blocks is not None
+        blocks = blocks or []
+        changed = [
+            index
+            for index, block in enumerate(local_blocks)
+            if index >= len(blocks) or blocks[index] != block
+        ]
+        if remote_exists and not changed and len(local_blocks) == len(blocks):
+            return 0
+
+        self.send_and_wait_eol(
+            f'storage patch "{filename_to}" {block_size} {filesize}\r'
+        )
+        with open(filename_from, "rb") as file:
+            for index in changed + [None]:
+                answer = self.read.until(self.CLI_EOL)
+                if self.has_error(answer):
+                    last_error = self.get_error(answer)
+                    self.read.until(self.CLI_PROMPT)
+                    raise FlipperStorageException.from_error_code(
+                        filename_to, last_error
+                    )
+                if index is None:
+                    self.port.write(struct.pack("<II", 0, 0))
+                    break
+                file.seek(index * block_size)
+                data = file.read(block_size)
+                self.port.write(struct.pack("<II", index, len(data)) + data)
+
+        response = self.read.until(self.CLI_PROMPT)
+        self._check_no_error(response, filename_to)
+        return len(changed)
+
+    def receive_file_delta(
+        self, filename_from: str, filename_to: str, block_size: int, blocks: list
+    ):
+        """Receive only blocks of Flipper file which differ from local file"""
+        if not os.path.exists(filename_to):
+            self.receive_file(filename_from, filename_to)
+            return len(blocks)
+
+        local_blocks = block_hashes_local(filename_to, block_size)
+        changed = [
+            index
+            for index, block in enumerate(blocks)
+            if index >= len(local_blocks) or local_blocks[index] != block
+        ]
+
+        with open(filename_to, "r+b") as file:
+            # Fetch contiguous runs of changed blocks at once
+            run_start = 0
+            for i, index in enumerate(changed):
+                if i + 1 < len(changed) and changed[i + 1] == index + 1:
+                    continue
+                first = changed[run_start]
+                data = self.read_blocks(
+                    filename_from, block_size, first, index - first + 1
+                )
+                file.seek(first * block_size)
+                file.write(data)
+                run_start = i + 1
+            file.truncate(sum(block[0] for block in blocks))
+        return len(changed)
+
     def hash_local(self, filename: str):
         """Hash of local file"""
         hash_md5 = hashlib.md5()
@@ -410,8 +565,23 @@ class FlipperStorageOperations:
         self.logger = logging.getLogger("FStorageOps")
 
     def send_file_to_storage(
-        self, flipper_file_path: str, local_file_path: str, force: bool = False
+        self,
+        flipper_file_path: str,
+        local_file_path: str,
+        force: bool = False,
+        delta_block_size: int = 0,
     ):
+        if delta_block_size and not force:
+            blocks = None
+            if self.storage.exist_file(flipper_file_path):
+                manifest = self.storage.manifest(flipper_file_path, delta_block_size)
+                blocks = manifest[flipper_file_path].blocks
+            changed = self.storage.patch_file(
+                local_file_path, flipper_file_path, delta_block_size, blocks
+            )
+            self.logger.info(f'Patched "{flipper_file_path}": {changed} blocks sent')
+            return
+
         self.logger.debug(
             f"* send_file_to_storage:  {local_file_path}->{flipper_file_path}, {force=}"
         )
@@ -438,7 +608,13 @@ class FlipperStorageOperations:
             self.storage.mkdir("/".join(path_components))
 
     # send file or folder recursively
-    def recursive_send(self, flipper_path: str, local_path: str, force: bool = False):
+    def recursive_send(
+        self,
+        flipper_path: str,
+        local_path: str,
+        force: bool = False,
+        delta_block_size: int = 0,
+    ):
         if not os.path.exists(local_path):
             raise FlipperStorageException(f'"{local_path}" does not exist')
 
@@ -467,10 +643,43 @@ class FlipperStorageOperations:
                         os.sep, "/"
                     )
                     local_file_path = os.path.normpath(os.path.join(dirpath, filename))
-                    self.send_file_to_storage(flipper_file_path, local_file_path, force)
+                    self.send_file_to_storage(
+                        flipper_file_path, local_file_path, force, delta_block_size
+                    )
         else:
             self.mkpath(posixpath.dirname(flipper_path))
-            self.send_file_to_storage(flipper_path, local_path, force)
+            self.send_file_to_storage(flipper_path, local_path, force, delta_block_size)
+
+    # receive file or folder, transferring only blocks changed since previous receive
+    def delta_receive(self, flipper_path: str, local_path: str, block_size: int):
+        manifest = self.storage.manifest(flipper_path, block_size)
+        is_dir = len(manifest) != 1 or flipper_path not in manifest
+        sent_blocks = changed_blocks = 0
+
+        for name, entry in manifest.items():
+            local_file_path = local_path
+            if is_dir:
+                rel_path = posixpath.relpath(name, flipper_path)
+                local_file_path = os.path.normpath(os.path.join(local_path, rel_path))
+
+            if entry.is_dir:
+                os.makedirs(local_file_path, exist_ok=True)
+                continue
+
+            if is_dir:
+                os.makedirs(os.path.dirname(local_file_path), exist_ok=True)
+            changed = self.storage.receive_file_delta(
+                name, local_file_path, block_size, entry.blocks
+            )
+            self.logger.debug(
+                f'"{name}": {changed} of {len(entry.blocks)} blocks changed'
+            )
+            sent_blocks += len(entry.blocks)
+            changed_blocks += changed
+
+        self.logger.info(
+            f'Received "{flipper_path}": {changed_blocks} of {sent_blocks} blocks changed'
+        )
 
     def recursive_receive(self, flipper_path: str, local_path: str):
         if self.storage.exist_dir(flipper_path):
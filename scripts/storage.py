@@ -53,6 +53,14 @@ class Main(App):
         self.parser_size.set_defaults(func=self.size)
 
         self.parser_receive = self.subparsers.add_parser("receive", help="Receive file")
+        self.parser_receive.add_argument(
+            "-d",
+            "--delta",
+            type=int,
+            default=0,
+            metavar="BLOCK_SIZE",
+            help="Transfer only blocks changed since previous receive",
+        )
         self.parser_receive.add_argument("flipper_path", help="Flipper path")
         self.parser_receive.add_argument("local_path", help="Local path")
         self.parser_receive.set_defaults(func=self.receive)
@@ -63,6 +71,14 @@ class Main(App):
         self.parser_send.add_argument(
             "-f", "--force", help="Force sending", action="store_true"
         )
+        self.parser_send.add_argument(
+            "-d",
+            "--delta",
+            type=int,
+            default=0,
+            metavar="BLOCK_SIZE",
+            help="Transfer only blocks changed on Flipper side",
+        )
         self.parser_send.add_argument("local_path", help="Local path")
         self.parser_send.add_argument("flipper_path", help="Flipper path")
         self.parser_send.set_defaults(func=self.send)
@@ -103,15 +119,23 @@ class Main(App):
     @WrapStorageOp
     def receive(self):
         with FlipperStorage(self._get_port()) as storage:
-            FlipperStorageOperations(storage).recursive_receive(
-                self.args.flipper_path, self.args.local_path
-            )
+            if self.args.delta:
+                FlipperStorageOperations(storage).delta_receive(
+                    self.args.flipper_path, self.args.local_path, self.args.delta
+                )
+            else:
+                FlipperStorageOperations(storage).recursive_receive(
+                    self.args.flipper_path, self.args.local_path
+                )
 
     @WrapStorageOp
     def send(self):
         with FlipperStorage(self._get_port()) as storage:
             FlipperStorageOperations(storage).recursive_send(
-                self.args.flipper_path, self.args.local_path, self.args.force
+                self.args.flipper_path,
+                self.args.local_path,
+                self.args.force,
+                self.args.delta,
             )
 
     @WrapStorageOp